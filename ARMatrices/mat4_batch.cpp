@@ -0,0 +1,73 @@
+/**
+ * @file mat4_batch.cpp
+ * @brief Implémentation du produit 4x4 en lot (SSE sur x86, NEON sur ARM, sinon scalaire).
+ */
+
+#include "mat4_batch.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+  #include <xmmintrin.h>
+  #define AR_MAT4_SSE 1
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
+  #define AR_MAT4_NEON 1
+#endif
+
+void mat4MulBatch(const glm::mat4& A, const glm::mat4* B, glm::mat4* out, std::size_t n)
+{
+    const float* a = &A[0][0];
+
+#if defined(AR_MAT4_SSE)
+    // Colonnes de A chargées une fois pour tout le lot
+    const __m128 a0 = _mm_loadu_ps(a + 0);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const float* b = &B[i][0][0];
+        float* o = &out[i][0][0];
+
+        // out.col[j] = sum_k A.col[k] * B[j][k]  (on lit tout B avant d'écrire : out peut aliaser B)
+        __m128 c[4];
+        for (int j = 0; j < 4; ++j) {
+            const float* bj = b + 4 * j;
+            __m128 r =          _mm_mul_ps(a0, _mm_set1_ps(bj[0]));
+            r = _mm_add_ps(r,   _mm_mul_ps(a1, _mm_set1_ps(bj[1])));
+            r = _mm_add_ps(r,   _mm_mul_ps(a2, _mm_set1_ps(bj[2])));
+            r = _mm_add_ps(r,   _mm_mul_ps(a3, _mm_set1_ps(bj[3])));
+            c[j] = r;
+        }
+        _mm_storeu_ps(o + 0,  c[0]);
+        _mm_storeu_ps(o + 4,  c[1]);
+        _mm_storeu_ps(o + 8,  c[2]);
+        _mm_storeu_ps(o + 12, c[3]);
+    }
+#elif defined(AR_MAT4_NEON)
+    const float32x4_t a0 = vld1q_f32(a + 0);
+    const float32x4_t a1 = vld1q_f32(a + 4);
+    const float32x4_t a2 = vld1q_f32(a + 8);
+    const float32x4_t a3 = vld1q_f32(a + 12);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const float* b = &B[i][0][0];
+        float* o = &out[i][0][0];
+
+        float32x4_t c[4];
+        for (int j = 0; j < 4; ++j) {
+            const float* bj = b + 4 * j;
+            float32x4_t r = vmulq_n_f32(a0, bj[0]);
+            r = vmlaq_n_f32(r, a1, bj[1]);
+            r = vmlaq_n_f32(r, a2, bj[2]);
+            r = vmlaq_n_f32(r, a3, bj[3]);
+            c[j] = r;
+        }
+        vst1q_f32(o + 0,  c[0]);
+        vst1q_f32(o + 4,  c[1]);
+        vst1q_f32(o + 8,  c[2]);
+        vst1q_f32(o + 12, c[3]);
+    }
+#else
+    for (std::size_t i = 0; i < n; ++i) out[i] = A * B[i];
+#endif
+}
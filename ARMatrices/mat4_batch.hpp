@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <glm/glm.hpp>
+
+/**
+ * @file mat4_batch.hpp
+ * @brief Produits matriciels 4x4 en lot (SSE / NEON, repli scalaire).
+ *
+ * @details
+ * Calcule out[i] = A * B[i] pour un tableau de matrices, avec A commun à tout le lot
+ * (typiquement la MVP du labyrinthe appliquée aux matrices modèle des objets).
+ * Les colonnes de A sont chargées une seule fois dans des registres vectoriels.
+ */
+
+/**
+ * @brief Multiplie une matrice commune par un lot de matrices (column-major, convention GLM).
+ * @param A Matrice commune (à gauche).
+ * @param B Tableau de n matrices (à droite).
+ * @param out Tableau de sortie de n matrices (peut être égal à B).
+ * @param n Nombre de matrices.
+ */
+void mat4MulBatch(const glm::mat4& A, const glm::mat4* B, glm::mat4* out, std::size_t n);
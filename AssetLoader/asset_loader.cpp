@@ -0,0 +1,106 @@
+/**
+ * @file asset_loader.cpp
+ * @brief Implémentation du chargeur d'assets asynchrone.
+ */
+
+#include "asset_loader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "Metrics/metrics.hpp"
+#include "Profiler/profiler.hpp"
+
+AssetLoader::AssetLoader(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency() - 1);
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) workers.emplace_back([this] { workerLoop(); });
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        toDecode.clear();
+    }
+    workReady.notify_all();
+    for (std::thread& t : workers) t.join();
+}
+
+void AssetLoader::submit(std::function<void()> decode, std::function<void()> upload) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        toDecode.push_back({ std::move(decode), std::move(upload) });
+        ++inFlight;
+    }
+    workReady.notify_one();
+}
+
+void AssetLoader::workerLoop() {
+    ARCUBE_THREAD_NAME("assets.worker");
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workReady.wait(lock, [this] { return stopping || !toDecode.empty(); });
+            if (stopping) return;
+            job = std::move(toDecode.front());
+            toDecode.pop_front();
+        }
+
+        try {
+            ARCUBE_ZONE("assets.decode");
+            if (job.decode) job.decode();
+        } catch (const std::exception& e) {
+            std::cerr << "[Assets] decodage echoue : " << e.what() << "\n";
+        }
+
+        static const int mDecoded = metrics().counter("assets_decoded");
+        metrics().add(mDecoded);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            toUpload.push_back(std::move(job));
+        }
+        uploadReady.notify_all();
+    }
+}
+
+int AssetLoader::pump(double budgetMs) {
+    const auto t0 = std::chrono::steady_clock::now();
+    int done = 0;
+    for (;;) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (toUpload.empty()) break;
+            job = std::move(toUpload.front());
+            toUpload.pop_front();
+        }
+        if (job.upload) {
+            ARCUBE_ZONE("assets.upload");
+            job.upload();
+        }
+        ++done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --inFlight;
+        }
+        if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() >= budgetMs)
+            break;
+    }
+    return done;
+}
+
+void AssetLoader::finish() {
+    for (;;) {
+        pump(1e30);
+        std::unique_lock<std::mutex> lock(mutex);
+        if (inFlight == 0) return;
+        uploadReady.wait(lock, [this] { return !toUpload.empty(); });
+    }
+}
+
+std::size_t AssetLoader::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return inFlight;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file asset_loader.hpp
+ * @brief Chargement asynchrone des assets : décodage sur threads de travail, upload GL
+ *        sur le thread principal avec un budget de temps par frame.
+ *
+ * @details
+ * Un job se compose de deux étapes :
+ * - decode : lecture disque et décodage (OBJ, PNG / JPG), exécutée par un thread de travail,
+ *   sans aucun appel OpenGL ;
+ * - upload : création des objets GL à partir du résultat, exécutée par pump() sur le thread
+ *   qui possède le contexte.
+ *
+ * pump(budgetMs) est appelé une fois par frame : il enchaîne les uploads prêts tant que le
+ * budget n'est pas dépassé (au moins un par appel, pour garantir la progression). Le thread
+ * de rendu ne bloque donc jamais sur une lecture disque, et la première frame s'affiche
+ * quelle que soit la taille des assets. Les uploads restent sur le contexte principal :
+ * pas de second contexte partagé à synchroniser (fences), ni d'état GL à invalider.
+ *
+ * Les jobs décodés mais pas encore uploadés à la destruction sont abandonnés ; les objets
+ * référencés par les uploads (scène...) doivent donc survivre au dernier pump().
+ */
+class AssetLoader {
+public:
+    /**
+     * @brief Démarre les threads de travail.
+     * @param threads Nombre de threads (0 : hardware_concurrency() - 1, au moins 1).
+     */
+    explicit AssetLoader(unsigned threads = 0);
+
+    /// @brief Attend la fin des décodages en cours puis arrête les threads.
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /**
+     * @brief Ajoute un job.
+     * @param decode Étape CPU (thread de travail, aucun appel GL).
+     * @param upload Étape GL (thread principal, dans pump()) ; peut être vide.
+     */
+    void submit(std::function<void()> decode, std::function<void()> upload);
+
+    /**
+     * @brief Exécute les uploads prêts, dans l'ordre de fin de décodage.
+     * @param budgetMs Budget de temps (ms) ; le job en cours n'est pas interrompu.
+     * @return Nombre d'uploads exécutés.
+     */
+    int pump(double budgetMs);
+
+    /**
+     * @brief Bloque jusqu'à ce que tous les jobs soumis soient décodés et uploadés.
+     * @details Pour les benchs et le mode sans affichage : équivalent d'un chargement synchrone.
+     */
+    void finish();
+
+    /// @brief Jobs soumis dont l'upload n'a pas encore été exécuté.
+    std::size_t pending() const;
+
+    /// @brief Vrai si aucun job n'est en attente.
+    bool idle() const { return pending() == 0; }
+
+private:
+    struct Job { std::function<void()> decode, upload; };
+
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;
+    std::condition_variable workReady;   ///< Un job à décoder, ou arrêt.
+    std::condition_variable uploadReady; ///< Un job décodé (pour finish()).
+    std::deque<Job> toDecode;            ///< Jobs soumis, pas encore pris par un thread.
+    std::deque<Job> toUpload;            ///< Jobs décodés, en attente de pump().
+    std::size_t inFlight = 0;            ///< Jobs soumis dont l'upload n'est pas fait.
+    bool stopping = false;
+};
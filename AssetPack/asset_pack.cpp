@@ -0,0 +1,240 @@
+/**
+ * @file asset_pack.cpp
+ * @brief Implémentation de l'archive d'assets et du VFS.
+ */
+
+#include "asset_pack.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+uint64_t nameHash(const char* p, std::size_t n) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= (uint8_t)p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+uint64_t alignUp(uint64_t v) { return (v + ASSET_PACK_ALIGN - 1) & ~(ASSET_PACK_ALIGN - 1); }
+
+/// @brief Ordre de l'index : empreinte puis nom (les collisions restent triées).
+int compareKey(uint64_t ha, const char* a, std::size_t na, uint64_t hb, const char* b, std::size_t nb) {
+    if (ha != hb) return ha < hb ? -1 : 1;
+    const int c = std::memcmp(a, b, std::min(na, nb));
+    if (c != 0) return c;
+    return na == nb ? 0 : (na < nb ? -1 : 1);
+}
+
+} // namespace
+
+std::string normalizeAssetPath(const std::string& path) {
+    std::string p = fs::path(path).lexically_normal().generic_string();
+    while (p.compare(0, 2, "./") == 0) p.erase(0, 2);
+    return p;
+}
+
+bool writeAssetPack(const std::string& packPath, const std::vector<AssetPackInput>& inputs) {
+    struct Item {
+        std::string name;
+        const AssetPackInput* in;
+        uint64_t hash;
+        AssetPackEntry e;
+    };
+    std::vector<Item> items;
+    items.reserve(inputs.size());
+    for (const AssetPackInput& in : inputs) {
+        const std::string name = normalizeAssetPath(in.name);
+        items.push_back(Item{ name, &in, nameHash(name.data(), name.size()), AssetPackEntry{} });
+    }
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return compareKey(a.hash, a.name.data(), a.name.size(), b.hash, b.name.data(), b.name.size()) < 0;
+    });
+    for (std::size_t i = 1; i < items.size(); ++i)
+        if (items[i].name == items[i - 1].name) {
+            std::cerr << "[PACK] entree en double : " << items[i].name << "\n";
+            return false;
+        }
+
+    // Disposition : en-tête, index, noms, puis contenus alignés sur une page
+    std::string strings;
+    std::error_code ec;
+    AssetPackHeader h{};
+    h.magic = ASSET_PACK_MAGIC;
+    h.version = ASSET_PACK_VERSION;
+    h.entryCount = (uint32_t)items.size();
+    h.indexOffset = sizeof(AssetPackHeader);
+    h.stringsOffset = h.indexOffset + items.size() * sizeof(AssetPackEntry);
+    for (Item& it : items) {
+        it.e.nameHash = it.hash;
+        it.e.nameOffset = (uint32_t)strings.size();
+        it.e.nameSize = (uint32_t)it.name.size();
+        strings += it.name;
+    }
+    h.stringsSize = strings.size();
+    uint64_t end = h.stringsOffset + h.stringsSize;
+    for (Item& it : items) {
+        const uint64_t sz = fs::file_size(it.in->path, ec);
+        if (ec) {
+            std::cerr << "[PACK] impossible de lire " << it.in->path << "\n";
+            return false;
+        }
+        it.e.offset = alignUp(end);
+        it.e.size = sz;
+        end = it.e.offset + sz;
+    }
+    h.fileSize = end;
+
+    const std::string tmp = packPath + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+
+    static const char zeros[ASSET_PACK_ALIGN] = {};
+    uint64_t written = 0;
+    auto put = [&](const void* data, uint64_t n) {
+        if (n == 0) return true;
+        written += n;
+        return std::fwrite(data, 1, (std::size_t)n, f) == n;
+    };
+    auto padTo = [&](uint64_t offset) { return put(zeros, offset - written); };
+
+    bool ok = put(&h, sizeof(h));
+    for (const Item& it : items) ok = ok && put(&it.e, sizeof(it.e));
+    ok = ok && put(strings.data(), strings.size());
+    for (const Item& it : items) {
+        MappedFile src;
+        ok = ok && src.open(it.in->path) && src.size() == it.e.size
+                && padTo(it.e.offset) && put(src.data(), src.size());
+        if (!ok) {
+            std::cerr << "[PACK] impossible de copier " << it.in->path << "\n";
+            break;
+        }
+    }
+    ok = (std::fclose(f) == 0) && ok;
+
+    if (ok) fs::rename(tmp, packPath, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool AssetPack::open(const std::string& packPath) {
+    close();
+    if (!file.open(packPath, false) || file.size() < sizeof(AssetPackHeader)) {
+        file.close();
+        return false;
+    }
+
+    const AssetPackHeader* h = (const AssetPackHeader*)file.data();
+    bool ok = h->magic == ASSET_PACK_MAGIC && h->version == ASSET_PACK_VERSION
+           && h->fileSize == file.size()
+           && h->indexOffset >= sizeof(AssetPackHeader)
+           && h->indexOffset + (uint64_t)h->entryCount * sizeof(AssetPackEntry) <= h->stringsOffset
+           && h->stringsOffset + h->stringsSize <= file.size();
+    const AssetPackEntry* e = ok ? (const AssetPackEntry*)(file.data() + h->indexOffset) : nullptr;
+    for (uint32_t i = 0; ok && i < h->entryCount; ++i)
+        ok = (uint64_t)e[i].nameOffset + e[i].nameSize <= h->stringsSize
+          && e[i].offset % ASSET_PACK_ALIGN == 0 && e[i].offset + e[i].size <= file.size();
+
+    if (!ok) {
+        file.close();
+        return false;
+    }
+    hdr = h;
+    return true;
+}
+
+bool AssetPack::find(const std::string& name, AssetSpan& out) const {
+    if (!hdr) return false;
+    const uint64_t hash = nameHash(name.data(), name.size());
+    const char* names = file.data() + hdr->stringsOffset;
+    const AssetPackEntry* e = entries();
+
+    std::size_t lo = 0, hi = hdr->entryCount;
+    while (lo < hi) {
+        const std::size_t mid = (lo + hi) / 2;
+        const int c = compareKey(e[mid].nameHash, names + e[mid].nameOffset, e[mid].nameSize,
+                                 hash, name.data(), name.size());
+        if (c == 0) {
+            out.data = file.data() + e[mid].offset;
+            out.size = (std::size_t)e[mid].size;
+            return true;
+        }
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return false;
+}
+
+std::string AssetPack::entryName(std::size_t i) const {
+    const AssetPackEntry& e = entries()[i];
+    return std::string(file.data() + hdr->stringsOffset + e.nameOffset, e.nameSize);
+}
+
+AssetSpan AssetPack::entryData(std::size_t i) const {
+    const AssetPackEntry& e = entries()[i];
+    return AssetSpan{ file.data() + e.offset, (std::size_t)e.size };
+}
+
+AssetVFS& assetFS() {
+    static AssetVFS vfs;
+    return vfs;
+}
+
+bool AssetVFS::mount(const std::string& path) {
+    unmount();
+    if (!pack.open(path)) {
+        std::cerr << "[PACK] archive illisible : " << path << "\n";
+        return false;
+    }
+    packPath = path;
+    std::cerr << "[PACK] " << path << " : " << pack.entryCount() << " entree(s), "
+              << pack.fileSize() / 1024 << " Ko\n";
+    return true;
+}
+
+bool AssetVFS::find(const std::string& path, AssetSpan& out) const {
+    return pack.isOpen() && pack.find(normalizeAssetPath(path), out);
+}
+
+bool AssetVFS::open(const std::string& path, AssetFile& out) const {
+    out.file.close();
+    out.inPack = find(path, out.span);
+    if (out.inPack) return true;
+    if (!out.file.open(path)) {
+        out.span = AssetSpan{};
+        return false;
+    }
+    out.span = AssetSpan{ out.file.data(), out.file.size() };
+    return true;
+}
+
+std::string findAssetPack(const std::string& fileName) {
+    std::error_code ec;
+    if (const char* env = std::getenv("ARCUBE_ASSET_PACK"))
+        if (fs::is_regular_file(env, ec)) return env;
+    if (fs::is_regular_file(fileName, ec)) return fileName;
+#ifndef _WIN32
+    char exe[4096];
+    const ssize_t n = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (n > 0) {
+        const fs::path p = fs::path(std::string(exe, (std::size_t)n)).parent_path() / fileName;
+        if (fs::is_regular_file(p, ec)) return p.string();
+    }
+#endif
+    return std::string();
+}
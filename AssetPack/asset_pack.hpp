@@ -0,0 +1,180 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "FileIO/mapped_file.hpp"
+
+/**
+ * @file asset_pack.hpp
+ * @brief Archive unique des assets prétraités ("assets.pack") et système de fichiers
+ *        virtuel qui la projette une seule fois en mémoire.
+ *
+ * @details
+ * Format (little-endian, version ASSET_PACK_VERSION) :
+ * @code
+ * [0             .. 64)  AssetPackHeader
+ * [indexOffset   ..)     AssetPackEntry x entryCount, triées par (empreinte, nom)
+ * [stringsOffset ..)     noms des entrées, bout à bout (sans '\0')
+ * [entry.offset  ..)     contenu de chaque entrée, aligné sur ASSET_PACK_ALIGN
+ * @endcode
+ * Les noms sont des chemins logiques normalisés (normalizeAssetPath() : "camera.yaml",
+ * "assets/background.jpg.bc1.texcache") et ne dépendent pas du répertoire courant.
+ * Chaque entrée commence sur une page : les vues des caches (maillages, textures) y
+ * pointent directement, avec l'alignement qu'elles auraient dans leur propre fichier.
+ *
+ * L'archive est produite par la cible build_assetpack (caches de maillages et de textures
+ * déjà construits, .mtl, calibration). Au démarrage, assetFS().mount() fait un open et un
+ * mmap ; les chargeurs demandent ensuite leurs fichiers à assetFS() et reçoivent un
+ * AssetSpan dans la projection : ni open, ni lecture, ni copie par fichier. Un chemin
+ * absent de l'archive (ou sans archive montée) est lu sur disque comme avant.
+ *
+ * Le pack fait foi : les caches qu'il contient ne sont pas comparés à leurs sources
+ * (qui peuvent être absentes). Après modification d'un asset, reconstruire le pack.
+ */
+
+constexpr uint32_t ASSET_PACK_MAGIC = 0x4B505241u; ///< "ARPK"
+constexpr uint32_t ASSET_PACK_VERSION = 1;
+constexpr uint64_t ASSET_PACK_ALIGN = 4096;        ///< Une page.
+
+/**
+ * @struct AssetPackHeader
+ * @brief En-tête de l'archive (64 octets).
+ */
+struct AssetPackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved0;
+    uint64_t indexOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t fileSize;    ///< Taille attendue du fichier (détecte une archive tronquée).
+    uint32_t reserved[4];
+};
+static_assert(sizeof(AssetPackHeader) == 64, "AssetPackHeader doit faire 64 octets");
+
+/**
+ * @struct AssetPackEntry
+ * @brief Une entrée de l'index (32 octets).
+ */
+struct AssetPackEntry {
+    uint64_t nameHash;   ///< FNV-1a 64 du nom.
+    uint64_t offset;     ///< Octets depuis le début de l'archive.
+    uint64_t size;
+    uint32_t nameOffset; ///< Dans la table des noms.
+    uint32_t nameSize;
+};
+static_assert(sizeof(AssetPackEntry) == 32, "AssetPackEntry doit faire 32 octets");
+
+/**
+ * @struct AssetSpan
+ * @brief Vue sur des octets d'un asset (non possédés).
+ */
+struct AssetSpan {
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+/**
+ * @brief Chemin logique d'un asset : séparateurs '/', sans "./" ni "..", tel que stocké
+ *        dans l'archive ("./assets/x.obj" -> "assets/x.obj").
+ */
+std::string normalizeAssetPath(const std::string& path);
+
+/**
+ * @struct AssetPackInput
+ * @brief Fichier à placer dans l'archive.
+ */
+struct AssetPackInput {
+    std::string name; ///< Chemin logique (normalisé à l'écriture).
+    std::string path; ///< Fichier sur disque.
+};
+
+/**
+ * @brief Écrit une archive (fichier temporaire puis renommage).
+ * @return false si une entrée est illisible, en double, ou si l'écriture échoue.
+ */
+bool writeAssetPack(const std::string& packPath, const std::vector<AssetPackInput>& inputs);
+
+/**
+ * @class AssetPack
+ * @brief Archive ouverte : index et contenu dans une seule projection mémoire.
+ */
+class AssetPack {
+public:
+    /// @brief Projette et valide l'archive (false si absente, corrompue ou tronquée).
+    bool open(const std::string& packPath);
+    void close() { file.close(); hdr = nullptr; }
+
+    bool isOpen() const { return hdr != nullptr; }
+    std::size_t entryCount() const { return hdr ? hdr->entryCount : 0; }
+    std::size_t fileSize() const { return file.size(); }
+
+    /// @brief Recherche dichotomique d'un chemin (normalisé par l'appelant).
+    bool find(const std::string& name, AssetSpan& out) const;
+
+    /// @brief Nom et contenu de l'entrée i (ordre de l'index).
+    std::string entryName(std::size_t i) const;
+    AssetSpan entryData(std::size_t i) const;
+
+private:
+    const AssetPackEntry* entries() const { return (const AssetPackEntry*)(file.data() + hdr->indexOffset); }
+
+    MappedFile file;
+    const AssetPackHeader* hdr = nullptr;
+};
+
+/**
+ * @class AssetFile
+ * @brief Asset ouvert par AssetVFS::open() : span dans l'archive, ou fichier séparé projeté.
+ */
+class AssetFile {
+public:
+    const char* data() const { return span.data; }
+    std::size_t size() const { return span.size; }
+    bool fromPack() const { return inPack; }
+
+private:
+    friend class AssetVFS;
+    MappedFile file;
+    AssetSpan span;
+    bool inPack = false;
+};
+
+/**
+ * @class AssetVFS
+ * @brief Système de fichiers des assets : archive montée, repli sur les fichiers séparés.
+ * @details Monter avant de lancer les threads de chargement : les lectures (find / open)
+ *          sont ensuite sans verrou.
+ */
+class AssetVFS {
+public:
+    /// @brief Monte une archive (remplace la précédente). false si elle est illisible.
+    bool mount(const std::string& packPath);
+    void unmount() { pack.close(); packPath.clear(); }
+
+    bool mounted() const { return pack.isOpen(); }
+    const std::string& mountedPath() const { return packPath; }
+    const AssetPack& archive() const { return pack; }
+
+    /// @brief Span d'un asset de l'archive (false s'il n'y est pas, ou sans archive).
+    bool find(const std::string& path, AssetSpan& out) const;
+
+    /// @brief Ouvre un asset : depuis l'archive, sinon le fichier sur disque (projeté).
+    bool open(const std::string& path, AssetFile& out) const;
+
+private:
+    AssetPack pack;
+    std::string packPath;
+};
+
+/// @brief VFS global de l'application.
+AssetVFS& assetFS();
+
+/**
+ * @brief Cherche une archive : variable ARCUBE_ASSET_PACK, répertoire courant, puis
+ *        répertoire de l'exécutable (le lancement ne dépend plus du répertoire courant).
+ * @return Chemin trouvé, ou chaîne vide.
+ */
+std::string findAssetPack(const std::string& fileName = "assets.pack");
@@ -11,6 +11,7 @@
 
 // On inclut geometries pour connaitre "Mesh"
 #include "Geometries/geometries.hpp" 
+#include "ResourceCache/resource_cache.hpp"
 
 // --- CLASSE MAZE ---
 class Maze {
@@ -95,8 +96,9 @@ class Ball {
         float gain = 1.0f;       // multiplicateur global (0.5..2)
         float deadzone = 0.03f;  // petite zone morte (0.01..0.08)
     
-        Ball(float r) : radius(r), pos(0,0), vel(0,0) {
-            mesh = createSphere(radius, 16, 16);
+        // withMesh = false : physique seule, sans contexte GL (benchmarks)
+        Ball(float r, bool withMesh = true) : radius(r), pos(0,0), vel(0,0) {
+            if (withMesh) mesh = resources().acquireSphere(radius, 16, 16); // partagée entre balles de même rayon
             R0 = cv::Mat::eye(3,3,CV_64F);
         }
     
@@ -216,7 +218,7 @@ class Ball {
             glUniformMatrix4fv(uMVP, 1, GL_FALSE, glm::value_ptr(MVP));
     
             glBindVertexArray(mesh.vao);
-            glDrawElements(GL_TRIANGLES, mesh.count, GL_UNSIGNED_INT, 0);
+            glDrawElements(GL_TRIANGLES, mesh.count, mesh.indexType, 0);
             glBindVertexArray(0);
         }
     };
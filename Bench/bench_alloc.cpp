@@ -0,0 +1,161 @@
+// Bench/bench_alloc.cpp
+// Allocations du tas par frame dans le pipeline d'arcube, rejoué sur une session :
+// cvtColor -> detectMarkers -> interpolateCornersCharuco -> estimatePoseCharucoBoard ->
+// PoseSmoother::smooth -> modelFromRvecTvec_OpenCVtoGL -> Ball::update.
+// Compte operator new (Profiler/alloc_hooks.cpp, lié à cette cible) et les tampons cv::Mat
+// (installCvAllocTracker), par étape, sur le thread du pipeline.
+//
+// Contrôle de régression : après --warmup frames, la moyenne d'allocations par frame du
+// pipeline (source exclue) doit rester sous --budget (et sous --budget-bytes si donné) ;
+// sinon le programme se termine avec le code 1. Sans --budget : rapport seulement.
+// Contexte GL invisible requis (Ball partage son mesh via resources()).
+//
+// Usage : ./bench_alloc [--video session.mp4 --calib camera.yaml] [--frames 300] [--warmup 30]
+//                       [--budget N] [--budget-bytes N]
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "Bench/bench_common.hpp"
+#include "Bench/bench_session.hpp"
+#include "Profiler/perf_counters.hpp"
+#include "ARMatrices/ar_matrices.hpp"
+#include "Smoothing/smoothing.hpp"
+#include "Ball.hpp"
+
+int main(int argc, char** argv)
+{
+    const std::string video = argStr(argc, argv, "--video", "");
+    const std::string calib = argStr(argc, argv, "--calib", "camera.yaml");
+    const int frames      = argInt(argc, argv, "--frames", 300);
+    const int warmup      = argInt(argc, argv, "--warmup", 30);
+    const int budget      = argInt(argc, argv, "--budget", -1);
+    const int budgetBytes = argInt(argc, argv, "--budget-bytes", -1);
+
+    if (!allocTrackingActive()) {
+        std::fprintf(stderr, "alloc_hooks.cpp n'est pas lie a bench_alloc\n");
+        return 2;
+    }
+    GLFWwindow* win = createHiddenContext();
+    if (!win) return 2;
+    installCvAllocTracker();
+
+    BenchBoard b;
+    BenchSession session;
+    const bool opened = video.empty() ? session.openSynthetic(b, frames + warmup) : session.openVideo(video, calib);
+    if (!opened) return 2;
+    std::printf("session : %s\n", video.empty() ? "synthetique (trajectoire scriptee, 1280x720)" : video.c_str());
+
+    PerfStages stages;
+    stages.trackAllocations(true);
+    const int sRead    = stages.add("source (hors budget)");
+    const int sGray    = stages.add("cvtColor");
+    const int sDetect  = stages.add("detectMarkers");
+    const int sCorners = stages.add("interpolateCornersCharuco");
+    const int sPose    = stages.add("estimatePoseCharucoBoard");
+    const int sSmooth  = stages.add("PoseSmoother::smooth");
+    const int sModel   = stages.add("modelFromRvecTvec_OpenCVtoGL");
+    const int sBall    = stages.add("Ball::update");
+
+    // Mêmes objets que la boucle d'arcube
+    Maze maze(8, 6, 0.297f, 0.210f, 0.0035f);
+    maze.generate();
+    Ball ball(0.010f);
+    ball.reset(maze);
+    PoseSmoother poseSmooth;
+    poseSmooth.alphaPose = 0.25;
+
+    cv::Mat frame, gray, rvec, tvec;
+    std::vector<int> markerIds;
+    std::vector<std::vector<cv::Point2f>> markerCorners;
+    cv::Mat charucoCorners, charucoIds;
+    AllocCounts pipeline;
+    int measured = 0, detected = 0;
+
+    for (int i = 0; i < frames + warmup; ++i) {
+        if (i == warmup) {
+            stages.reset();
+            pipeline = AllocCounts();
+        }
+        bool got;
+        {
+            PerfScope s(stages, sRead);
+            got = session.next(frame);
+        }
+        if (!got) break;
+
+        const AllocCounts f0 = allocCounts();
+        bool poseOk = false;
+        {
+            PerfScope s(stages, sGray);
+            cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        }
+        {
+            PerfScope s(stages, sDetect);
+            cv::aruco::detectMarkers(gray, b.dict, markerCorners, markerIds, b.params);
+        }
+        if (!markerIds.empty()) {
+            {
+                PerfScope s(stages, sCorners);
+                cv::aruco::interpolateCornersCharuco(markerCorners, markerIds, gray, b.board,
+                                                     charucoCorners, charucoIds, session.K, session.D);
+            }
+            if (charucoIds.total() >= 6) {
+                PerfScope s(stages, sPose);
+                poseOk = cv::aruco::estimatePoseCharucoBoard(charucoCorners, charucoIds, b.board,
+                                                             session.K, session.D, rvec, tvec);
+            }
+        }
+        if (poseOk) {
+            if (rvec.type() != CV_64F) rvec.convertTo(rvec, CV_64F);
+            if (tvec.type() != CV_64F) tvec.convertTo(tvec, CV_64F);
+            PerfScope s(stages, sSmooth);
+            poseSmooth.smooth(rvec, tvec);
+        }
+        if (!rvec.empty()) {
+            {
+                PerfScope s(stages, sModel);
+                volatile float sink = modelFromRvecTvec_OpenCVtoGL(rvec, tvec)[3][2];
+                (void)sink;
+            }
+            PerfScope s(stages, sBall);
+            ball.update(1.0f / 30.0f, rvec, maze);
+        }
+        if (i >= warmup) {
+            pipeline += allocCounts() - f0;
+            ++measured;
+            detected += poseOk ? 1 : 0;
+        }
+        stages.endFrame();
+    }
+
+    if (measured == 0) {
+        std::fprintf(stderr, "session trop courte (%d frames de chauffe)\n", warmup);
+        return 2;
+    }
+    stages.report(std::cout, "alloc");
+
+    const double perFrame = (double)(pipeline.allocs + pipeline.cvAllocs) / measured;
+    const double bytesPerFrame = (double)(pipeline.bytes + pipeline.cvBytes) / measured;
+    std::printf("\npipeline : %.1f allocations / frame (%.1f new + %.1f cv::Mat), %.0f octets / frame, "
+                "pose sur %d / %d frames\n", perFrame, (double)pipeline.allocs / measured,
+                (double)pipeline.cvAllocs / measured, bytesPerFrame, detected, measured);
+
+    int status = 0;
+    if (budget >= 0) {
+        const bool ok = perFrame <= budget;
+        std::printf("budget allocations : %.1f / %d -> %s\n", perFrame, budget, ok ? "OK" : "DEPASSE");
+        if (!ok) status = 1;
+    }
+    if (budgetBytes >= 0) {
+        const bool ok = bytesPerFrame <= budgetBytes;
+        std::printf("budget octets : %.0f / %d -> %s\n", bytesPerFrame, budgetBytes, ok ? "OK" : "DEPASSE");
+        if (!ok) status = 1;
+    }
+
+    resources().release(ball.mesh);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return status;
+}
@@ -0,0 +1,161 @@
+// Bench/bench_arena.cpp
+// Comparaison de soumission : un VAO par maillage (SceneObjects::drawAll) vs arène de géométrie
+// (SceneObjects::drawArena) en multi-draw indirect puis en repli GL 3.3 (glDrawElementsBaseVertex).
+//
+// Usage : ./bench_arena [--items 10000] [--frames 200]
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdio>
+#include <random>
+
+#include "Bench/bench_common.hpp"
+#include "Shaders/shaders.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "GLUtils/gl_state.hpp"
+#include "GLUtils/uniform_buffers.hpp"
+#include "Geometries/geometries.hpp"
+#include "GeometryArena/geometry_arena.hpp"
+#include "SceneObjects.hpp"
+
+static glm::mat4 projection()
+{
+    return glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.01f, 100.0f);
+}
+
+static glm::mat4 viewAt(int frame)
+{
+    return glm::translate(glm::mat4(1.0f), glm::vec3(0.001f * (frame % 50), 0.0f, -1.5f));
+}
+
+static glm::mat4 cameraAt(int frame)
+{
+    return projection() * viewAt(frame);
+}
+
+// Même scène aléatoire pour chaque variante (graine fixe)
+static void fillScene(SceneObjects& scene, const MeshData* shapes, int nShapes, int nItems)
+{
+    const glm::vec4 colors[4] = {
+        {0.8f,0.8f,0.8f,1.0f}, {0.9f,0.2f,0.2f,1.0f}, {0.2f,0.9f,0.2f,1.0f}, {0.2f,0.2f,0.9f,1.0f}
+    };
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> upos(-1.0f, 1.0f), urot(0.0f, 360.0f);
+    std::uniform_int_distribution<int> ushape(0, nShapes - 1), ucol(0, 3);
+
+    for (int i = 0; i < nItems; ++i) {
+        scene.addMeshData(shapes[ushape(rng)],
+                          glm::vec3(upos(rng), upos(rng), upos(rng) * 0.2f),
+                          glm::vec3(urot(rng), urot(rng), urot(rng)),
+                          glm::vec3(0.01f),
+                          colors[ucol(rng)]);
+    }
+}
+
+struct Result { double submitMs, frameMs; int drawCalls, drawn; };
+
+template <class DrawFn>
+static Result run(int nFrames, DrawFn draw, const SceneObjects& scene)
+{
+    draw(0); // warm-up (uploads initiaux)
+    glFinish();
+
+    Result r{0.0, 0.0, 0, 0};
+    BenchClock clk;
+    for (int f = 0; f < nFrames; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BenchClock s;
+        draw(f);
+        r.submitMs += s.ms();
+        glFinish();
+    }
+    r.frameMs = clk.ms() / nFrames;
+    r.submitMs /= nFrames;
+    r.drawCalls = scene.lastStats().drawCalls;
+    r.drawn = scene.lastStats().drawn;
+    return r;
+}
+
+int main(int argc, char** argv)
+{
+    const int nItems  = argInt(argc, argv, "--items", 10000);
+    const int nFrames = argInt(argc, argv, "--frames", 200);
+
+    GLFWwindow* win = createHiddenContext();
+    if (!win) return 1;
+
+    GLuint progFace = linkProgram({ compileShader(GL_VERTEX_SHADER, FACE_VS),
+                                    compileShader(GL_FRAGMENT_SHADER, FACE_FS) });
+    GLint uMVP   = glGetUniformLocation(progFace, "uMVP");
+    GLint uColor = glGetUniformLocation(progFace, "uFaceColor");
+
+    GLuint progArena = linkProgram({ compileShader(GL_VERTEX_SHADER, ARENA_VS),
+                                     compileShader(GL_FRAGMENT_SHADER, ARENA_FS) });
+    glUseProgram(progArena);
+    glUniform1i(glGetUniformLocation(progArena, "uDrawData"), GeometryArena::DRAW_DATA_UNIT);
+
+    // Caméra par frame + un bloc objet identité (les matrices par objet sont dans l'arène)
+    UniformBuffers ubo;
+    ubo.create(1);
+    UniformBuffers::bindBlocks(progArena);
+    ubo.beginObjects();
+    ubo.bindObject(ubo.pushObject(glm::mat4(1.0f), glm::vec4(1.0f)));
+    ubo.uploadObjects();
+    auto drawArena = [&](SceneObjects& s, int f) {
+        glState().beginFrame();
+        ubo.setCamera(projection(), viewAt(f), 640.0f, 480.0f);
+        ubo.bindObject(0);
+        s.drawArena(progArena, cameraAt(f));
+    };
+
+    // Formes de tailles différentes (chaque objet a sa propre copie, comme des OBJ distincts)
+    const MeshData shapes[3] = { buildSphere(0.5f, 16, 16), buildSphere(0.5f, 8, 8), buildSphere(0.5f, 4, 6) };
+
+    glViewport(0, 0, 640, 480);
+    glEnable(GL_DEPTH_TEST);
+
+    SceneObjects perVao;
+    fillScene(perVao, shapes, 3, nItems);
+    Result rVao = run(nFrames, [&](int f) { perVao.drawAll(progFace, uMVP, uColor, cameraAt(f)); }, perVao);
+    perVao.destroy();
+
+    GeometryArena arena;
+    arena.create(1 << 16, 1 << 17, (uint32_t)nItems);
+    SceneObjects batched;
+    batched.useArena(&arena);
+    fillScene(batched, shapes, 3, nItems);
+
+    const bool hasMdi = arena.usesMultiDrawIndirect();
+    Result rMdi{0.0, 0.0, 0, 0};
+    if (hasMdi)
+        rMdi = run(nFrames, [&](int f) { drawArena(batched, f); }, batched);
+
+    arena.setMultiDrawIndirect(false);
+    Result rBase = run(nFrames, [&](int f) { drawArena(batched, f); }, batched);
+
+    std::printf("bench_arena : %d objets, %d frames (GL: %s)\n",
+                nItems, nFrames, (const char*)glGetString(GL_RENDERER));
+    std::printf("  %-34s %10s %10s %10s %10s\n", "", "submit ms", "frame ms", "appels", "dessines");
+    std::printf("  %-34s %10.3f %10.3f %10d %10d\n", "VAO par maillage (drawAll)",
+                rVao.submitMs, rVao.frameMs, rVao.drawCalls, rVao.drawn);
+    if (hasMdi)
+        std::printf("  %-34s %10.3f %10.3f %10d %10d\n", "arene + glMultiDrawElementsIndirect",
+                    rMdi.submitMs, rMdi.frameMs, rMdi.drawCalls, rMdi.drawn);
+    else
+        std::printf("  %-34s %10s\n", "arene + glMultiDrawElementsIndirect", "non supporte");
+    std::printf("  %-34s %10.3f %10.3f %10d %10d\n", "arene + glDrawElementsBaseVertex",
+                rBase.submitMs, rBase.frameMs, rBase.drawCalls, rBase.drawn);
+
+    batched.destroy();
+    arena.destroy();
+    ubo.destroy();
+    glDeleteProgram(progFace);
+    glDeleteProgram(progArena);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
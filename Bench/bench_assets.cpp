@@ -0,0 +1,112 @@
+// Bench/bench_assets.cpp
+// Chargement des assets au démarrage : synchrone (addOBJ + loadTextureFromFile avant la
+// boucle) vs asynchrone (AssetLoader : décodage sur threads, upload borné par frame).
+// Mesure le délai jusqu'à la première frame, jusqu'aux assets résidents, et la pire frame
+// pendant le chargement. Le cache "<obj>.meshcache" est supprimé avant chaque passe (démarrage
+// à froid) sauf --warm 1.
+//
+// Usage : ./bench_assets [--obj fichier.obj] [--tex image.jpg] [--budget 4] [--warm 0]
+//   Sans --obj : grille dense (~500 000 triangles) écrite dans bench_assets_synth.obj
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "Bench/bench_common.hpp"
+#include "AssetLoader/asset_loader.hpp"
+#include "MeshCache/mesh_cache.hpp"
+#include "Texture/texture.hpp"
+#include "SceneObjects.hpp"
+
+// Plan ondulé N x N avec uv
+static bool writeSynthetic(const std::string& path, int n)
+{
+    return writeSyntheticGridOBJ(path, n, n, OBJ_UV, [n](float u, float v, float* p, float*) {
+        p[0] = u;
+        p[1] = v;
+        p[2] = 0.02f * std::sin(0.2f * u * n) * std::cos(0.3f * v * n);
+    });
+}
+
+struct StartupResult { double firstFrameMs = 0, residentMs = 0, worstFrameMs = 0; int frames = 0; };
+
+// Boucle de rendu minimale : clear + scène, jusqu'à ce que tout soit résident
+static StartupResult run(GLFWwindow* win, const std::string& obj, const std::string& tex, bool async,
+                         double budgetMs, bool warm)
+{
+    if (!warm) {
+        std::error_code ec;
+        std::filesystem::remove(meshCachePath(obj), ec);
+    }
+
+    StartupResult r;
+    BenchClock total;
+    SceneObjects scene;
+    GLuint texture = 0;
+    {
+        AssetLoader loader;
+        if (async) {
+            auto img = std::make_shared<cv::Mat>();
+            loader.submit([img, tex] { decodeTextureFile(tex, true, *img); },
+                          [img, &texture] { texture = uploadTextureRGB(*img); });
+            scene.addOBJAsync(loader, obj, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+        } else {
+            texture = loadTextureFromFile(tex, true);
+            scene.addOBJ(obj, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+        }
+
+        for (;;) {
+            BenchClock frame;
+            loader.pump(budgetMs);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glfwSwapBuffers(win);
+            glFinish();
+            const double ms = frame.ms();
+            if (r.frames++ == 0) r.firstFrameMs = total.ms();
+            r.worstFrameMs = std::max(r.worstFrameMs, ms);
+            if (loader.idle()) break;
+        }
+        r.residentMs = total.ms();
+    }
+    if (texture) glDeleteTextures(1, &texture);
+    scene.destroy();
+    return r;
+}
+
+int main(int argc, char** argv)
+{
+    std::string obj        = argStr(argc, argv, "--obj", "");
+    const std::string tex  = argStr(argc, argv, "--tex", "./assets/background.jpg");
+    const double budgetMs  = argInt(argc, argv, "--budget", 4);
+    const bool warm        = argInt(argc, argv, "--warm", 0) != 0;
+
+    if (obj.empty()) {
+        obj = "bench_assets_synth.obj";
+        if (!writeSynthetic(obj, 500)) { std::fprintf(stderr, "ecriture impossible : %s\n", obj.c_str()); return 1; }
+    }
+
+    GLFWwindow* win = createHiddenContext(640, 480);
+    if (!win) return 1;
+
+    std::printf("bench_assets : %s + %s, cache %s, budget upload %.1f ms/frame (GL: %s)\n",
+                obj.c_str(), tex.c_str(), warm ? "chaud" : "froid", budgetMs,
+                (const char*)glGetString(GL_RENDERER));
+    std::printf("  %-12s %16s %16s %16s %8s\n", "", "1re frame (ms)", "residents (ms)", "pire frame (ms)", "frames");
+    for (int async = 0; async < 2; ++async) {
+        const StartupResult r = run(win, obj, tex, async != 0, budgetMs, warm);
+        std::printf("  %-12s %16.1f %16.1f %16.2f %8d\n", async ? "asynchrone" : "synchrone",
+                    r.firstFrameMs, r.residentMs, r.worstFrameMs, r.frames);
+    }
+
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
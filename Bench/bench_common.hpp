@@ -0,0 +1,164 @@
+#pragma once
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file bench_common.hpp
+ * @brief Petits utilitaires partagés par les cibles de benchmark (Bench/).
+ *
+ * @details
+ * - createHiddenContext() : contexte OpenGL 3.3 core sur une fenêtre GLFW invisible,
+ *   vsync désactivée (fonctionne avec Mesa llvmpipe).
+ * - BenchClock : chronomètre steady_clock en millisecondes.
+ * - argInt() / argStr() : lecture d'un argument "--nom valeur".
+ * - median() : médiane de mesures répétées.
+ * - evictFromPageCache() : retire un fichier du cache disque (mesures "à froid", Linux).
+ * - writeSyntheticGridOBJ() : modèle OBJ synthétique (grille paramétrée) quand aucun --obj
+ *   n'est fourni.
+ */
+
+/**
+ * @brief Crée un contexte OpenGL sur une fenêtre invisible et initialise GLEW.
+ * @return Fenêtre GLFW (nullptr en cas d'échec, message sur stderr).
+ */
+inline GLFWwindow* createHiddenContext(int w = 640, int h = 480)
+{
+    if (!glfwInit()) { std::fprintf(stderr, "glfwInit failed\n"); return nullptr; }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* win = glfwCreateWindow(w, h, "bench", nullptr, nullptr);
+    if (!win) { std::fprintf(stderr, "glfwCreateWindow failed\n"); glfwTerminate(); return nullptr; }
+    glfwMakeContextCurrent(win);
+    glfwSwapInterval(0);
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) { std::fprintf(stderr, "glewInit failed\n"); return nullptr; }
+    glGetError();
+    return win;
+}
+
+/**
+ * @struct BenchClock
+ * @brief Chronomètre simple (ms) basé sur steady_clock.
+ */
+struct BenchClock {
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    void reset() { t0 = std::chrono::steady_clock::now(); }
+    double ms() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+};
+
+/**
+ * @brief Lit un argument entier "--name N" (valeur par défaut sinon).
+ */
+inline int argInt(int argc, char** argv, const std::string& name, int def)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+        if (name == argv[i]) return std::atoi(argv[i + 1]);
+    return def;
+}
+
+/**
+ * @brief Lit un argument texte "--name valeur" (valeur par défaut sinon).
+ */
+inline std::string argStr(int argc, char** argv, const std::string& name, const std::string& def)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+        if (name == argv[i]) return argv[i + 1];
+    return def;
+}
+
+/// @brief Médiane (élément central après tri) de mesures répétées ; 0 si vide.
+inline double median(std::vector<double> v)
+{
+    std::sort(v.begin(), v.end());
+    return v.empty() ? 0.0 : v[v.size() / 2];
+}
+
+/**
+ * @brief Retire les pages d'un fichier du cache disque : la lecture suivante vient du disque.
+ * @return false si impossible (fichier absent, plateforme autre que Linux).
+ */
+inline bool evictFromPageCache(const std::string& path)
+{
+#ifdef __linux__
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    fdatasync(fd);
+    const bool ok = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    ::close(fd);
+    return ok;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+/// @brief Options de writeSyntheticGridOBJ().
+enum SyntheticObjFlags : unsigned {
+    OBJ_UV      = 1u << 0, ///< Une ligne "vt" par sommet.
+    OBJ_NORMALS = 1u << 1, ///< Une ligne "vn" par sommet (fournie par la forme).
+    OBJ_QUADS   = 1u << 2, ///< Faces à 4 sommets (sinon 2 triangles par case).
+};
+
+/// @brief Forme de la grille : position (et normale) du sommet de paramètres (u, v) dans [0, 1]².
+using GridShapeFn = std::function<void(float u, float v, float pos[3], float nrm[3])>;
+
+/**
+ * @brief Écrit une grille nu x nv cases en OBJ (sommets "v", puis "vt" et "vn" selon flags).
+ * @details Les uv sont (u, v) ; les indices v / vt / vn d'un sommet sont identiques
+ *          ("a", "a/a", "a//a" ou "a/a/a"). Plan bosselé, sphère... : voir les appelants.
+ * @return false si le fichier ne peut être écrit.
+ */
+inline bool writeSyntheticGridOBJ(const std::string& path, int nu, int nv, unsigned flags, const GridShapeFn& shape)
+{
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "# synthetic grid %dx%d\n", nu, nv);
+
+    std::vector<float> nrm;
+    if (flags & OBJ_NORMALS) nrm.reserve((size_t)(nu + 1) * (nv + 1) * 3);
+    for (int j = 0; j <= nv; ++j)
+        for (int i = 0; i <= nu; ++i) {
+            float p[3] = { 0, 0, 0 }, n[3] = { 0, 0, 1 };
+            shape((float)i / nu, (float)j / nv, p, n);
+            std::fprintf(f, "v %.6f %.6f %.6f\n", p[0], p[1], p[2]);
+            if (flags & OBJ_NORMALS) nrm.insert(nrm.end(), n, n + 3);
+        }
+    if (flags & OBJ_UV)
+        for (int j = 0; j <= nv; ++j)
+            for (int i = 0; i <= nu; ++i) std::fprintf(f, "vt %.5f %.5f\n", (float)i / nu, (float)j / nv);
+    for (size_t k = 0; k < nrm.size(); k += 3) std::fprintf(f, "vn %.5f %.5f %.5f\n", nrm[k], nrm[k + 1], nrm[k + 2]);
+
+    const char* fmt = (flags & OBJ_UV) ? ((flags & OBJ_NORMALS) ? " %d/%d/%d" : " %d/%d")
+                                       : ((flags & OBJ_NORMALS) ? " %d//%d" : " %d");
+    auto vert = [&](int k) { std::fprintf(f, fmt, k, k, k); };
+    for (int j = 0; j < nv; ++j)
+        for (int i = 0; i < nu; ++i) {
+            const int a = j * (nu + 1) + i + 1, b = a + 1, c = a + nu + 2, d = a + nu + 1;
+            if (flags & OBJ_QUADS) {
+                std::fputc('f', f); vert(a); vert(b); vert(c); vert(d); std::fputc('\n', f);
+            } else {
+                std::fputc('f', f); vert(a); vert(b); vert(c); std::fputc('\n', f);
+                std::fputc('f', f); vert(a); vert(c); vert(d); std::fputc('\n', f);
+            }
+        }
+    return std::fclose(f) == 0;
+}
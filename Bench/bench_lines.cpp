@@ -0,0 +1,161 @@
+// Bench/bench_lines.cpp
+// Lignes épaisses : geometry shader LINE_GS (un VAO + un bloc Object + un draw par ligne,
+// chemin d'origine des axes ; puis toutes les lignes dans un seul draw GL_LINES) vs
+// LineBatch (quad instancié étendu dans le vertex shader, un upload + un draw).
+//
+// Usage : ./bench_lines [--lines 10000] [--frames 100]
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "GLUtils/gl_state.hpp"
+#include "GLUtils/uniform_buffers.hpp"
+#include "LineBatch/line_batch.hpp"
+#include "Shaders/shaders.hpp"
+
+struct Segment { glm::vec3 a, b; glm::vec4 color; };
+
+/// @brief VAO de positions (GL_LINES) : un segment, ou tous.
+static GLuint makeLineVao(const std::vector<glm::vec3>& pts, GLuint& vbo)
+{
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(pts.size() * sizeof(glm::vec3)), pts.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glBindVertexArray(0);
+    return vao;
+}
+
+struct Timing { double submitMs = 0.0, frameMs = 0.0; };
+
+/// @brief Moyenne par frame de f() (soumission CPU, puis frame complète avec glFinish).
+template <class F>
+static Timing measure(int frames, F&& f)
+{
+    f();
+    glFinish();
+    Timing t;
+    for (int i = 0; i < frames; ++i) {
+        BenchClock frame;
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BenchClock submit;
+        f();
+        t.submitMs += submit.ms();
+        glFinish();
+        t.frameMs += frame.ms();
+    }
+    t.submitMs /= frames;
+    t.frameMs /= frames;
+    return t;
+}
+
+int main(int argc, char** argv)
+{
+    const int count  = argInt(argc, argv, "--lines", 10000);
+    const int frames = argInt(argc, argv, "--frames", 100);
+    const int W = 1280, H = 720;
+
+    GLFWwindow* win = createHiddenContext(W, H);
+    if (!win) return 1;
+    glViewport(0, 0, W, H);
+    glEnable(GL_DEPTH_TEST);
+
+    GLuint progGS = linkProgram({ compileShader(GL_VERTEX_SHADER, LINE_VS),
+                                  compileShader(GL_GEOMETRY_SHADER, LINE_GS),
+                                  compileShader(GL_FRAGMENT_SHADER, LINE_FS) });
+    GLuint progInst = linkProgram({ compileShader(GL_VERTEX_SHADER, THICKLINE_VS),
+                                    compileShader(GL_FRAGMENT_SHADER, THICKLINE_FS) });
+    UniformBuffers::bindBlocks(progGS);
+    UniformBuffers::bindBlocks(progInst);
+
+    // Segments aléatoires devant la caméra (repère "board" = identité)
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    std::vector<Segment> segs(count);
+    for (Segment& s : segs) {
+        s.a = glm::vec3(u(rng), u(rng), -3.0f + u(rng));
+        s.b = s.a + 0.2f * glm::vec3(u(rng), u(rng), u(rng));
+        s.color = glm::vec4(0.5f + 0.5f * u(rng), 0.5f + 0.5f * u(rng), 0.5f + 0.5f * u(rng), 1.0f);
+    }
+    const float widthPx = 3.0f;
+
+    UniformBuffers ubo;
+    ubo.create(count + 1);
+    const glm::mat4 P = glm::perspective(glm::radians(60.0f), (float)W / H, 0.01f, 100.0f);
+    ubo.setCamera(P, glm::mat4(1.0f), (float)W, (float)H);
+
+    // 1) Chemin d'origine : un VAO et un bloc Object (couleur, épaisseur) par ligne
+    std::vector<GLuint> vaos(count), vbos(count);
+    for (int i = 0; i < count; ++i) vaos[i] = makeLineVao({ segs[i].a, segs[i].b }, vbos[i]);
+    const Timing perLine = measure(frames, [&] {
+        ubo.beginObjects();
+        for (const Segment& s : segs) ubo.pushObject(glm::mat4(1.0f), s.color, glm::vec4(widthPx, 0.f, 0.f, 0.f));
+        ubo.uploadObjects();
+        glUseProgram(progGS);
+        for (int i = 0; i < count; ++i) {
+            ubo.bindObject(i);
+            glBindVertexArray(vaos[i]);
+            glDrawArrays(GL_LINES, 0, 2);
+        }
+    });
+
+    // 2) Geometry shader, toutes les lignes en un draw (une seule couleur : coût du GS seul)
+    GLuint allVbo = 0;
+    std::vector<glm::vec3> pts;
+    for (const Segment& s : segs) { pts.push_back(s.a); pts.push_back(s.b); }
+    const GLuint allVao = makeLineVao(pts, allVbo);
+    const Timing gsBatch = measure(frames, [&] {
+        ubo.beginObjects();
+        ubo.pushObject(glm::mat4(1.0f), glm::vec4(1.0f), glm::vec4(widthPx, 0.f, 0.f, 0.f));
+        ubo.uploadObjects();
+        ubo.bindObject(0);
+        glUseProgram(progGS);
+        glBindVertexArray(allVao);
+        glDrawArrays(GL_LINES, 0, (GLsizei)pts.size());
+    });
+
+    // 3) LineBatch : instances streamées, un draw
+    glState().invalidate(); // les chemins 1 et 2 lient programme et VAO sans passer par le cache
+    LineBatch batch;
+    batch.create();
+    const Timing inst = measure(frames, [&] {
+        ubo.beginObjects();
+        ubo.pushObject(glm::mat4(1.0f), glm::vec4(1.0f));
+        ubo.uploadObjects();
+        ubo.bindObject(0);
+        batch.begin();
+        for (const Segment& s : segs) batch.add(s.a, s.b, s.color, widthPx);
+        batch.draw(progInst);
+    });
+
+    std::printf("bench_lines : %d lignes de %.0f px, %d frames, %dx%d (GL: %s)\n", count, 2 * widthPx, frames,
+                W, H, (const char*)glGetString(GL_RENDERER));
+    std::printf("  %-36s %10s %10s\n", "", "submit ms", "frame ms");
+    std::printf("  %-36s %10.3f %10.3f\n", "GS, un VAO + un draw par ligne", perLine.submitMs, perLine.frameMs);
+    std::printf("  %-36s %10.3f %10.3f\n", "GS, un draw (couleur unique)", gsBatch.submitMs, gsBatch.frameMs);
+    std::printf("  %-36s %10.3f %10.3f\n", "instancie (LineBatch), un draw", inst.submitMs, inst.frameMs);
+
+    batch.destroy();
+    for (int i = 0; i < count; ++i) { glDeleteVertexArrays(1, &vaos[i]); glDeleteBuffers(1, &vbos[i]); }
+    glDeleteVertexArrays(1, &allVao);
+    glDeleteBuffers(1, &allVbo);
+    ubo.destroy();
+    glDeleteProgram(progGS);
+    glDeleteProgram(progInst);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
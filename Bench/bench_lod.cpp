@@ -0,0 +1,121 @@
+// Bench/bench_lod.cpp
+// Niveaux de détail des modèles OBJ : triangles soumis et temps de frame selon la distance
+// caméra, LOD désactivé (toujours LOD 0) vs choix par taille projetée (erreur <= 1 px).
+//
+// Usage : ./bench_lod [--obj fichier.obj] [--frames 100] [--height 720]
+//   Sans --obj : sphère bosselée dense (160 000 triangles) écrite dans bench_lod_synth.obj
+//   Le cache "<obj>.meshcache" est supprimé : le chargement inclut la génération des LOD.
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "Bench/bench_common.hpp"
+#include "Shaders/shaders.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "MeshCache/mesh_cache.hpp"
+#include "SceneObjects.hpp"
+
+// Sphère unité bosselée, normales et uv (couture en u = 0 / 1)
+static bool writeSynthetic(const std::string& path, int stacks, int slices)
+{
+    return writeSyntheticGridOBJ(path, slices, stacks, OBJ_UV | OBJ_NORMALS, [](float u, float v, float* p, float* n) {
+        const float ph = 3.14159265f * v, th = 6.28318531f * (1.0f - u); // th décroissant : orientation des faces de la version d'origine
+        const float r = 0.5f + 0.02f * std::sin(7.0f * th) * std::sin(5.0f * ph);
+        n[0] = std::sin(ph) * std::cos(th);
+        n[1] = std::cos(ph);
+        n[2] = std::sin(ph) * std::sin(th);
+        p[0] = r * n[0];
+        p[1] = r * n[1];
+        p[2] = r * n[2];
+    });
+}
+
+int main(int argc, char** argv)
+{
+    std::string path   = argStr(argc, argv, "--obj", "");
+    const int nFrames  = argInt(argc, argv, "--frames", 100);
+    const int height   = argInt(argc, argv, "--height", 720);
+    const int width    = height * 4 / 3;
+
+    if (path.empty()) {
+        path = "bench_lod_synth.obj";
+        if (!writeSynthetic(path, 200, 400)) { std::fprintf(stderr, "ecriture impossible : %s\n", path.c_str()); return 1; }
+    }
+
+    GLFWwindow* win = createHiddenContext(width, height);
+    if (!win) return 1;
+
+    GLuint prog = linkProgram({ compileShader(GL_VERTEX_SHADER, MESH_VS),
+                                compileShader(GL_FRAGMENT_SHADER, MESH_FS) });
+    GLint uMVP   = glGetUniformLocation(prog, "uMVP");
+    GLint uColor = glGetUniformLocation(prog, "uFaceColor");
+
+    std::error_code ec;
+    std::filesystem::remove(meshCachePath(path), ec);
+
+    // Modèle ramené à ~10 cm (taille d'un objet posé sur la feuille A4)
+    SceneObjects scene;
+    BenchClock load;
+    const int item = scene.addOBJ(path, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+    const double loadMs = load.ms();
+    const MeshBounds& b = scene.item(item).bounds;
+    if (scene.item(item).mesh.vao == 0 || b.radius <= 0.0f) { std::fprintf(stderr, "chargement echoue\n"); return 1; }
+    const float s = 0.05f / b.radius;
+    scene.setTransform(item, -b.center * s, glm::vec3(0.0f), glm::vec3(s));
+
+    const SceneObjects::Item& it = scene.item(item);
+    std::printf("bench_lod : %s, %u LOD, chargement %.1f ms (GL: %s)\n",
+                path.c_str(), it.lodCount, loadMs, (const char*)glGetString(GL_RENDERER));
+    for (uint32_t l = 0; l < it.lodCount; ++l) {
+        size_t tris = 0;
+        const size_t perLod = it.submeshes.empty() ? 0 : it.submeshes.size() / it.lodCount;
+        for (size_t k = 0; k < perLod; ++k) tris += it.submeshes[l * perLod + k].count / 3;
+        std::printf("  LOD %u : %zu triangles, erreur %.5f (unites du modele)\n", l, tris, it.lodError[l]);
+    }
+
+    glViewport(0, 0, width, height);
+    glEnable(GL_DEPTH_TEST);
+    const glm::mat4 P = glm::perspective(glm::radians(45.0f), (float)width / height, 0.01f, 100.0f);
+
+    std::printf("\n  %-10s %8s | %10s %10s | %10s %10s %5s\n", "distance", "px", "tri LOD0", "frame ms",
+                "tri LOD", "frame ms", "LOD");
+    const float distances[] = { 0.15f, 0.3f, 0.6f, 1.2f, 2.4f };
+    for (float d : distances) {
+        const glm::mat4 MVP = P * glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -d));
+        const float px = 0.05f / (d * std::tan(glm::radians(22.5f))) * height; // diamètre projeté
+
+        int tris[2] = { 0, 0 }, lodShown = 0;
+        double frameMs[2] = { 0.0, 0.0 };
+        for (int mode = 0; mode < 2; ++mode) {
+            scene.setLodSelection((float)height, mode == 0 ? 0.0f : 1.0f);
+            scene.drawAll(prog, uMVP, uColor, MVP); // warm-up
+            glFinish();
+            BenchClock clk;
+            for (int f = 0; f < nFrames; ++f) {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                scene.drawAll(prog, uMVP, uColor, MVP);
+                glFinish();
+            }
+            frameMs[mode] = clk.ms() / nFrames;
+            tris[mode] = scene.lastStats().triangles;
+            for (uint32_t l = 0; l < SceneObjects::MAX_LODS; ++l)
+                if (scene.lastStats().lodItems[l]) lodShown = (int)l;
+        }
+        std::printf("  %7.2f m %8.0f | %10d %10.3f | %10d %10.3f %5d\n",
+                    d, px, tris[0], frameMs[0], tris[1], frameMs[1], lodShown);
+    }
+
+    scene.destroy();
+    glDeleteProgram(prog);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
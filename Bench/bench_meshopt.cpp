@@ -0,0 +1,222 @@
+// Bench/bench_meshopt.cpp
+// Optimisations post-chargement des maillages (mesh_optimizer.hpp), par maillage :
+//  - cache de sommets : ACMR / ATVR (FIFO 16 simulé) dans l'ordre source puis après Forsyth + fetch ;
+//  - mémoire GPU (VBO + EBO) : source (float, indices 32 bits), optimisé (indices 16 bits si
+//    possible), optimisé + quantifié (16 octets / sommet) ;
+//  - débit GPU : indices traités / s sur N draws (GL_TIME_ELAPSED), petite fenêtre pour
+//    rester limité par les sommets.
+//
+// Usage : ./bench_meshopt [--obj fichier.obj] [--draws 200] [--cpu 1]
+//   --cpu 1 : partie CPU seule (pas de contexte GL)
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "Shaders/shaders.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "FileIO/mapped_file.hpp"
+#include "ObjLoader/obj_loader.hpp"
+#include "MeshOptimizer/mesh_optimizer.hpp"
+#include "Geometries/geometries.hpp"
+#include "Ball.hpp"
+
+struct TestMesh {
+    std::string name;
+    ObjModel src;   ///< Ordre source (tel que généré / lu).
+    ObjModel opt;   ///< Après optimizeModel().
+};
+
+// Modèle à un seul sous-maillage depuis un maillage de positions (normale = position normalisée)
+static ObjModel fromMeshData(const MeshData& d)
+{
+    ObjModel m;
+    m.vertices.resize(d.pos.size() / 3);
+    for (size_t v = 0; v < m.vertices.size(); ++v) {
+        ObjVertex& o = m.vertices[v];
+        const glm::vec3 p(d.pos[3 * v], d.pos[3 * v + 1], d.pos[3 * v + 2]);
+        const glm::vec3 n = glm::length(p) > 0.0f ? glm::normalize(p) : glm::vec3(0.0f, 0.0f, 1.0f);
+        for (int k = 0; k < 3; ++k) { o.pos[k] = p[k]; o.nrm[k] = n[k]; }
+        o.uv[0] = o.uv[1] = 0.0f;
+    }
+    m.idx = d.idx;
+    m.submeshes.push_back({ 0u, (uint32_t)d.idx.size(), 0u });
+    m.materialNames.push_back("");
+    return m;
+}
+
+// Sphère UV dans l'ordre des bandes (buildSphere() avant optimisation)
+static MeshData sphereSourceOrder(float radius, int stacks, int slices)
+{
+    MeshData d;
+    for (int i = 0; i <= stacks; ++i) {
+        const float phi = (float)i / stacks * 3.14159265f;
+        for (int j = 0; j <= slices; ++j) {
+            const float th = (float)j / slices * 6.28318531f;
+            d.pos.insert(d.pos.end(), { radius * std::sin(phi) * std::cos(th), radius * std::cos(phi),
+                                        radius * std::sin(phi) * std::sin(th) });
+        }
+    }
+    for (int i = 0; i < stacks; ++i)
+        for (int j = 0; j < slices; ++j) {
+            const uint32_t a = i * (slices + 1) + j, b = a + slices + 1, c = b + 1, e = a + 1;
+            d.idx.insert(d.idx.end(), { a, b, c, a, c, e });
+        }
+    return d;
+}
+
+// Grille n x n (ordre de balayage, comme la plupart des exports)
+static MeshData gridSourceOrder(int n)
+{
+    MeshData d;
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            d.pos.insert(d.pos.end(), { (float)x / n, (float)y / n, 0.05f * std::sin(0.3f * x) });
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x) {
+            const uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, e = c + 1;
+            d.idx.insert(d.idx.end(), { a, b, e, a, e, c });
+        }
+    return d;
+}
+
+static VertexCacheStats cacheStats(const ObjModel& m)
+{
+    return analyzeVertexCache(m.idx.data(), m.idx.size(), m.vertices.size());
+}
+
+// Octets GPU : VBO + EBO
+static size_t bytesFloat32(const ObjModel& m) { return m.vertices.size() * sizeof(ObjVertex) + m.idx.size() * 4; }
+static size_t bytesOpt(const ObjModel& m)
+{
+    return m.vertices.size() * sizeof(ObjVertex) + m.idx.size() * (m.vertices.size() <= 65536 ? 2 : 4);
+}
+static size_t bytesQuant(const ObjModel& m)
+{
+    return m.vertices.size() * sizeof(QuantizedVertex) + m.idx.size() * (m.vertices.size() <= 65536 ? 2 : 4);
+}
+
+// Ancien chemin : sommets flottants et indices 32 bits, ordre source
+static Mesh uploadLegacy(const ObjModel& m)
+{
+    Mesh r = uploadMeshPNT(m.vertices[0].pos, m.vertices.size(), m.idx.data(), m.idx.size());
+    if (r.indexType != GL_UNSIGNED_INT) {
+        glBindVertexArray(r.vao);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m.idx.size() * 4, m.idx.data(), GL_STATIC_DRAW);
+        glBindVertexArray(0);
+        r.indexType = GL_UNSIGNED_INT;
+    }
+    return r;
+}
+
+// Indices / s (millions) sur `draws` appels, temps GPU mesuré par requête
+static double gpuThroughput(const Mesh& mesh, GLuint prog, GLint uMVP, int draws)
+{
+    glm::mat4 MVP = glm::perspective(glm::radians(60.0f), 1.0f, 0.01f, 100.0f)
+                  * glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -3.0f));
+    MVP = glm::translate(MVP, glm::vec3(mesh.posOffset[0], mesh.posOffset[1], mesh.posOffset[2]));
+    MVP = glm::scale(MVP, glm::vec3(mesh.posScale[0], mesh.posScale[1], mesh.posScale[2]));
+
+    glUseProgram(prog);
+    glUniformMatrix4fv(uMVP, 1, GL_FALSE, &MVP[0][0]);
+    glVertexAttrib4f(1, 0.0f, 0.0f, 0.0f, 1.0f);
+    glBindVertexArray(mesh.vao);
+
+    for (int i = 0; i < 5; ++i) glDrawElements(GL_TRIANGLES, mesh.count, mesh.indexType, 0); // warm-up
+    glFinish();
+
+    GLuint q = 0;
+    glGenQueries(1, &q);
+    glBeginQuery(GL_TIME_ELAPSED, q);
+    for (int i = 0; i < draws; ++i) glDrawElements(GL_TRIANGLES, mesh.count, mesh.indexType, 0);
+    glEndQuery(GL_TIME_ELAPSED);
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(q, GL_QUERY_RESULT, &ns);
+    glDeleteQueries(1, &q);
+    glBindVertexArray(0);
+
+    return ns ? (double)mesh.count * draws / (double)ns * 1000.0 : 0.0;
+}
+
+int main(int argc, char** argv)
+{
+    const std::string objPath = argStr(argc, argv, "--obj", "");
+    const int draws = argInt(argc, argv, "--draws", 200);
+    const bool cpuOnly = argInt(argc, argv, "--cpu", 0) != 0;
+
+    std::vector<TestMesh> meshes;
+    meshes.push_back({ "sphere 16x16", fromMeshData(sphereSourceOrder(0.5f, 16, 16)), {} });
+    {
+        Maze maze(8, 6, 0.297f, 0.210f, 0.0035f);
+        maze.generate();
+        meshes.push_back({ "labyrinthe 8x6", fromMeshData(buildMazeWallsSolidFromMaze(maze, 0.04f)), {} });
+    }
+    if (!objPath.empty()) {
+        MappedFile f;
+        TestMesh t{ objPath, {}, {} };
+        if (!f.open(objPath) || !parseOBJModel(f.data(), f.size(), t.src)) {
+            std::fprintf(stderr, "chargement echoue : %s\n", objPath.c_str());
+            return 1;
+        }
+        meshes.push_back(std::move(t));
+    } else {
+        meshes.push_back({ "grille 200x200", fromMeshData(gridSourceOrder(200)), {} });
+    }
+
+    std::printf("bench_meshopt : cache FIFO 16 simule, memoire VBO + EBO\n");
+    std::printf("  %-16s %8s %8s %9s %9s %9s %9s %10s %10s %10s %8s\n", "", "sommets", "tri",
+                "ACMR src", "ACMR opt", "ATVR src", "ATVR opt", "Ko src", "Ko opt", "Ko quant", "opt ms");
+    for (TestMesh& t : meshes) {
+        t.opt = t.src;
+        BenchClock clk;
+        optimizeModel(t.opt);
+        const double ms = clk.ms();
+        const VertexCacheStats a = cacheStats(t.src), b = cacheStats(t.opt);
+        std::printf("  %-16s %8zu %8zu %9.3f %9.3f %9.3f %9.3f %10.1f %10.1f %10.1f %8.2f\n",
+                    t.name.c_str(), t.src.vertices.size(), t.src.idx.size() / 3,
+                    a.acmr, b.acmr, a.atvr, b.atvr,
+                    bytesFloat32(t.src) / 1024.0, bytesOpt(t.opt) / 1024.0, bytesQuant(t.opt) / 1024.0, ms);
+    }
+    if (cpuOnly) return 0;
+
+    GLFWwindow* win = createHiddenContext(64, 64);
+    if (!win) return 1;
+    GLuint prog = linkProgram({ compileShader(GL_VERTEX_SHADER, MESH_VS),
+                                compileShader(GL_FRAGMENT_SHADER, MESH_FS) });
+    const GLint uMVP = glGetUniformLocation(prog, "uMVP");
+    glViewport(0, 0, 64, 64);
+    glEnable(GL_DEPTH_TEST);
+
+    std::printf("\n  debit GPU, %d draws (Mindices/s, GL: %s)\n", draws, (const char*)glGetString(GL_RENDERER));
+    std::printf("  %-16s %14s %14s %14s\n", "", "src 32 bits", "opt 16 bits", "opt + quant");
+    for (const TestMesh& t : meshes) {
+        Mesh legacy = uploadLegacy(t.src);
+        Mesh opt = uploadMeshPNT(t.opt.vertices[0].pos, t.opt.vertices.size(), t.opt.idx.data(), t.opt.idx.size());
+        std::vector<QuantizedVertex> qv(t.opt.vertices.size());
+        float scale[3], offset[3];
+        quantizeVertices(t.opt.vertices.data(), qv.size(), qv.data(), scale, offset);
+        Mesh quant = uploadMeshQuantized(qv.data(), qv.size(), t.opt.idx.data(), t.opt.idx.size(), scale, offset);
+
+        const double r0 = gpuThroughput(legacy, prog, uMVP, draws);
+        const double r1 = gpuThroughput(opt, prog, uMVP, draws);
+        const double r2 = gpuThroughput(quant, prog, uMVP, draws);
+        std::printf("  %-16s %14.1f %14.1f %14.1f\n", t.name.c_str(), r0, r1, r2);
+
+        destroyMesh(legacy);
+        destroyMesh(opt);
+        destroyMesh(quant);
+    }
+
+    glDeleteProgram(prog);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
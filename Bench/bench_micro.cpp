@@ -0,0 +1,239 @@
+// Bench/bench_micro.cpp
+// Micro-benchmarks des fonctions chaudes d'arcube (harnais : Bench/microbench.hpp) :
+// constructeurs de géométrie (appendBoxSolid, buildMazeWallsSolidFromMaze, buildSphere),
+// matrices AR (projectionFromCV, modelFromRvecTvec_OpenCVtoGL), lissage (PoseSmoother::smooth,
+// PtsSmoother::apply), Maze::generate et Ball::update, sur des tailles réalistes
+// (labyrinthe 8x6 d'arcube jusqu'à 64x48, sphère 8x8 à 64x64).
+//
+// Les cas CPU tournent sans contexte GL. Avec --gl, un contexte caché mesure aussi les envois
+// seuls (uploadMeshData de données déjà construites) et les create*() complets
+// (construction + envoi) : la différence sépare le coût CPU du coût pilote.
+//
+// Usage : ./bench_micro [--gl] [--filter Maze] [--min-ms 100] [--reps 5] [--json bench_micro.json]
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "Bench/microbench.hpp"
+#include "ARMatrices/ar_matrices.hpp"
+#include "Capture/pose_source.hpp"
+#include "Smoothing/smoothing.hpp"
+#include "Ball.hpp"
+
+/// @brief Labyrinthe de cx x cy cases sur la feuille A4 d'arcube, généré.
+static Maze makeMaze(int cx, int cy)
+{
+    Maze m(cx, cy, 0.297f, 0.210f, 0.0035f);
+    m.generate();
+    return m;
+}
+
+/// @brief Poses scriptées (une par frame à 30 i/s) : entrées réalistes des noyaux de pose.
+static void makePoses(int n, std::vector<cv::Mat>& r, std::vector<cv::Mat>& t)
+{
+    r.resize(n);
+    t.resize(n);
+    for (int i = 0; i < n; ++i) scriptedPose(i / 30.0, r[i], t[i]);
+}
+
+static const std::vector<std::vector<int64_t>> kMazeSizes = { { 8, 6 }, { 16, 12 }, { 32, 24 }, { 64, 48 } };
+static const std::vector<std::vector<int64_t>> kSphereSizes = { { 8, 8 }, { 16, 16 }, { 32, 32 }, { 64, 64 } };
+
+static void addCpuCases(MicroRunner& r)
+{
+    // Boîtes ajoutées à des tampons réutilisés (capacité conservée) : coût d'ajout seul
+    r.add("appendBoxSolid", [](MicroState& st) {
+        const int boxes = (int)st.arg(0);
+        std::vector<float> V;
+        std::vector<uint32_t> I;
+        V.reserve((size_t)boxes * 24);
+        I.reserve((size_t)boxes * 36);
+        while (st.keepRunning()) {
+            V.clear();
+            I.clear();
+            for (int b = 0; b < boxes; ++b)
+                appendBoxSolid(b * 0.01f, 0.0f, 0.0f, b * 0.01f + 0.0035f, 0.035f, 0.04f, V, I);
+            doNotOptimize(I.data());
+        }
+        st.setItemsProcessed(st.iterations() * boxes);
+        st.setItemLabel("boites");
+    }, { { 16 }, { 64 }, { 256 } });
+
+    r.add("buildMazeWallsSolidFromMaze", [](MicroState& st) {
+        const Maze maze = makeMaze((int)st.arg(0), (int)st.arg(1));
+        size_t tris = 0;
+        while (st.keepRunning()) {
+            const MeshData d = buildMazeWallsSolidFromMaze(maze, 0.040f);
+            tris = d.idx.size() / 3;
+            doNotOptimize(d);
+        }
+        st.setItemsProcessed(st.iterations() * (int64_t)tris);
+        st.setItemLabel("tri");
+    }, kMazeSizes);
+
+    r.add("buildSphere", [](MicroState& st) {
+        size_t verts = 0;
+        while (st.keepRunning()) {
+            const MeshData d = buildSphere(0.010f, (int)st.arg(0), (int)st.arg(1));
+            verts = d.pos.size() / 3;
+            doNotOptimize(d);
+        }
+        st.setItemsProcessed(st.iterations() * (int64_t)verts);
+        st.setItemLabel("sommets");
+    }, kSphereSizes);
+
+    // Intrinsèques 1280x720 typiques (focale ~ 0.8 x largeur)
+    r.add("projectionFromCV", [](MicroState& st) {
+        const cv::Mat K = (cv::Mat_<double>(3, 3) << 1024, 0, 640, 0, 1024, 360, 0, 0, 1);
+        while (st.keepRunning()) {
+            const glm::mat4 P = projectionFromCV(K, 1280.0f, 720.0f, 0.01f, 10.0f);
+            doNotOptimize(P);
+        }
+    });
+
+    r.add("modelFromRvecTvec_OpenCVtoGL", [](MicroState& st) {
+        std::vector<cv::Mat> rv, tv;
+        makePoses(256, rv, tv);
+        int64_t i = 0;
+        while (st.keepRunning()) {
+            const glm::mat4 M = modelFromRvecTvec_OpenCVtoGL(rv[i & 255], tv[i & 255]);
+            doNotOptimize(M);
+            ++i;
+        }
+    });
+
+    // Lissage en place : chaque itération part d'une copie de la pose source (copie 3x1
+    // sans allocation, comprise dans la mesure), comme la pose fraîche de chaque frame
+    r.add("PoseSmoother::smooth", [](MicroState& st) {
+        std::vector<cv::Mat> rv, tv;
+        makePoses(256, rv, tv);
+        PoseSmoother s;
+        s.alphaPose = 0.25;
+        cv::Mat r = rv[0].clone(), t = tv[0].clone();
+        int64_t i = 0;
+        while (st.keepRunning()) {
+            rv[i & 255].copyTo(r);
+            tv[i & 255].copyTo(t);
+            s.smooth(r, t);
+            doNotOptimize(r);
+            ++i;
+        }
+    });
+
+    r.add("PtsSmoother::apply", [](MicroState& st) {
+        std::vector<std::vector<cv::Point2f>> quads(256);
+        for (int q = 0; q < 256; ++q) {
+            const float d = 2.0f * std::sin(q * 0.1f);
+            quads[q] = { { 400 + d, 200 }, { 880, 200 + d }, { 880 - d, 520 }, { 400, 520 - d } };
+        }
+        PtsSmoother s;
+        std::vector<cv::Point2f> q = quads[0];
+        int64_t i = 0;
+        while (st.keepRunning()) {
+            q.assign(quads[i & 255].begin(), quads[i & 255].end());
+            s.apply(q);
+            doNotOptimize(q);
+            ++i;
+        }
+    });
+
+    // Labyrinthe neuf à chaque itération (construction hors mesure)
+    r.add("Maze::generate", [](MicroState& st) {
+        const int cx = (int)st.arg(0), cy = (int)st.arg(1);
+        while (st.keepRunning()) {
+            st.pauseTiming();
+            Maze m(cx, cy, 0.297f, 0.210f, 0.0035f);
+            st.resumeTiming();
+            m.generate();
+            doNotOptimize(m.grid);
+        }
+        st.setItemsProcessed(st.iterations() * cx * cy);
+        st.setItemLabel("cases");
+    }, kMazeSizes);
+
+    // Un pas de physique à 60 Hz par pose ; balle sans maillage (pas de contexte GL). Le coût
+    // ne dépend que de la case courante : labyrinthe 8x6 d'arcube seulement
+    r.add("Ball::update", [](MicroState& st) {
+        const Maze maze = makeMaze(8, 6);
+        std::vector<cv::Mat> rv, tv;
+        makePoses(256, rv, tv);
+        Ball ball(0.010f, false);
+        ball.reset(maze);
+        ball.setFlatReference(rv[0]);
+        int64_t i = 0;
+        while (st.keepRunning()) {
+            ball.update(1.0f / 60.0f, rv[i & 255], maze);
+            doNotOptimize(ball.pos);
+            ++i;
+        }
+    });
+}
+
+static void addGlCases(MicroRunner& r)
+{
+    // Envoi seul de données déjà construites ; glFinish à chaque itération : la mesure couvre
+    // la copie effective par le pilote, pas seulement la mise en file
+    r.add("gl/uploadMeshData/maze", [](MicroState& st) {
+        const MeshData d = buildMazeWallsSolidFromMaze(makeMaze((int)st.arg(0), (int)st.arg(1)), 0.040f);
+        while (st.keepRunning()) {
+            Mesh m = uploadMeshData(d);
+            destroyMesh(m);
+            glFinish();
+        }
+        st.setItemsProcessed(st.iterations() * (int64_t)((d.pos.size() + d.idx.size()) * 4));
+        st.setItemLabel("octets");
+    }, kMazeSizes);
+
+    r.add("gl/uploadMeshData/sphere", [](MicroState& st) {
+        const MeshData d = buildSphere(0.010f, (int)st.arg(0), (int)st.arg(1));
+        while (st.keepRunning()) {
+            Mesh m = uploadMeshData(d);
+            destroyMesh(m);
+            glFinish();
+        }
+        st.setItemsProcessed(st.iterations() * (int64_t)((d.pos.size() + d.idx.size()) * 4));
+        st.setItemLabel("octets");
+    }, kSphereSizes);
+
+    // Fonctions complètes d'arcube (construction + envoi)
+    r.add("gl/createMazeWallsSolidFromMaze", [](MicroState& st) {
+        const Maze maze = makeMaze((int)st.arg(0), (int)st.arg(1));
+        while (st.keepRunning()) {
+            Mesh m = createMazeWallsSolidFromMaze(maze, 0.040f);
+            destroyMesh(m);
+            glFinish();
+        }
+    }, kMazeSizes);
+
+    r.add("gl/createSphere", [](MicroState& st) {
+        while (st.keepRunning()) {
+            Mesh m = createSphere(0.010f, (int)st.arg(0), (int)st.arg(1));
+            destroyMesh(m);
+            glFinish();
+        }
+    }, kSphereSizes);
+}
+
+int main(int argc, char** argv)
+{
+    bool gl = false;
+    for (int i = 1; i < argc; ++i) gl |= std::strcmp(argv[i], "--gl") == 0;
+
+    MicroRunner runner(argc, argv);
+    addCpuCases(runner);
+
+    GLFWwindow* win = nullptr;
+    if (gl) {
+        win = createHiddenContext();
+        if (!win) return 2;
+        addGlCases(runner);
+    }
+    const int rc = runner.run();
+    if (win) {
+        glfwDestroyWindow(win);
+        glfwTerminate();
+    }
+    return rc;
+}
@@ -0,0 +1,105 @@
+// Bench/bench_model.cpp
+// Benchmark des modèles OBJ complets (normales, uv, matériaux .mtl) :
+//  - chargement : parse texte + écriture du cache vs cache binaire projeté ;
+//  - rendu : N instances dessinées par SceneObjects::drawAll avec MESH_VS/MESH_FS
+//    (un draw par sous-maillage, trié par texture puis matériau puis VAO).
+//
+// Usage : ./bench_model [--obj fichier.obj] [--instances 16] [--frames 200]
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "Bench/bench_common.hpp"
+#include "Shaders/shaders.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "MeshCache/mesh_cache.hpp"
+#include "SceneObjects.hpp"
+
+static glm::mat4 cameraAt(int frame)
+{
+    glm::mat4 P = glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.01f, 100.0f);
+    glm::mat4 V = glm::translate(glm::mat4(1.0f), glm::vec3(0.001f * (frame % 50), 0.0f, -2.5f));
+    return P * V;
+}
+
+int main(int argc, char** argv)
+{
+    const std::string path = argStr(argc, argv, "--obj", "./assets/obj/SM/Meshy_AI_SM_0115202256_texture.obj");
+    const int nInst   = argInt(argc, argv, "--instances", 16);
+    const int nFrames = argInt(argc, argv, "--frames", 200);
+
+    if (!std::filesystem::exists(path)) {
+        std::fprintf(stderr, "OBJ introuvable : %s (--obj fichier.obj)\n", path.c_str());
+        return 1;
+    }
+
+    GLFWwindow* win = createHiddenContext();
+    if (!win) return 1;
+
+    GLuint prog = linkProgram({ compileShader(GL_VERTEX_SHADER, MESH_VS),
+                                compileShader(GL_FRAGMENT_SHADER, MESH_FS) });
+    GLint uMVP   = glGetUniformLocation(prog, "uMVP");
+    GLint uColor = glGetUniformLocation(prog, "uFaceColor");
+
+    // ---------- Chargement : texte (cache supprimé) puis cache ----------
+    std::error_code ec;
+    std::filesystem::remove(meshCachePath(path), ec);
+
+    SceneObjects scene;
+    BenchClock clk;
+    const int first = scene.addOBJ(path, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+    const double textMs = clk.ms();
+    if (first < 0) { std::fprintf(stderr, "chargement echoue : %s\n", path.c_str()); return 1; }
+
+    clk.reset();
+    for (int i = 1; i < nInst; ++i) {
+        const float x = (float)(i % 4) - 1.5f, y = (float)(i / 4 % 4) - 1.5f;
+        scene.addOBJ(path, glm::vec3(x, y, 0.0f), glm::vec3(0.0f, 0.0f, 30.0f * i), glm::vec3(1.0f));
+    }
+    const double cacheMs = nInst > 1 ? clk.ms() / (nInst - 1) : 0.0;
+
+    // ---------- Rendu ----------
+    glViewport(0, 0, 640, 480);
+    glEnable(GL_DEPTH_TEST);
+
+    scene.drawAll(prog, uMVP, uColor, cameraAt(0)); // warm-up (tri, textures résidentes)
+    glFinish();
+
+    double submit = 0.0;
+    clk.reset();
+    for (int f = 0; f < nFrames; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BenchClock s;
+        scene.drawAll(prog, uMVP, uColor, cameraAt(f));
+        submit += s.ms();
+        glFinish();
+    }
+    const double frame = clk.ms() / nFrames;
+    submit /= nFrames;
+
+    const SceneObjects::DrawStats& st = scene.lastStats();
+    const size_t nSub = scene.item(first).submeshes.size();
+
+    std::printf("bench_model : %s, %d instances, %d frames (GL: %s)\n",
+                path.c_str(), nInst, nFrames, (const char*)glGetString(GL_RENDERER));
+    std::printf("  %-36s %10.1f ms\n", "chargement : parse OBJ + cache", textMs);
+    std::printf("  %-36s %10.1f ms\n", "chargement : cache binaire (moyenne)", cacheMs);
+    std::printf("  %-36s %10.3f ms\n", "soumission / frame", submit);
+    std::printf("  %-36s %10.3f ms\n", "frame (glFinish)", frame);
+    std::printf("  %zu sous-maillage(s) par modele ; derniere frame : %d objets, %d draws, "
+                "%d glBindTexture, %d glBindVertexArray, %d couleurs, %d rejetes\n",
+                nSub, st.drawn, st.drawCalls, st.textureBinds, st.vaoBinds, st.colorUploads, st.culled);
+
+    scene.destroy();
+    glDeleteProgram(prog);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
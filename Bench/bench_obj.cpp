@@ -0,0 +1,304 @@
+// Bench/bench_obj.cpp
+// Débit du chargement OBJ : ancien parseur (getline + istringstream + stoi + unordered_map)
+// vs parseur projeté en mémoire (from_chars, blocs parallèles, VKeyMap),
+// puis démarrage à froid (parse + écriture du cache binaire) vs à chaud (cache projeté).
+// CPU seulement : aucun contexte OpenGL n'est créé.
+//
+// Compteurs matériels (perf_event_open, si disponibles) des deux parseurs sur un thread.
+//
+// Usage : ./bench_obj [--obj fichier.obj] [--runs 5] [--threads 0] [--synth 1500]
+//   --synth N : sans --obj, génère une grille N x N (quads, indices "v/vt/vn") dans bench_obj_synth.obj
+//   Le cache "<obj>.meshcache" est réécrit par le bench.
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "FileIO/mapped_file.hpp"
+#include "ObjLoader/obj_loader.hpp"
+#include "MeshCache/mesh_cache.hpp"
+#include "Profiler/perf_counters.hpp"
+#include "SceneObjects.hpp"
+
+namespace legacy {
+
+// Copie du chargeur d'origine (référence de débit et de résultat)
+struct VKey {
+    int vi, ti, ni;
+    bool operator==(const VKey& o) const { return vi == o.vi && ti == o.ti && ni == o.ni; }
+};
+
+struct VKeyHash {
+    size_t operator()(const VKey& k) const noexcept {
+        return (size_t)(k.vi * 73856093) ^ (size_t)(k.ti * 19349663) ^ (size_t)(k.ni * 83492791);
+    }
+};
+
+static bool parseTriplet(const std::string& token, int& vi, int& ti, int& ni) {
+    vi = ti = ni = 0;
+    int slashCount = 0;
+    for (char c : token) if (c == '/') slashCount++;
+
+    if (slashCount == 0) {
+        vi = std::stoi(token);
+        return true;
+    }
+
+    if (slashCount == 1) {
+        size_t p = token.find('/');
+        auto s0 = token.substr(0, p);
+        auto s1 = token.substr(p + 1);
+        vi = s0.empty() ? 0 : std::stoi(s0);
+        ti = s1.empty() ? 0 : std::stoi(s1);
+        return true;
+    }
+
+    size_t p1 = token.find('/');
+    size_t p2 = token.find('/', p1 + 1);
+    auto s0 = token.substr(0, p1);
+    auto s1 = token.substr(p1 + 1, p2 - (p1 + 1));
+    auto s2 = token.substr(p2 + 1);
+    vi = s0.empty() ? 0 : std::stoi(s0);
+    if (!s1.empty()) ti = std::stoi(s1);
+    if (!s2.empty()) ni = std::stoi(s2);
+    return true;
+}
+
+static int fixIndex(int idx, int n) {
+    if (idx > 0) return idx - 1;
+    if (idx < 0) return n + idx;
+    return -1;
+}
+
+static bool loadOBJData(const std::string& path, MeshData& out) {
+    std::ifstream f(path);
+    if (!f.is_open()) return false;
+
+    std::vector<glm::vec3> V;
+    V.reserve(10000);
+    out.pos.clear();
+    out.pos.reserve(30000);
+    out.idx.clear();
+    out.idx.reserve(60000);
+
+    std::unordered_map<VKey, uint32_t, VKeyHash> dedup;
+    dedup.reserve(60000);
+
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream iss(line);
+        std::string tag;
+        iss >> tag;
+
+        if (tag == "v") {
+            glm::vec3 p;
+            iss >> p.x >> p.y >> p.z;
+            V.push_back(p);
+        }
+        else if (tag == "f") {
+            std::vector<VKey> face;
+            std::string tok;
+            while (iss >> tok) {
+                int vi, ti, ni;
+                if (!parseTriplet(tok, vi, ti, ni)) continue;
+
+                VKey k;
+                k.vi = fixIndex(vi, (int)V.size());
+                k.ti = (ti == 0) ? -1 : 0;
+                k.ni = (ni == 0) ? -1 : 0;
+
+                if (k.vi < 0 || k.vi >= (int)V.size()) continue;
+                face.push_back(k);
+            }
+
+            if (face.size() < 3) continue;
+
+            auto getOrCreate = [&](const VKey& k) -> uint32_t {
+                auto it = dedup.find(k);
+                if (it != dedup.end()) return it->second;
+
+                const glm::vec3& p = V[k.vi];
+                uint32_t id = (uint32_t)(out.pos.size() / 3);
+                out.pos.push_back(p.x);
+                out.pos.push_back(p.y);
+                out.pos.push_back(p.z);
+
+                dedup.emplace(k, id);
+                return id;
+            };
+
+            uint32_t i0 = getOrCreate(face[0]);
+            for (size_t i = 1; i + 1 < face.size(); ++i) {
+                uint32_t i1 = getOrCreate(face[i]);
+                uint32_t i2 = getOrCreate(face[i + 1]);
+                out.idx.push_back(i0);
+                out.idx.push_back(i1);
+                out.idx.push_back(i2);
+            }
+        }
+    }
+    return !out.idx.empty() && !out.pos.empty();
+}
+
+} // namespace legacy
+
+// Grille N x N de quads avec uv et normales (format des exports Meshy)
+static bool writeSynthetic(const std::string& path, int n)
+{
+    return writeSyntheticGridOBJ(path, n, n, OBJ_UV | OBJ_NORMALS | OBJ_QUADS, [n](float u, float v, float* p, float*) {
+        const int x = (int)std::lround(u * n), y = (int)std::lround(v * n);
+        p[0] = u;
+        p[1] = v;
+        p[2] = 0.01f * ((x * 7 + y * 13) % 17);
+    });
+}
+
+struct Result { double bestMs, avgMs; size_t verts, tris; };
+
+template <class LoadFn>
+static Result run(int runs, LoadFn load, MeshData& mesh, PerfStages* perf = nullptr, int stage = -1)
+{
+    Result r{1e30, 0.0, 0, 0};
+    for (int i = 0; i < runs; ++i) {
+        BenchClock clk;
+        if (perf) perf->begin(stage);
+        const bool ok = load(mesh);
+        if (perf) perf->end(stage);
+        if (!ok) { std::fprintf(stderr, "chargement echoue\n"); return r; }
+        const double ms = clk.ms();
+        r.bestMs = std::min(r.bestMs, ms);
+        r.avgMs += ms / runs;
+    }
+    r.verts = mesh.pos.size() / 3;
+    r.tris = mesh.idx.size() / 3;
+    return r;
+}
+
+// Démarrage "à chaud" : clé source + projection du cache + lecture de toutes les pages
+// (ce que glBufferData ferait), sans parse
+static double warmStartMs(const std::string& objPath, uint64_t& checksum)
+{
+    BenchClock clk;
+    MeshCacheKey key;
+    MeshCacheView view;
+    if (!MeshCacheKey::fromFile(objPath, key) || !view.open(meshCachePath(objPath), key)) return -1.0;
+    uint64_t sum = 0;
+    const uint32_t* w = (const uint32_t*)view.vertices();
+    for (size_t i = 0; i < view.vertexCount() * (sizeof(ObjVertex) / 4); ++i) sum += w[i];
+    for (size_t i = 0; i < view.indexCount(); ++i) sum += view.indices()[i];
+    checksum = sum;
+    return clk.ms();
+}
+
+// Positions des triangles dé-indexés : compare deux maillages indépendamment de la
+// déduplication (l'ancien chargeur dédupliquait sur (v, vt, vn), parseOBJ sur v seul)
+static std::vector<float> triangleSoup(const MeshData& m)
+{
+    std::vector<float> out;
+    out.reserve(m.idx.size() * 3);
+    for (uint32_t i : m.idx) out.insert(out.end(), m.pos.begin() + 3 * i, m.pos.begin() + 3 * i + 3);
+    return out;
+}
+
+static void printRow(const char* name, const Result& r, double mb)
+{
+    std::printf("  %-30s %10.1f %10.1f %10.1f %10zu %10zu\n",
+                name, r.bestMs, r.avgMs, mb / (r.bestMs / 1000.0), r.verts, r.tris);
+}
+
+int main(int argc, char** argv)
+{
+    const int runs    = argInt(argc, argv, "--runs", 5);
+    const int threads = argInt(argc, argv, "--threads", 0);
+    std::string path  = argStr(argc, argv, "--obj", "");
+
+    if (path.empty()) {
+        path = "bench_obj_synth.obj";
+        if (!writeSynthetic(path, argInt(argc, argv, "--synth", 1500))) {
+            std::fprintf(stderr, "ecriture impossible : %s\n", path.c_str());
+            return 1;
+        }
+    }
+
+    MappedFile probe;
+    if (!probe.open(path)) { std::fprintf(stderr, "ouverture impossible : %s\n", path.c_str()); return 1; }
+    const double mb = probe.size() / (1024.0 * 1024.0);
+    probe.close();
+
+    // Compteurs du thread courant : le parseur multi-thread n'est pas mesuré
+    PerfStages perf;
+    const int psLegacy = perf.add("getline + istringstream");
+    const int psMmap1  = perf.add("mmap + from_chars, 1 thread");
+    perf.open();
+
+    MeshData ref, fast1, fastN;
+    Result rLegacy = run(runs, [&](MeshData& m) { return legacy::loadOBJData(path, m); }, ref, &perf, psLegacy);
+    Result rMmap1  = run(runs, [&](MeshData& m) {
+        MappedFile f;
+        return f.open(path) && parseOBJ(f.data(), f.size(), m, 1);
+    }, fast1, &perf, psMmap1);
+    Result rMmapN  = run(runs, [&](MeshData& m) {
+        MappedFile f;
+        return f.open(path) && parseOBJ(f.data(), f.size(), m, threads);
+    }, fastN);
+
+    const std::vector<float> refSoup = triangleSoup(ref);
+    const bool same = fast1.pos == fastN.pos && fast1.idx == fastN.idx && triangleSoup(fast1) == refSoup;
+    const unsigned nThreads = threads > 0 ? (unsigned)threads : std::thread::hardware_concurrency();
+
+    std::printf("bench_obj : %s (%.1f Mo), %d passes\n", path.c_str(), mb, runs);
+    std::printf("  %-30s %10s %10s %10s %10s %10s\n", "", "min ms", "moy ms", "Mo/s", "sommets", "triangles");
+    printRow("getline + istringstream", rLegacy, mb);
+    printRow("mmap + from_chars, 1 thread", rMmap1, mb);
+    char label[64];
+    std::snprintf(label, sizeof(label), "mmap + from_chars, %u threads", nThreads);
+    printRow(label, rMmapN, mb);
+    std::printf("  triangles identiques a l'ancien chargeur : %s\n", same ? "oui" : "NON");
+    std::fflush(stdout);
+    perf.report(std::cout, "perf bench_obj");
+
+    // ----- Démarrage : cache binaire -----
+    const std::string cachePath = meshCachePath(path);
+    std::error_code ec;
+    std::filesystem::remove(cachePath, ec);
+
+    BenchClock cold;
+    MeshCacheKey key;
+    ObjModel parsed;
+    MappedFile src;
+    bool cacheOk = MeshCacheKey::fromFile(path, key) && src.open(path) && parseOBJModel(src.data(), src.size(), parsed, threads);
+    src.close();
+    const double parseMs = cold.ms();
+    cacheOk = cacheOk && writeMeshCache(cachePath, key, parsed,
+                                        computeBounds(parsed.vertices[0].pos, parsed.vertices.size(),
+                                                      sizeof(ObjVertex) / sizeof(float)));
+    const double coldMs = cold.ms();
+    if (!cacheOk) { std::fprintf(stderr, "ecriture du cache impossible : %s\n", cachePath.c_str()); return 1; }
+
+    uint64_t sum = 0;
+    double hotMs = 1e30;
+    for (int i = 0; i < runs; ++i) hotMs = std::min(hotMs, warmStartMs(path, sum));
+    const bool evicted = evictFromPageCache(cachePath) && evictFromPageCache(path);
+    const double diskMs = warmStartMs(path, sum);
+
+    std::printf("\n  demarrage (cache %s, %.1f Mo)\n", cachePath.c_str(),
+                std::filesystem::file_size(cachePath, ec) / (1024.0 * 1024.0));
+    std::printf("  %-44s %10.1f ms\n", "froid : parse OBJ (normales, uv, materiaux)", parseMs);
+    std::printf("  %-44s %10.1f ms\n", "froid : parse OBJ + ecriture du cache", coldMs);
+    std::printf("  %-44s %10.1f ms\n", "chaud : cache projete (pages en memoire)", hotMs);
+    if (evicted) std::printf("  %-44s %10.1f ms\n", "chaud : cache projete (pages lues du disque)", diskMs);
+    std::printf("  (checksum %llu)\n", (unsigned long long)sum);
+    return same ? 0 : 2;
+}
@@ -0,0 +1,140 @@
+// Bench/bench_pack.cpp
+// Démarrage à froid : assets lus depuis l'archive (assets.pack, un mmap) vs fichiers séparés
+// (pour chaque cache : clé de la source puis projection du cache ; .mtl et calibration
+// ouverts un par un). Chaque asset est ensuite lu en entier, comme le ferait l'upload GL.
+// "Froid" : pages des fichiers retirées du cache disque (posix_fadvise DONTNEED) avant la
+// passe ; "chaud" : passe suivante, pages en mémoire. Sans contexte GL.
+//
+// Usage : ./bench_pack [--pack assets.pack] [--runs 5]
+//   L'archive est construite au préalable par build_assetpack ; les fichiers séparés
+//   correspondants (sources et caches) doivent être présents pour la comparaison.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "AssetPack/asset_pack.hpp"
+#include "Bench/bench_common.hpp"
+#include "MeshCache/mesh_cache.hpp"
+#include "TextureCache/texture_cache.hpp"
+
+/**
+ * @struct Job
+ * @brief Un asset du pack et sa forme "fichiers séparés".
+ */
+struct Job {
+    std::string name;   ///< Entrée du pack (= cache ou fichier sur disque).
+    std::string source; ///< Source d'un cache (clé vérifiée en mode fichiers séparés).
+    enum Kind { Mesh, Texture, Raw } kind = Raw;
+    TexCacheFormat format = TexCacheFormat::RGBA8;
+};
+
+static bool endsWith(const std::string& s, const std::string& suffix)
+{
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static Job makeJob(const std::string& name)
+{
+    Job j;
+    j.name = name;
+    auto strip = [&](const char* suffix) { j.source = name.substr(0, name.size() - std::strlen(suffix)); };
+    if (endsWith(name, ".meshcache")) { j.kind = Job::Mesh; strip(".meshcache"); }
+    else if (endsWith(name, ".bc1.texcache")) { j.kind = Job::Texture; j.format = TexCacheFormat::BC1; strip(".bc1.texcache"); }
+    else if (endsWith(name, ".rgba8.texcache")) { j.kind = Job::Texture; strip(".rgba8.texcache"); }
+    return j;
+}
+
+/// @brief Lit un octet par page (fautes de page comprises), comme une copie vers le GPU.
+static unsigned touch(const char* p, std::size_t n)
+{
+    unsigned sum = 0;
+    for (std::size_t i = 0; i < n; i += 4096) sum += (unsigned char)p[i];
+    if (n) sum += (unsigned char)p[n - 1];
+    return sum;
+}
+
+/// @brief Charge tous les assets via assetFS() (archive montée ou non) ; false si un échoue.
+static bool loadAll(const std::vector<Job>& jobs, unsigned& sink)
+{
+    for (const Job& j : jobs) {
+        if (j.kind == Job::Mesh) {
+            MeshCacheView v;
+            AssetSpan packed;
+            MeshCacheKey key;
+            const bool ok = assetFS().find(j.name, packed)
+                          ? v.open(packed.data, packed.size)
+                          : MeshCacheKey::fromFile(j.source, key) && v.open(j.name, key);
+            if (!ok) return false;
+            sink += touch((const char*)v.vertices(), v.vertexCount() * sizeof(ObjVertex));
+            sink += touch((const char*)v.indices(), v.indexCount() * sizeof(uint32_t));
+        } else if (j.kind == Job::Texture) {
+            TextureCacheView v;
+            if (!openTextureCache(j.source, j.format, true, v)) return false;
+            for (uint32_t l = 0; l < v.levelCount(); ++l) sink += touch(v.levelData(l), (std::size_t)v.level(l).size);
+        } else {
+            AssetFile f;
+            if (!assetFS().open(j.name, f)) return false;
+            sink += touch(f.data(), f.size());
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    const std::string packPath = argStr(argc, argv, "--pack", "assets.pack");
+    const int runs = std::max(1, argInt(argc, argv, "--runs", 5));
+
+    AssetPack pack;
+    if (!pack.open(packPath)) {
+        std::fprintf(stderr, "archive illisible : %s (construire avec build_assetpack)\n", packPath.c_str());
+        return 1;
+    }
+    std::vector<Job> jobs;
+    std::vector<std::string> looseFiles;
+    for (std::size_t i = 0; i < pack.entryCount(); ++i) {
+        jobs.push_back(makeJob(pack.entryName(i)));
+        looseFiles.push_back(jobs.back().name);
+        if (!jobs.back().source.empty()) looseFiles.push_back(jobs.back().source);
+    }
+    pack.close();
+
+    bool evictOk = evictFromPageCache(packPath);
+    for (const std::string& f : looseFiles) evictOk = evictFromPageCache(f) && evictOk;
+    std::printf("bench_pack : %zu asset(s), %s (%.1f Ko), %d passe(s)%s\n", jobs.size(), packPath.c_str(),
+                std::filesystem::file_size(packPath) / 1024.0, runs,
+                evictOk ? "" : " ! eviction du cache disque incomplete : le froid est sous-estime");
+
+    unsigned sink = 0;
+    std::vector<double> cold[2], warm[2];
+    for (int r = 0; r < runs; ++r) {
+        for (int usePack = 0; usePack < 2; ++usePack) {
+            if (usePack) evictFromPageCache(packPath);
+            else for (const std::string& f : looseFiles) evictFromPageCache(f);
+
+            for (int pass = 0; pass < 2; ++pass) {
+                BenchClock clk;
+                if (usePack && !assetFS().mount(packPath)) return 1;
+                const bool ok = loadAll(jobs, sink);
+                assetFS().unmount();
+                const double ms = clk.ms();
+                if (!ok) {
+                    std::fprintf(stderr, "chargement %s incomplet (fichiers separes absents ?)\n",
+                                 usePack ? "archive" : "fichiers separes");
+                    return 1;
+                }
+                (pass ? warm : cold)[usePack].push_back(ms);
+            }
+        }
+    }
+
+    std::printf("  %-20s %12s %12s\n", "", "froid (ms)", "chaud (ms)");
+    std::printf("  %-20s %12.2f %12.2f\n", "fichiers separes", median(cold[0]), median(warm[0]));
+    std::printf("  %-20s %12.2f %12.2f\n", "archive (mmap)", median(cold[1]), median(warm[1]));
+    std::printf("  (medianes ; controle %u)\n", sink);
+    return 0;
+}
@@ -0,0 +1,314 @@
+// Bench/bench_pipeline.cpp
+// Pipeline de vision et de physique d'arcube de bout en bout, sans affichage ni contexte GL :
+// capture (décodage) -> cvtColor -> detectMarkers -> interpolateCornersCharuco ->
+// estimatePoseCharucoBoard -> PoseSmoother::smooth -> Ball::update.
+// Latences par étape et par frame (moyenne, p50 / p90 / p99, max, histogramme), débit en
+// images / s, précision de pose (brute et lissée) contre une référence, rapport JSON pour
+// comparer deux commits.
+//
+// Sources : un enregistrement (--video, --images : voir Capture/capture_source.hpp, rejoué au
+// plus vite) avec --calib ; sans source, une session synthétique dont la pose est connue.
+// Référence de pose : --reference CSV (format de arcube --save-poses, apparié par horodatage),
+// ou la pose exacte de la session synthétique.
+//
+// Usage : ./bench_pipeline [--video clip.mp4 | --images DOSSIER] [--calib camera.yaml]
+//                          [--frames 600] [--warmup 30] [--reference poses.csv]
+//                          [--json bench_pipeline.json] [--label $(git rev-parse --short HEAD)]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "Bench/bench_session.hpp"
+#include "Capture/pose_source.hpp"
+#include "Smoothing/smoothing.hpp"
+#include "Ball.hpp"
+
+/// @brief Échantillons d'une étape (µs), tous conservés : percentiles exacts.
+struct StageStats {
+    std::string name;
+    std::vector<double> us;
+};
+
+/// @brief Percentile p (0..1) d'un échantillon trié, au rang le plus proche.
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5))];
+}
+
+/// @brief Bornes supérieures de l'histogramme (µs), suite 1-2-5 ; dernière case : au-delà.
+static const double kBounds[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000 };
+static const int kBucketCount = sizeof(kBounds) / sizeof(kBounds[0]) + 1;
+
+struct Summary {
+    double mean = 0, p50 = 0, p90 = 0, p99 = 0, max = 0;
+    int buckets[kBucketCount] = {};
+};
+
+static Summary summarize(const StageStats& s)
+{
+    Summary r;
+    if (s.us.empty()) return r;
+    std::vector<double> v(s.us);
+    std::sort(v.begin(), v.end());
+    double sum = 0;
+    for (double x : v) {
+        sum += x;
+        int b = 0;
+        while (b < kBucketCount - 1 && x > kBounds[b]) ++b;
+        ++r.buckets[b];
+    }
+    r.mean = sum / v.size();
+    r.p50 = percentile(v, 0.50);
+    r.p90 = percentile(v, 0.90);
+    r.p99 = percentile(v, 0.99);
+    r.max = v.back();
+    return r;
+}
+
+/// @brief Erreurs de pose : rotation (degrés) et translation (mm).
+struct PoseErrors {
+    std::vector<double> deg, mm;
+
+    void add(const cv::Mat& r, const cv::Mat& t, const cv::Mat& rRef, const cv::Mat& tRef)
+    {
+        cv::Mat R, Rr;
+        cv::Rodrigues(r, R);
+        cv::Rodrigues(rRef, Rr);
+        const cv::Mat d = R * Rr.t();
+        const double c = std::max(-1.0, std::min(1.0, (d.at<double>(0, 0) + d.at<double>(1, 1) + d.at<double>(2, 2) - 1.0) * 0.5));
+        deg.push_back(std::acos(c) * 180.0 / 3.14159265358979323846);
+        mm.push_back(cv::norm(t, tRef) * 1000.0);
+    }
+};
+
+static void jsonString(FILE* f, const std::string& s)
+{
+    std::fputc('"', f);
+    for (char c : s) {
+        if (c == '"' || c == '\\') std::fputc('\\', f);
+        if ((unsigned char)c >= 0x20) std::fputc(c, f);
+    }
+    std::fputc('"', f);
+}
+
+static void jsonErrors(FILE* f, const char* key, const std::vector<double>& v)
+{
+    StageStats s{ key, v };
+    const Summary r = summarize(s);
+    std::fprintf(f, "\"%s\": {\"n\": %zu, \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+                 key, v.size(), r.mean, r.p50, r.p90, r.p99, r.max);
+}
+
+int main(int argc, char** argv)
+{
+    CaptureOptions capture;
+    bool hasSource = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        std::string err;
+        if (parseCaptureArg(argc, argv, i, capture, err)) {
+            if (!err.empty()) { std::fprintf(stderr, "%s\n", err.c_str()); return 2; }
+            hasSource |= arg != "--pace" && arg != "--fps";
+        }
+    }
+    const std::string calib     = argStr(argc, argv, "--calib", "camera.yaml");
+    const std::string reference = argStr(argc, argv, "--reference", "");
+    const std::string json      = argStr(argc, argv, "--json", "bench_pipeline.json");
+    const std::string label     = argStr(argc, argv, "--label", "");
+    const int frames = argInt(argc, argv, "--frames", 600);
+    const int warmup = argInt(argc, argv, "--warmup", 30);
+
+    BenchBoard b;
+    BenchSession session;
+    if (!(hasSource ? session.openCapture(capture, calib) : session.openSynthetic(b, frames + warmup))) return 2;
+
+    std::vector<PoseSample> refPoses;
+    if (!reference.empty() && !loadPoseCsv(reference, refPoses)) {
+        std::fprintf(stderr, "reference illisible : %s\n", reference.c_str());
+        return 2;
+    }
+    std::printf("session : %s\n", session.describe().c_str());
+
+    enum { CAPTURE, GRAY, DETECT, CORNERS, POSE, SMOOTH, PHYSICS, TOTAL, STAGE_COUNT };
+    static const char* const stageNames[STAGE_COUNT] = { "capture", "cvtColor", "detectMarkers",
+                                                         "interpolateCornersCharuco", "estimatePoseCharucoBoard",
+                                                         "PoseSmoother::smooth", "Ball::update", "total" };
+    StageStats stages[STAGE_COUNT];
+    for (int s = 0; s < STAGE_COUNT; ++s) stages[s].name = stageNames[s];
+
+    // Mêmes objets que la boucle d'arcube ; balle sans maillage (pas de contexte GL)
+    Maze maze(8, 6, 0.297f, 0.210f, 0.0035f);
+    maze.generate();
+    Ball ball(0.010f, false);
+    ball.reset(maze);
+    PoseSmoother poseSmooth;
+    poseSmooth.alphaPose = 0.25;
+
+    cv::Mat frame, gray, rvec, tvec, rRef, tRef;
+    std::vector<int> markerIds;
+    std::vector<std::vector<cv::Point2f>> markerCorners;
+    cv::Mat charucoCorners, charucoIds;
+    PoseErrors raw, smoothed;
+    int measured = 0, detected = 0, withRef = 0;
+    double lastTs = 0.0, wallMs = 0.0;
+
+    using Clock = std::chrono::steady_clock;
+    auto us = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::micro>(b - a).count(); };
+
+    for (int i = 0; i < frames + warmup; ++i) {
+        // Durée de chaque étape de la frame (µs) ; < 0 : étape non exécutée
+        double t[TOTAL];
+        std::fill(t, t + TOTAL, -1.0);
+        Clock::time_point a = Clock::now(), z;
+
+        if (!session.next(frame)) break;
+        z = Clock::now(); t[CAPTURE] = us(a, z); a = z;
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        z = Clock::now(); t[GRAY] = us(a, z); a = z;
+        cv::aruco::detectMarkers(gray, b.dict, markerCorners, markerIds, b.params);
+        z = Clock::now(); t[DETECT] = us(a, z); a = z;
+
+        bool poseOk = false;
+        if (!markerIds.empty()) {
+            cv::aruco::interpolateCornersCharuco(markerCorners, markerIds, gray, b.board, charucoCorners, charucoIds,
+                                                 session.K, session.D);
+            z = Clock::now(); t[CORNERS] = us(a, z); a = z;
+            if (charucoIds.total() >= 6) {
+                poseOk = cv::aruco::estimatePoseCharucoBoard(charucoCorners, charucoIds, b.board, session.K,
+                                                             session.D, rvec, tvec);
+                z = Clock::now(); t[POSE] = us(a, z);
+            }
+        }
+
+        // Référence de la frame : session synthétique, ou CSV à l'horodatage près (1 ms)
+        const double ts = session.timestampMs();
+        bool hasRef = false;
+        if (session.hasTruth) {
+            rRef = session.truthR;
+            tRef = session.truthT;
+            hasRef = true;
+        } else if (!refPoses.empty()) {
+            auto it = std::lower_bound(refPoses.begin(), refPoses.end(), ts - 1.0,
+                                       [](const PoseSample& p, double v) { return p.tMs < v; });
+            if (it != refPoses.end() && std::fabs(it->tMs - ts) <= 1.0) {
+                rRef = (cv::Mat_<double>(3, 1) << it->r[0], it->r[1], it->r[2]);
+                tRef = (cv::Mat_<double>(3, 1) << it->t[0], it->t[1], it->t[2]);
+                hasRef = true;
+            }
+        }
+        const bool keep = i >= warmup;
+
+        // Le calcul des erreurs reste hors des mesures
+        if (poseOk) {
+            if (rvec.type() != CV_64F) rvec.convertTo(rvec, CV_64F);
+            if (tvec.type() != CV_64F) tvec.convertTo(tvec, CV_64F);
+            if (keep && hasRef) raw.add(rvec, tvec, rRef, tRef);
+            a = Clock::now();
+            poseSmooth.smooth(rvec, tvec);
+            t[SMOOTH] = us(a, Clock::now());
+            if (keep && hasRef) smoothed.add(rvec, tvec, rRef, tRef);
+        }
+
+        // Physique avec la dernière pose connue, au pas des horodatages de la source
+        if (!rvec.empty()) {
+            const float dt = std::max(1.0f / 500.0f, std::min(1.0f / 20.0f, (float)((ts - lastTs) * 0.001)));
+            a = Clock::now();
+            ball.update(dt, rvec, maze);
+            t[PHYSICS] = us(a, Clock::now());
+        }
+        lastTs = ts;
+
+        if (!keep) continue;
+        double total = 0.0;
+        for (int s = 0; s < TOTAL; ++s) {
+            if (t[s] < 0.0) continue;
+            stages[s].us.push_back(t[s]);
+            total += t[s];
+        }
+        stages[TOTAL].us.push_back(total);
+        wallMs += total * 1e-3;
+        ++measured;
+        detected += poseOk ? 1 : 0;
+        withRef += hasRef ? 1 : 0;
+    }
+
+    if (measured == 0) {
+        std::fprintf(stderr, "session trop courte (%d frames de chauffe)\n", warmup);
+        return 2;
+    }
+    const double fps = wallMs > 0.0 ? measured * 1000.0 / wallMs : 0.0;
+
+    std::printf("%d frames mesurees, pose sur %d (%.1f %%), %.1f images / s\n\n", measured, detected,
+                100.0 * detected / measured, fps);
+    std::printf("  %-28s %7s %10s %10s %10s %10s %10s\n", "etape (us)", "n", "moyenne", "p50", "p90", "p99", "max");
+    Summary sums[STAGE_COUNT];
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        sums[s] = summarize(stages[s]);
+        std::printf("  %-28s %7zu %10.1f %10.1f %10.1f %10.1f %10.1f\n", stages[s].name.c_str(), stages[s].us.size(),
+                    sums[s].mean, sums[s].p50, sums[s].p90, sums[s].p99, sums[s].max);
+    }
+    std::printf("\n  histogramme du total :\n");
+    for (int k = 0; k < kBucketCount; ++k) {
+        const int n = sums[TOTAL].buckets[k];
+        if (n == 0) continue;
+        char range[32];
+        if (k < kBucketCount - 1) std::snprintf(range, sizeof(range), "<= %.0f us", kBounds[k]);
+        else std::snprintf(range, sizeof(range), "> %.0f us", kBounds[k - 1]);
+        std::printf("  %14s %6d %s\n", range, n, std::string((size_t)(50.0 * n / measured + 0.5), '#').c_str());
+    }
+    if (!raw.deg.empty()) {
+        const Summary rd = summarize(StageStats{ "", raw.deg }), rm = summarize(StageStats{ "", raw.mm });
+        const Summary sd = summarize(StageStats{ "", smoothed.deg }), sm = summarize(StageStats{ "", smoothed.mm });
+        std::printf("\n  precision (%d frames avec reference) :\n", withRef);
+        std::printf("    brute   : rotation %.3f deg (p90 %.3f), translation %.2f mm (p90 %.2f)\n", rd.mean, rd.p90, rm.mean, rm.p90);
+        std::printf("    lissee  : rotation %.3f deg (p90 %.3f), translation %.2f mm (p90 %.2f)\n", sd.mean, sd.p90, sm.mean, sm.p90);
+    } else if (!reference.empty()) {
+        std::printf("\n  aucune frame appariee a la reference (horodatages a 1 ms pres)\n");
+    }
+
+    FILE* f = std::fopen(json.c_str(), "w");
+    if (!f) {
+        std::fprintf(stderr, "ecriture impossible : %s\n", json.c_str());
+        return 1;
+    }
+    std::fputs("{\n  \"label\": ", f);
+    jsonString(f, label);
+    std::fputs(",\n  \"source\": ", f);
+    jsonString(f, session.describe());
+    std::fprintf(f, ",\n  \"frames\": %d,\n  \"warmup\": %d,\n  \"detected\": %d,\n  \"fps\": %.3f,\n", measured, warmup,
+                 detected, fps);
+    std::fputs("  \"histogram_bounds_us\": [", f);
+    for (int k = 0; k < kBucketCount - 1; ++k) std::fprintf(f, "%s%.0f", k ? ", " : "", kBounds[k]);
+    std::fputs("],\n  \"stages\": [\n", f);
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        const Summary& r = sums[s];
+        std::fputs("    {\"name\": ", f);
+        jsonString(f, stages[s].name);
+        std::fprintf(f, ", \"n\": %zu, \"mean_us\": %.3f, \"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f, \"histogram\": [",
+                     stages[s].us.size(), r.mean, r.p50, r.p90, r.p99, r.max);
+        for (int k = 0; k < kBucketCount; ++k) std::fprintf(f, "%s%d", k ? ", " : "", r.buckets[k]);
+        std::fprintf(f, "]}%s\n", s + 1 < STAGE_COUNT ? "," : "");
+    }
+    std::fputs("  ],\n  \"accuracy\": ", f);
+    if (raw.deg.empty()) {
+        std::fputs("null\n}\n", f);
+    } else {
+        std::fprintf(f, "{\n    \"frames_with_reference\": %d,\n    ", withRef);
+        jsonErrors(f, "raw_rotation_deg", raw.deg);
+        std::fputs(",\n    ", f);
+        jsonErrors(f, "raw_translation_mm", raw.mm);
+        std::fputs(",\n    ", f);
+        jsonErrors(f, "smoothed_rotation_deg", smoothed.deg);
+        std::fputs(",\n    ", f);
+        jsonErrors(f, "smoothed_translation_mm", smoothed.mm);
+        std::fputs("\n  }\n}\n", f);
+    }
+    std::fclose(f);
+    std::printf("\n%s ecrit\n", json.c_str());
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Bench/bench_profiler.cpp
+// Coût du traceur de zones (Profiler/) : ns par zone (un thread, puis N threads en
+// parallèle), surcoût sur une frame synthétique découpée comme celle d'arcube (une dizaine
+// de zones autour de calculs de quelques centaines de µs), temps d'écriture de la trace.
+// Sans contexte GL.
+// Utilise prof::Zone directement : le résultat ne dépend pas de l'option ARCUBE_PROFILER.
+//
+// Usage : ./bench_profiler [--zones 1000000] [--frames 200] [--threads 4] [--out bench_trace.json]
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "Profiler/profiler.hpp"
+
+/// @brief Calcul factice proportionnel à `us` (résultat consommé par l'appelant).
+static double work(int us)
+{
+    double acc = 0.0;
+    for (int i = 0; i < us * 150; ++i) acc += std::sqrt((double)i);
+    return acc;
+}
+
+/// @brief Frame synthétique : étapes du pipeline (capture, détection, pose, physique, rendu).
+static double frame(bool zones)
+{
+    static const char* const stages[] = { "video.read", "cvtColor", "detectMarkers", "interpolateCornersCharuco",
+                                          "estimatePoseCharucoBoard", "PoseSmoother::smooth", "assets.pump",
+                                          "render.background", "render.scene", "Ball::update",
+                                          "glfwSwapBuffers", "glfwPollEvents" };
+    double acc = 0.0;
+    if (zones) {
+        prof::Zone f("frame");
+        for (const char* s : stages) { prof::Zone z(s); acc += work(1000); }
+    } else {
+        for (size_t i = 0; i < sizeof(stages) / sizeof(stages[0]); ++i) acc += work(1000);
+    }
+    return acc;
+}
+
+int main(int argc, char** argv)
+{
+    const int zones   = argInt(argc, argv, "--zones", 1000000);
+    const int frames  = argInt(argc, argv, "--frames", 200);
+    const int threads = argInt(argc, argv, "--threads", 4);
+    const std::string out = argStr(argc, argv, "--out", "bench_trace.json");
+    prof::setThreadName("bench.main");
+
+    // 1) Zone vide, un thread
+    BenchClock t1;
+    for (int i = 0; i < zones; ++i) { prof::Zone z("empty"); }
+    const double nsPerZone = t1.ms() * 1e6 / zones;
+
+    // 2) Zones vides sur plusieurs threads (tampons indépendants : pas de contention attendue)
+    BenchClock tn;
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([zones, threads] {
+            prof::setThreadName("bench.worker");
+            for (int i = 0; i < zones / threads; ++i) { prof::Zone z("empty"); }
+        });
+    for (std::thread& th : pool) th.join();
+    const double nsPerZoneMt = tn.ms() * 1e6 / ((double)(zones / threads) * threads) * threads;
+
+    // 3) Frames synthétiques, sans puis avec zones (alternées pour lisser la fréquence CPU)
+    double sink = 0.0, msOff = 0.0, msOn = 0.0;
+    for (int i = 0; i < frames; ++i) {
+        BenchClock a;
+        sink += frame(false);
+        msOff += a.ms();
+        BenchClock b;
+        sink += frame(true);
+        msOn += b.ms();
+    }
+    msOff /= frames;
+    msOn /= frames;
+
+    // 4) Écriture de la trace
+    BenchClock tw;
+    const bool written = prof::writeTrace(out);
+    const double writeMs = tw.ms();
+
+    std::printf("bench_profiler : %d zones, %d threads, %d frames (sink %.0f)\n", zones, threads, frames, sink);
+    std::printf("  zone vide, 1 thread         : %8.1f ns\n", nsPerZone);
+    std::printf("  zone vide, %d threads        : %8.1f ns (par thread)\n", threads, nsPerZoneMt);
+    std::printf("  frame synthetique sans zones : %8.3f ms\n", msOff);
+    std::printf("  frame synthetique avec zones : %8.3f ms (%+.3f %%, 13 zones)\n", msOn,
+                100.0 * (msOn - msOff) / msOff);
+    std::printf("  trace %s : %s, %llu evenements (%llu perdus) en %.1f ms\n", out.c_str(),
+                written ? "ecrite" : "ECHEC", (unsigned long long)prof::eventCount(),
+                (unsigned long long)prof::droppedCount(), writeMs);
+    return written ? 0 : 1;
+}
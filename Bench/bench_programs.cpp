@@ -0,0 +1,98 @@
+// Bench/bench_programs.cpp
+// Programmes GLSL au démarrage : compileShader / linkProgram un par un (chemin d'origine)
+// vs ProgramCache (program_cache.hpp) à froid (compilations groupées, binaires écrits) et à
+// chaud (glProgramBinary). Chaque mesure se fait dans un contexte neuf.
+//
+// Usage : ./bench_programs [--runs 5]
+//   Mesa garde aussi son propre cache disque de shaders : pour un "froid" réel, lancer avec
+//   MESA_SHADER_CACHE_DISABLE=true (sinon le chemin d'origine et le froid en profitent).
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "ProgramCache/program_cache.hpp"
+#include "Shaders/shaders.hpp"
+
+static const char* CACHE_DIR = "bench_programcache";
+
+/// @brief Les programmes de l'application (main.cpp) et de bench_scene.
+static const std::vector<std::pair<std::string, std::vector<ShaderStage>>>& programList()
+{
+    static const std::vector<std::pair<std::string, std::vector<ShaderStage>>> list = {
+        { "bg",    { { GL_VERTEX_SHADER, BG_VS }, { GL_FRAGMENT_SHADER, BG_FS } } },
+        { "line",  { { GL_VERTEX_SHADER, LINE_VS }, { GL_GEOMETRY_SHADER, LINE_GS }, { GL_FRAGMENT_SHADER, LINE_FS } } },
+        { "face",  { { GL_VERTEX_SHADER, FACE_VS }, { GL_FRAGMENT_SHADER, FACE_FS } } },
+        { "arena", { { GL_VERTEX_SHADER, ARENA_VS }, { GL_FRAGMENT_SHADER, ARENA_FS } } },
+        { "mesh",  { { GL_VERTEX_SHADER, MESH_VS }, { GL_FRAGMENT_SHADER, MESH_FS } } },
+    };
+    return list;
+}
+
+/// @brief Construit tous les programmes dans un contexte neuf ; durée en ms (< 0 si échec).
+static double buildAll(bool useCache, std::size_t* hits, bool* parallel)
+{
+    GLFWwindow* win = createHiddenContext(64, 64);
+    if (!win) return -1.0;
+    std::vector<GLuint> progs;
+    BenchClock clk;
+    if (!useCache) {
+        for (const auto& p : programList()) {
+            std::vector<GLuint> shaders;
+            for (const ShaderStage& s : p.second) shaders.push_back(compileShader(s.type, s.src));
+            progs.push_back(linkProgram(shaders));
+        }
+    } else {
+        ProgramCache cache(CACHE_DIR);
+        for (const auto& p : programList()) cache.add(p.first, p.second);
+        cache.finish();
+        for (std::size_t i = 0; i < cache.size(); ++i) progs.push_back(cache.program(i));
+        if (hits) *hits = cache.cacheHits();
+        if (parallel) *parallel = cache.parallelCompile();
+    }
+    const double ms = clk.ms();
+    for (GLuint p : progs) glDeleteProgram(p);
+    glfwDestroyWindow(win);
+    return ms;
+}
+
+int main(int argc, char** argv)
+{
+    const int runs = std::max(1, argInt(argc, argv, "--runs", 5));
+    {
+        GLFWwindow* win = createHiddenContext(64, 64);
+        if (!win) return 1;
+        GLint formats = 0;
+        if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        std::printf("bench_programs : %zu programmes, GL %s, %d format(s) binaire(s), cache Mesa %s\n",
+                    programList().size(), (const char*)glGetString(GL_RENDERER), formats,
+                    std::getenv("MESA_SHADER_CACHE_DISABLE") ? "desactive" : "actif");
+        glfwDestroyWindow(win);
+    }
+
+    std::vector<double> legacy, cold, warm;
+    std::size_t hits = 0;
+    bool parallel = false;
+    for (int r = 0; r < runs; ++r) {
+        legacy.push_back(buildAll(false, nullptr, nullptr));
+        std::error_code ec;
+        std::filesystem::remove_all(CACHE_DIR, ec);
+        cold.push_back(buildAll(true, nullptr, &parallel));
+        warm.push_back(buildAll(true, &hits, nullptr));
+    }
+
+    std::printf("  compilation parallele : %s, binaires relus a chaud : %zu / %zu\n",
+                parallel ? "oui" : "non", hits, programList().size());
+    std::printf("  %-34s %10.2f ms\n", "compileShader + linkProgram", median(legacy));
+    std::printf("  %-34s %10.2f ms\n", "ProgramCache froid (groupe)", median(cold));
+    std::printf("  %-34s %10.2f ms\n", "ProgramCache chaud (binaires)", median(warm));
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Bench/bench_resources.cpp
+// Cache de ressources partagées (resource_cache.hpp) : N copies d'un même modèle OBJ et de
+// la même sphère. Sans partage (un loadOBJMesh / createSphere par copie, comportement
+// d'origine) vs partagé (SceneObjects::addOBJ / resources().acquireSphere) : temps de
+// chargement et mémoire GPU (VBO + EBO lus sur le driver).
+//
+// Usage : ./bench_resources [--obj fichier.obj] [--copies 100]
+//   Sans --obj : grille (~80 000 triangles) écrite dans bench_resources_synth.obj
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "ResourceCache/resource_cache.hpp"
+#include "SceneObjects.hpp"
+
+// Plan ondulé N x N, positions seules
+static bool writeSynthetic(const std::string& path, int n)
+{
+    return writeSyntheticGridOBJ(path, n, n, 0, [n](float u, float v, float* p, float*) {
+        p[0] = u;
+        p[1] = v;
+        p[2] = 0.02f * std::sin(0.2f * u * n);
+    });
+}
+
+static size_t bufferBytes(GLuint buf)
+{
+    if (!buf) return 0;
+    GLint size = 0;
+    glBindBuffer(GL_ARRAY_BUFFER, buf);
+    glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &size);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return (size_t)size;
+}
+
+static void printRow(const char* name, double ms, size_t bytes, int copies)
+{
+    std::printf("  %-28s %10.1f ms %12.1f Ko %10.1f Ko/copie\n", name, ms, bytes / 1024.0, bytes / 1024.0 / copies);
+}
+
+int main(int argc, char** argv)
+{
+    std::string obj  = argStr(argc, argv, "--obj", "");
+    const int copies = argInt(argc, argv, "--copies", 100);
+    if (obj.empty()) {
+        obj = "bench_resources_synth.obj";
+        if (!writeSynthetic(obj, 200)) { std::fprintf(stderr, "ecriture impossible : %s\n", obj.c_str()); return 1; }
+    }
+
+    GLFWwindow* win = createHiddenContext(64, 64);
+    if (!win) return 1;
+    std::printf("bench_resources : %d copies de %s (GL: %s)\n", copies, obj.c_str(),
+                (const char*)glGetString(GL_RENDERER));
+    {
+        // Écrit le cache binaire : les deux passes partent du même état
+        Mesh warm = loadOBJMesh(obj);
+        destroyMesh(warm);
+    }
+
+    // --- Modèle OBJ ---
+    {
+        std::vector<Mesh> meshes;
+        BenchClock clk;
+        for (int i = 0; i < copies; ++i) meshes.push_back(loadOBJMesh(obj));
+        const double ms = clk.ms();
+        size_t bytes = 0;
+        for (const Mesh& m : meshes) bytes += bufferBytes(m.vbo) + bufferBytes(m.ebo);
+        printRow("OBJ sans partage", ms, bytes, copies);
+        for (Mesh& m : meshes) destroyMesh(m);
+    }
+    {
+        SceneObjects scene; // sans arène : VAO par modèle, partagé via resources()
+        BenchClock clk;
+        for (int i = 0; i < copies; ++i)
+            scene.addOBJ(obj, glm::vec3(0.01f * i, 0.0f, 0.0f), glm::vec3(0.0f), glm::vec3(1.0f));
+        const double ms = clk.ms();
+        printRow("OBJ partage (addOBJ)", ms, resources().gpuBytes(), copies);
+        scene.destroy();
+        if (resources().gpuBytes() != 0) std::printf("  ! ressources restantes apres destroy()\n");
+    }
+
+    // --- Sphère de Ball ---
+    {
+        std::vector<Mesh> meshes;
+        BenchClock clk;
+        for (int i = 0; i < copies; ++i) meshes.push_back(createSphere(0.01f, 16, 16));
+        const double ms = clk.ms();
+        size_t bytes = 0;
+        for (const Mesh& m : meshes) bytes += bufferBytes(m.vbo) + bufferBytes(m.ebo);
+        printRow("sphere sans partage", ms, bytes, copies);
+        for (Mesh& m : meshes) destroyMesh(m);
+    }
+    {
+        std::vector<Mesh> meshes;
+        BenchClock clk;
+        for (int i = 0; i < copies; ++i) meshes.push_back(resources().acquireSphere(0.01f, 16, 16));
+        const double ms = clk.ms();
+        printRow("sphere partagee (acquire)", ms, resources().gpuBytes(), copies);
+        resources().report(std::cout);
+        for (const Mesh& m : meshes) resources().release(m);
+        std::printf("  apres %d release : %zu ressource(s)\n", copies, resources().entries().size());
+    }
+
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,177 @@
+// Bench/bench_scene.cpp
+// Benchmark SceneObjects::drawAll : ancien chemin (matrices recalculées, ordre d'insertion,
+// couleur à chaque objet) vs cache de matrices + tri par état + lot SIMD + frustum culling.
+//
+// Usage : ./bench_scene [--items 10000] [--frames 200]
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "Shaders/shaders.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "Geometries/geometries.hpp"
+#include "SceneObjects.hpp"
+
+// Ancien SceneObjects::drawAll (référence) : tout est recalculé à chaque objet.
+static void drawAllLegacy(const std::vector<SceneObjects::Item>& items,
+                          GLuint prog, GLint uMVP, GLint uColor, const glm::mat4& MVP_maze)
+{
+    glUseProgram(prog);
+    for (const auto& it : items) {
+        if (!it.visible || it.mesh.vao == 0 || it.mesh.count == 0) continue;
+
+        glm::mat4 M(1.0f);
+        M = glm::translate(M, it.pos);
+        M = glm::rotate(M, glm::radians(it.rotDeg.x), glm::vec3(1,0,0));
+        M = glm::rotate(M, glm::radians(it.rotDeg.y), glm::vec3(0,1,0));
+        M = glm::rotate(M, glm::radians(it.rotDeg.z), glm::vec3(0,0,1));
+        M = glm::scale(M, it.scale);
+
+        glm::mat4 MVP = MVP_maze * M;
+        glUniformMatrix4fv(uMVP, 1, GL_FALSE, &MVP[0][0]);
+        glUniform4f(uColor, it.color.r, it.color.g, it.color.b, it.color.a);
+
+        glBindVertexArray(it.mesh.vao);
+        glDrawElements(GL_TRIANGLES, it.mesh.count, it.mesh.indexType, 0);
+    }
+    glBindVertexArray(0);
+}
+
+// Préparation CPU seule de l'ancien chemin (matrices modèle + MVP par objet)
+static void prepareLegacy(const std::vector<SceneObjects::Item>& items,
+                          const glm::mat4& MVP_maze, std::vector<glm::mat4>& out)
+{
+    out.resize(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        const auto& it = items[i];
+        glm::mat4 M(1.0f);
+        M = glm::translate(M, it.pos);
+        M = glm::rotate(M, glm::radians(it.rotDeg.x), glm::vec3(1,0,0));
+        M = glm::rotate(M, glm::radians(it.rotDeg.y), glm::vec3(0,1,0));
+        M = glm::rotate(M, glm::radians(it.rotDeg.z), glm::vec3(0,0,1));
+        M = glm::scale(M, it.scale);
+        out[i] = MVP_maze * M;
+    }
+}
+
+static glm::mat4 cameraAt(int frame)
+{
+    // MVP qui bouge à chaque frame (comme une pose caméra suivie)
+    glm::mat4 P = glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.01f, 100.0f);
+    glm::mat4 V = glm::translate(glm::mat4(1.0f), glm::vec3(0.001f * (frame % 50), 0.0f, -1.5f));
+    return P * V;
+}
+
+int main(int argc, char** argv)
+{
+    const int nItems  = argInt(argc, argv, "--items", 10000);
+    const int nFrames = argInt(argc, argv, "--frames", 200);
+
+    GLFWwindow* win = createHiddenContext();
+    if (!win) return 1;
+
+    GLuint prog = linkProgram({ compileShader(GL_VERTEX_SHADER, FACE_VS),
+                                compileShader(GL_FRAGMENT_SHADER, FACE_FS) });
+    GLint uMVP   = glGetUniformLocation(prog, "uMVP");
+    GLint uColor = glGetUniformLocation(prog, "uFaceColor");
+
+    Mesh meshes[3] = { createCubeSolidUnit(), createSphere(0.5f, 16, 16), createSphere(0.5f, 8, 8) };
+    MeshBounds bounds; // cube unité et sphères de rayon 0.5 : mêmes bornes
+    bounds.min = glm::vec3(-0.5f);
+    bounds.max = glm::vec3(0.5f);
+    bounds.center = glm::vec3(0.0f);
+    bounds.radius = 0.8660254f;
+    const glm::vec4 colors[4] = {
+        {0.8f,0.8f,0.8f,1.0f}, {0.9f,0.2f,0.2f,1.0f}, {0.2f,0.9f,0.2f,1.0f}, {0.2f,0.2f,0.9f,1.0f}
+    };
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> upos(-1.0f, 1.0f), urot(0.0f, 360.0f);
+    std::uniform_int_distribution<int> umesh(0, 2), ucol(0, 3);
+
+    SceneObjects scene;
+    for (int i = 0; i < nItems; ++i) {
+        scene.addMesh(meshes[umesh(rng)],
+                      glm::vec3(upos(rng), upos(rng), upos(rng) * 0.2f),
+                      glm::vec3(urot(rng), urot(rng), urot(rng)),
+                      glm::vec3(0.01f),
+                      colors[ucol(rng)],
+                      bounds);
+    }
+    std::vector<SceneObjects::Item> legacyItems;
+    legacyItems.reserve(nItems);
+    for (int i = 0; i < nItems; ++i) legacyItems.push_back(scene.item(i));
+
+    glViewport(0, 0, 640, 480);
+    glEnable(GL_DEPTH_TEST);
+
+    // ---------- CPU seul : préparation des matrices ----------
+    std::vector<glm::mat4> tmp;
+    BenchClock clk;
+    for (int f = 0; f < nFrames; ++f) prepareLegacy(legacyItems, cameraAt(f), tmp);
+    const double cpuLegacy = clk.ms() / nFrames;
+
+    scene.updateCache(); // premier remplissage du cache hors mesure
+    clk.reset();
+    for (int f = 0; f < nFrames; ++f) scene.computeMVPs(cameraAt(f));
+    const double cpuCached = clk.ms() / nFrames;
+
+    // ---------- Soumission GL ----------
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    drawAllLegacy(legacyItems, prog, uMVP, uColor, cameraAt(0)); // warm-up
+    glFinish();
+
+    double submitLegacy = 0.0;
+    clk.reset();
+    for (int f = 0; f < nFrames; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BenchClock s;
+        drawAllLegacy(legacyItems, prog, uMVP, uColor, cameraAt(f));
+        submitLegacy += s.ms();
+        glFinish();
+    }
+    const double frameLegacy = clk.ms() / nFrames;
+    submitLegacy /= nFrames;
+
+    scene.drawAll(prog, uMVP, uColor, cameraAt(0)); // warm-up
+    glFinish();
+
+    double submitSorted = 0.0;
+    clk.reset();
+    for (int f = 0; f < nFrames; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        BenchClock s;
+        scene.drawAll(prog, uMVP, uColor, cameraAt(f));
+        submitSorted += s.ms();
+        glFinish();
+    }
+    const double frameSorted = clk.ms() / nFrames;
+    submitSorted /= nFrames;
+
+    const SceneObjects::DrawStats& st = scene.lastStats();
+
+    std::printf("bench_scene : %d objets, %d frames (GL: %s)\n",
+                nItems, nFrames, (const char*)glGetString(GL_RENDERER));
+    std::printf("  %-28s %10s %10s %10s %10s\n", "", "prep ms", "submit ms", "frame ms", "binds+col");
+    std::printf("  %-28s %10.3f %10.3f %10.3f %10d\n", "legacy (insertion, recalc)",
+                cpuLegacy, submitLegacy, frameLegacy, 2 * nItems);
+    std::printf("  %-28s %10.3f %10.3f %10.3f %10d\n", "cache + tri + lot SIMD",
+                cpuCached, submitSorted, frameSorted, st.vaoBinds + st.colorUploads);
+    std::printf("  frustum culling : %d dessines, %d rejetes (derniere frame)\n", st.drawn, st.culled);
+
+    scene.destroy();
+    for (auto& m : meshes) destroyMesh(m);
+    glDeleteProgram(prog);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,221 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+#include <opencv2/aruco.hpp>
+#include <opencv2/aruco/charuco.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Capture/capture_source.hpp"
+#include "Capture/pose_source.hpp"
+
+/**
+ * @file bench_session.hpp
+ * @brief Session caméra rejouable pour les benchmarks du pipeline de vision (Bench/).
+ *
+ * @details
+ * Deux sources, mêmes réglages que arcube (Charuco 5x7, carrés 26 mm, marqueurs 19 mm,
+ * DICT_6X6_250, raffinement sous-pixel) :
+ * - une session enregistrée (--video, --images : voir CaptureSource, rejouée au plus vite)
+ *   avec sa calibration (--calib, format de camera.yaml) ;
+ * - une session synthétique : l'image de la planche, projetée par homographie le long de
+ *   la trajectoire scriptée d'arcube --poses scripted (scriptedPose()). La pose de référence
+ *   (rvec / tvec dans le repère de la planche) est fournie avec chaque image.
+ *
+ * Le repère métrique de la planche est relié à son image par les coins détectés dans
+ * l'image plane elle-même : la génération ne dépend pas de la convention d'axes de la
+ * version d'OpenCV (l'axe y des planches a changé de sens en 4.6).
+ */
+
+/// @brief Planche et paramètres de détection d'arcube.
+struct BenchBoard {
+    cv::Ptr<cv::aruco::Dictionary> dict = cv::aruco::getPredefinedDictionary(cv::aruco::DICT_6X6_250);
+    cv::Ptr<cv::aruco::CharucoBoard> board = cv::aruco::CharucoBoard::create(5, 7, 0.026f, 0.019f, dict);
+    cv::Ptr<cv::aruco::DetectorParameters> params = makeParams();
+
+    static cv::Ptr<cv::aruco::DetectorParameters> makeParams()
+    {
+        auto p = cv::aruco::DetectorParameters::create();
+        p->cornerRefinementMethod = cv::aruco::CORNER_REFINE_SUBPIX;
+        p->cornerRefinementWinSize = 5;
+        p->cornerRefinementMaxIterations = 30;
+        p->cornerRefinementMinAccuracy = 0.01;
+        return p;
+    }
+};
+
+/**
+ * @brief Lit camera_matrix / distortion_coefficients (et image_width / image_height) d'un YAML.
+ * @return false si le fichier est absent ou incomplet.
+ */
+inline bool loadBenchCalibration(const std::string& path, cv::Mat& K, cv::Mat& D, cv::Size& size)
+{
+    cv::FileStorage fs(path, cv::FileStorage::READ);
+    if (!fs.isOpened()) return false;
+    fs["camera_matrix"] >> K;
+    fs["distortion_coefficients"] >> D;
+    if (K.empty() || D.empty()) return false;
+    if (K.type() != CV_64F) K.convertTo(K, CV_64F);
+    if (D.type() != CV_64F) D.convertTo(D, CV_64F);
+    D = D.reshape(1, 1);
+    size = cv::Size((int)fs["image_width"], (int)fs["image_height"]);
+    if (size.area() == 0) size = cv::Size((int)std::lround(K.at<double>(0, 2) * 2.0), (int)std::lround(K.at<double>(1, 2) * 2.0));
+    return true;
+}
+
+/**
+ * @class BenchSession
+ * @brief Images successives d'une vidéo enregistrée ou d'une session synthétique.
+ */
+class BenchSession {
+public:
+    cv::Mat K, D;            ///< Intrinsèques (mises à l'échelle de l'image pour une vidéo).
+    bool hasTruth = false;   ///< Pose de référence disponible (session synthétique).
+    cv::Mat truthR, truthT;  ///< Pose de référence de la dernière image (CV_64F 3x1).
+
+    /**
+     * @brief Ouvre une vidéo enregistrée ; K est adaptée si sa taille diffère de la calibration.
+     */
+    bool openVideo(const std::string& video, const std::string& calib)
+    {
+        CaptureOptions o;
+        o.kind = CaptureKind::File;
+        o.target = video;
+        return openCapture(o, calib);
+    }
+
+    /**
+     * @brief Ouvre une source de CaptureSource (cadence forcée à Throughput) ;
+     *        K est adaptée si la taille des images diffère de la calibration.
+     */
+    bool openCapture(CaptureOptions o, const std::string& calib)
+    {
+        cv::Size calibSz;
+        if (!loadBenchCalibration(calib, K, D, calibSz)) {
+            std::fprintf(stderr, "calibration illisible : %s\n", calib.c_str());
+            return false;
+        }
+        o.pacing = CapturePacing::Throughput;
+        if (!cap.open(o) || !cap.read(first) || first.empty()) {
+            std::fprintf(stderr, "source illisible : %s\n", cap.error().empty() ? o.target.c_str() : cap.error().c_str());
+            return false;
+        }
+        if (first.size() != calibSz && calibSz.area() > 0) {
+            const double sx = (double)first.cols / calibSz.width, sy = (double)first.rows / calibSz.height;
+            K.at<double>(0, 0) *= sx; K.at<double>(0, 2) *= sx;
+            K.at<double>(1, 1) *= sy; K.at<double>(1, 2) *= sy;
+        }
+        synthetic = false;
+        hasTruth = false;
+        index = 0;
+        return true;
+    }
+
+    /**
+     * @brief Prépare une session synthétique de `frames` images de taille `size`
+     *        (caméra sans distorsion, focale 0.8 x largeur).
+     */
+    bool openSynthetic(const BenchBoard& b, int frames, cv::Size size = cv::Size(1280, 720))
+    {
+        const double f = 0.8 * size.width;
+        K = (cv::Mat_<double>(3, 3) << f, 0, size.width * 0.5, 0, f, size.height * 0.5, 0, 0, 1);
+        D = cv::Mat::zeros(1, 5, CV_64F);
+
+        // Image de la planche, puis homographie repère métrique (x, y) -> pixels de cette image
+        b.board->draw(cv::Size(1000, 1400), boardImg, 40, 1);
+        std::vector<int> ids;
+        std::vector<std::vector<cv::Point2f>> corners;
+        cv::aruco::detectMarkers(boardImg, b.dict, corners, ids, b.params);
+        cv::Mat cc, ci;
+        if (ids.empty() || cv::aruco::interpolateCornersCharuco(corners, ids, boardImg, b.board, cc, ci) < 4) {
+            std::fprintf(stderr, "planche synthetique : coins non detectes\n");
+            return false;
+        }
+        std::vector<cv::Point2f> metric, pixels;
+        for (int i = 0; i < (int)ci.total(); ++i) {
+            const cv::Point3f& p = b.board->chessboardCorners[ci.at<int>(i)];
+            metric.push_back(cv::Point2f(p.x, p.y));
+            pixels.push_back(cc.at<cv::Point2f>(i));
+        }
+        const cv::Mat metricToBoard = cv::findHomography(metric, pixels);
+        boardToMetric = metricToBoard.inv();
+
+        // scriptedPose() retourne la planche autour de x ; annulé quand le repère métrique a
+        // déjà l'orientation de l'image (sinon la planche serait vue en miroir)
+        const double det = metricToBoard.at<double>(0, 0) * metricToBoard.at<double>(1, 1)
+                         - metricToBoard.at<double>(0, 1) * metricToBoard.at<double>(1, 0);
+        flip = det > 0 ? (cv::Mat)(cv::Mat_<double>(3, 3) << 1, 0, 0, 0, -1, 0, 0, 0, -1) : cv::Mat::eye(3, 3, CV_64F);
+
+        const cv::Point3f& last = b.board->chessboardCorners.back();
+        const cv::Point3f& first3 = b.board->chessboardCorners.front();
+        center = (cv::Mat_<double>(3, 1) << (last.x + first3.x) * 0.5, (last.y + first3.y) * 0.5, 0.0);
+        frameSize = size;
+        total = frames;
+        synthetic = true;
+        hasTruth = true;
+        index = 0;
+        return true;
+    }
+
+    /// @brief Image suivante (BGR). @return false en fin de session.
+    bool next(cv::Mat& bgr)
+    {
+        if (!synthetic) {
+            if (index++ == 0) { first.copyTo(bgr); return true; }
+            return cap.read(bgr);
+        }
+        if (index >= total) return false;
+        cv::Mat rs, ts, Rs;
+        scriptedPose(index++ / 30.0, rs, ts); // 30 images / s
+        cv::Rodrigues(rs, Rs);
+
+        // Même mouvement dans le repère de cette planche : son centre prend la place du
+        // centre de rotation de la trajectoire
+        const cv::Mat pivot = (cv::Mat_<double>(3, 1) << SCRIPTED_POSE_CENTER[0], SCRIPTED_POSE_CENTER[1],
+                               SCRIPTED_POSE_CENTER[2]);
+        const cv::Mat R = Rs * flip;
+        truthT = ts + Rs * pivot - R * center;
+        cv::Rodrigues(R, truthR);
+
+        // Plan z = 0 : pixels = K [r1 r2 t] (x, y, 1)
+        cv::Mat P(3, 3, CV_64F);
+        R.col(0).copyTo(P.col(0));
+        R.col(1).copyTo(P.col(1));
+        truthT.copyTo(P.col(2));
+        const cv::Mat H = K * P * boardToMetric;
+        cv::Mat gray;
+        cv::warpPerspective(boardImg, gray, H, frameSize, cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(110));
+        cv::cvtColor(gray, bgr, cv::COLOR_GRAY2BGR);
+        return true;
+    }
+
+    /// @brief Nombre d'images (-1 si inconnu : flux vidéo).
+    int frameCount() const
+    {
+        return synthetic ? total : cap.frameCount();
+    }
+
+    /// @brief Horodatage de la dernière image (ms depuis la première ; 30 i/s en synthétique).
+    double timestampMs() const
+    {
+        return synthetic ? (index - 1) * 1000.0 / 30.0 : cap.timestampMs();
+    }
+
+    /// @brief Description de la source.
+    std::string describe() const
+    {
+        return synthetic ? "synthetique (trajectoire scriptee, " + std::to_string(frameSize.width) + "x" +
+                               std::to_string(frameSize.height) + ")"
+                         : cap.describe();
+    }
+
+private:
+    CaptureSource cap;
+    cv::Mat first;
+    bool synthetic = false;
+    int index = 0, total = 0;
+    cv::Mat boardImg, boardToMetric, flip, center;
+    cv::Size frameSize;
+};
@@ -0,0 +1,160 @@
+// Bench/bench_stream.cpp
+// Upload de données dynamiques par frame : orphelinage (glBufferData(NULL) + glBufferSubData,
+// chemin d'origine de LineBatch) vs StreamBuffer persistant vs StreamBuffer en repli
+// glMapBufferRange non synchronisé. Chaque frame écrit N Ko puis les consomme par un draw de
+// points ; pas de glFinish par frame (le GPU reste en retard comme dans l'application).
+//
+// Usage : ./bench_stream [--kb 64,256,1024,4096] [--frames 300]
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "GLUtils/gl_utils.hpp"
+#include "GLUtils/stream_buffer.hpp"
+
+static const char* POINTS_VS = R"(#version 330 core
+layout(location=0) in vec4 aPos;
+void main() { gl_Position = vec4(aPos.xy * 0.001, 0.0, 1.0); gl_PointSize = 1.0; }
+)";
+static const char* POINTS_FS = R"(#version 330 core
+out vec4 FragColor;
+void main() { FragColor = vec4(1.0); }
+)";
+
+struct Result {
+    double mbPerS = 0.0;   ///< Octets écrits / temps mur total.
+    double cpuMs = 0.0;    ///< Temps CPU moyen d'upload + soumission par frame.
+    int stalls = 0;
+    double stallMs = 0.0;
+};
+
+/// @brief Remplit dst (bytes octets) avec des sommets différents à chaque frame.
+static void fill(void* dst, std::size_t bytes, int frame)
+{
+    float* f = (float*)dst;
+    const std::size_t n = bytes / sizeof(float);
+    for (std::size_t i = 0; i < n; ++i) f[i] = (float)((i + frame) & 1023);
+}
+
+/// @brief Orphelinage : un VBO réalloué puis rempli à chaque frame.
+static Result runOrphan(GLuint prog, std::size_t bytes, int frames)
+{
+    std::vector<char> staging(bytes);
+    GLuint vao = 0, vbo = 0;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)bytes, nullptr, GL_STREAM_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 16, (void*)0);
+    glUseProgram(prog);
+    glFinish();
+
+    Result r;
+    BenchClock wall;
+    for (int i = 0; i < frames; ++i) {
+        BenchClock cpu;
+        fill(staging.data(), bytes, i);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)bytes, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)bytes, staging.data());
+        glDrawArrays(GL_POINTS, 0, (GLsizei)(bytes / 16));
+        glFlush();
+        r.cpuMs += cpu.ms();
+    }
+    glFinish();
+    r.mbPerS = (double)bytes * frames / (1024.0 * 1024.0) / (wall.ms() / 1000.0);
+    r.cpuMs /= frames;
+
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    return r;
+}
+
+/// @brief StreamBuffer : écriture directe dans la région de la frame, attributs repointés.
+static Result runStream(GLuint prog, std::size_t bytes, int frames, bool persistent, bool& gotPersistent)
+{
+    StreamBuffer sb;
+    sb.create((GLsizeiptr)bytes, persistent);
+    gotPersistent = sb.persistent();
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glEnableVertexAttribArray(0);
+    glUseProgram(prog);
+    glFinish();
+
+    Result r;
+    BenchClock wall;
+    for (int i = 0; i < frames; ++i) {
+        BenchClock cpu;
+        sb.beginFrame();
+        const StreamAlloc a = sb.alloc((GLsizeiptr)bytes, 16);
+        fill(a.ptr, bytes, i);
+        sb.unmap();
+        glBindBuffer(GL_ARRAY_BUFFER, a.buffer);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 16, (void*)a.offset);
+        glDrawArrays(GL_POINTS, 0, (GLsizei)(bytes / 16));
+        sb.endFrame();
+        glFlush();
+        r.cpuMs += cpu.ms();
+    }
+    glFinish();
+    r.mbPerS = (double)bytes * frames / (1024.0 * 1024.0) / (wall.ms() / 1000.0);
+    r.cpuMs /= frames;
+    r.stalls = sb.stats().stalls;
+    r.stallMs = sb.stats().stallMs;
+
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+    sb.destroy();
+    return r;
+}
+
+int main(int argc, char** argv)
+{
+    const std::string sizes = argStr(argc, argv, "--kb", "64,256,1024,4096");
+    const int frames = argInt(argc, argv, "--frames", 300);
+
+    GLFWwindow* win = createHiddenContext(640, 480);
+    if (!win) return 1;
+    GLuint prog = linkProgram({ compileShader(GL_VERTEX_SHADER, POINTS_VS),
+                                compileShader(GL_FRAGMENT_SHADER, POINTS_FS) });
+
+    std::printf("bench_stream : %d frames par mesure (GL: %s, buffer_storage %s)\n", frames,
+                (const char*)glGetString(GL_RENDERER),
+                (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) ? "oui" : "non");
+    std::printf("  %8s  %-22s %10s %12s %8s %10s\n", "Ko/frame", "", "Mo/s", "cpu ms/frm", "stalls", "stall ms");
+
+    std::stringstream ss(sizes);
+    std::string tok;
+    while (std::getline(ss, tok, ',')) {
+        const std::size_t bytes = (std::size_t)std::stoi(tok) * 1024;
+        bool persistent = false, fallback = false;
+        const Result o = runOrphan(prog, bytes, frames);
+        const Result p = runStream(prog, bytes, frames, true, persistent);
+        const Result m = runStream(prog, bytes, frames, false, fallback);
+
+        auto row = [&](const char* name, const Result& r, bool ring) {
+            std::printf("  %8s  %-22s %10.1f %12.3f", tok.c_str(), name, r.mbPerS, r.cpuMs);
+            if (ring) std::printf(" %8d %10.3f\n", r.stalls, r.stallMs);
+            else      std::printf(" %8s %10s\n", "-", "-");
+        };
+        row("orphelinage", o, false);
+        row(persistent ? "anneau persistant" : "anneau (pas de 4.4)", p, true);
+        row("anneau map unsync", m, true);
+    }
+
+    glDeleteProgram(prog);
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Bench/bench_texture.cpp
+// Textures : chargement d'origine (imread + cvtColor + flip + glTexImage2D, sans mipmaps) vs
+// cache mipmappé (texture_cache.hpp) en RGBA8 et en BC1, à froid (cache construit) et à chaud
+// (cache projeté) : durée et mémoire GPU, tous niveaux compris.
+//
+// Usage : ./bench_texture [--tex image ...] [--cpu 1]
+//   Par défaut : assets/background.jpg et la texture du modèle Meshy.
+//   --cpu 1 : construction / ouverture des caches seulement (pas de contexte GL)
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Bench/bench_common.hpp"
+#include "Texture/texture.hpp"
+#include "TextureCache/texture_cache.hpp"
+
+static size_t legacyBytes(GLuint tex)
+{
+    GLint w = 0, h = 0;
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return (size_t)w * h * 4; // RGB8 stocké en RGBX
+}
+
+static void removeCache(const std::string& path, TexCacheFormat f)
+{
+    std::error_code ec;
+    std::filesystem::remove(textureCachePath(path, f), ec);
+}
+
+static void cpuOnly(const std::string& path)
+{
+    for (TexCacheFormat f : { TexCacheFormat::RGBA8, TexCacheFormat::BC1 }) {
+        removeCache(path, f);
+        TextureCacheView view;
+        bool built = false;
+        BenchClock cold;
+        if (!openTextureCache(path, f, true, view, &built)) { std::printf("  %s : illisible\n", path.c_str()); return; }
+        const double coldMs = cold.ms();
+        view.close();
+        BenchClock warm;
+        openTextureCache(path, f, true, view, &built);
+        std::printf("  %-40s %-6s %5ux%-5u %2u niv. | construit %8.1f ms | ouvert %6.3f ms | %9.1f Ko\n",
+                    path.c_str(), f == TexCacheFormat::BC1 ? "BC1" : "RGBA8", view.width(), view.height(),
+                    view.levelCount(), coldMs, warm.ms(), view.dataBytes() / 1024.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> paths;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--tex") paths.push_back(argv[i + 1]);
+    if (paths.empty())
+        paths = { "./assets/background.jpg", "./assets/obj/SM/Meshy_AI_SM_0115202256_texture.png" };
+
+    if (argInt(argc, argv, "--cpu", 0) != 0) {
+        std::printf("bench_texture (CPU) : caches de textures, retournement vertical\n");
+        for (const std::string& p : paths) cpuOnly(p);
+        return 0;
+    }
+
+    GLFWwindow* win = createHiddenContext(64, 64);
+    if (!win) return 1;
+    std::printf("bench_texture : GL %s, BC1 %s, glTexStorage2D %s\n", (const char*)glGetString(GL_RENDERER),
+                GLEW_EXT_texture_compression_s3tc ? "oui" : "non",
+                (GLEW_VERSION_4_2 || GLEW_ARB_texture_storage) ? "oui" : "non");
+    std::printf("  %-40s %-22s %10s %12s %7s\n", "", "chemin", "ms", "Ko GPU", "niveaux");
+
+    for (const std::string& p : paths) {
+        {
+            BenchClock clk;
+            GLuint tex = loadTextureFromFile(p, true);
+            glFinish();
+            const double ms = clk.ms();
+            if (!tex) { std::printf("  %-40s illisible\n", p.c_str()); continue; }
+            std::printf("  %-40s %-22s %10.1f %12.1f %7d\n", p.c_str(), "origine (sans mips)", ms,
+                        legacyBytes(tex) / 1024.0, 1);
+            glDeleteTextures(1, &tex);
+        }
+        for (int compress = 0; compress < 2; ++compress) {
+            const TexCacheFormat f = preferredTexCacheFormat(compress != 0);
+            if (compress && f != TexCacheFormat::BC1) continue; // BC1 non supporté
+            removeCache(p, f);
+            for (int pass = 0; pass < 2; ++pass) {
+                TextureLoadInfo info;
+                GLuint tex = loadTextureCached(p, true, compress != 0, &info);
+                glFinish();
+                char name[32];
+                std::snprintf(name, sizeof(name), "cache %s %s", compress ? "BC1" : "RGBA8", pass ? "chaud" : "froid");
+                std::printf("  %-40s %-22s %10.1f %12.1f %7u\n", "", name, info.ms, info.gpuBytes / 1024.0, info.levels);
+                glDeleteTextures(1, &tex);
+            }
+        }
+    }
+
+    glfwDestroyWindow(win);
+    glfwTerminate();
+    return 0;
+}
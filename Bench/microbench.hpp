@@ -0,0 +1,214 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @file microbench.hpp
+ * @brief Petit harnais de micro-benchmarks (dans l'esprit de Google Benchmark) pour Bench/.
+ *
+ * @details
+ * Un cas est une fonction `void(MicroState&)` enregistrée avec une ou plusieurs listes
+ * d'arguments ; la boucle mesurée s'écrit `while (st.keepRunning()) { ... }`.
+ * Pour chaque (cas, arguments) :
+ * - étalonnage : le nombre d'itérations croît jusqu'à ce qu'un lot dure au moins --min-ms ;
+ * - --reps lots de ce nombre d'itérations ; on rapporte la médiane et le minimum
+ *   (ns / itération), l'écart relatif max / min et le débit (setItemsProcessed()).
+ *
+ * Les préparations hors mesure vont avant la boucle ou entre pauseTiming() / resumeTiming()
+ * (deux lectures d'horloge, ~40 ns : à réserver aux cas de plusieurs µs).
+ * doNotOptimize() empêche le compilateur d'éliminer un résultat inutilisé.
+ *
+ * Options : --filter SOUS-CHAINE, --min-ms 100, --reps 5, --json FICHIER.
+ *
+ * @code
+ * MicroRunner r(argc, argv);
+ * r.add("buildSphere", [](MicroState& st) {
+ *     while (st.keepRunning()) doNotOptimize(buildSphere(0.01f, (int)st.arg(0), (int)st.arg(1)));
+ * }, { { 16, 16 }, { 64, 64 } });
+ * return r.run();
+ * @endcode
+ */
+
+/// @brief Force le calcul de `v` (le compilateur le considère comme lu).
+template <class T>
+inline void doNotOptimize(const T& v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&v) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &v;
+#endif
+}
+
+/**
+ * @class MicroState
+ * @brief État d'un lot : itérations restantes, arguments, chronomètre.
+ */
+class MicroState {
+public:
+    MicroState(int64_t iterations, const std::vector<int64_t>& args) : iters(iterations), left(iterations), a(args) {}
+
+    /// @brief Vrai tant qu'il reste des itérations ; démarre le chronomètre au premier appel.
+    bool keepRunning()
+    {
+        if (left == iters) t0 = Clock::now();
+        if (left-- > 0) return true;
+        ns += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        return false;
+    }
+
+    void pauseTiming() { ns += std::chrono::duration<double, std::nano>(Clock::now() - t0).count(); }
+    void resumeTiming() { t0 = Clock::now(); }
+
+    int64_t iterations() const { return iters; }
+    int64_t arg(size_t i) const { return i < a.size() ? a[i] : 0; }
+
+    /// @brief Éléments traités par le lot entier (sommets, boîtes, poses...) : débit rapporté.
+    void setItemsProcessed(int64_t n) { items = n; }
+    /// @brief Unité du débit (par défaut "items").
+    void setItemLabel(const char* l) { itemLabel = l; }
+
+    double elapsedNs() const { return ns; }
+    int64_t itemsProcessed() const { return items; }
+    const char* label() const { return itemLabel; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    int64_t iters, left;
+    std::vector<int64_t> a;
+    Clock::time_point t0;
+    double ns = 0.0;
+    int64_t items = 0;
+    const char* itemLabel = "items";
+};
+
+/**
+ * @class MicroRunner
+ * @brief Enregistre les cas, les exécute (filtre, étalonnage, répétitions) et imprime le rapport.
+ */
+class MicroRunner {
+public:
+    using Fn = std::function<void(MicroState&)>;
+
+    MicroRunner(int argc, char** argv)
+    {
+        for (int i = 1; i + 1 < argc; ++i) {
+            const std::string k = argv[i];
+            if (k == "--filter") filter = argv[++i];
+            else if (k == "--min-ms") minMs = std::max(1.0, std::atof(argv[++i]));
+            else if (k == "--reps") reps = std::max(1, std::atoi(argv[++i]));
+            else if (k == "--json") json = argv[++i];
+        }
+    }
+
+    /// @brief Enregistre un cas ; une exécution par liste d'arguments ("nom/a0/a1").
+    void add(const std::string& name, Fn fn, const std::vector<std::vector<int64_t>>& argSets = { {} })
+    {
+        for (const auto& args : argSets) {
+            std::string full = name;
+            for (int64_t v : args) full += "/" + std::to_string(v);
+            cases.push_back({ full, fn, args });
+        }
+    }
+
+    /// @brief Exécute les cas retenus par --filter. @return 0, ou 1 si le JSON n'a pu être écrit.
+    int run()
+    {
+        std::printf("%-52s %12s %12s %12s %8s %16s\n", "cas", "iterations", "ns/it (med)", "ns/it (min)", "ecart",
+                    "debit");
+        std::vector<Result> results;
+        for (const Case& c : cases) {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos) continue;
+            const Result r = measure(c);
+            results.push_back(r);
+            char rate[48] = "";
+            if (r.itemsPerSec > 0.0) std::snprintf(rate, sizeof(rate), "%.3g %s/s", r.itemsPerSec, r.itemLabel);
+            std::printf("%-52s %12lld %12.1f %12.1f %7.1f%% %16s\n", r.name.c_str(), (long long)r.iterations,
+                        r.medianNs, r.minNs, r.spreadPct, rate);
+            std::fflush(stdout);
+        }
+        return json.empty() || writeJson(results) ? 0 : 1;
+    }
+
+private:
+    struct Case {
+        std::string name;
+        Fn fn;
+        std::vector<int64_t> args;
+    };
+    struct Result {
+        std::string name;
+        int64_t iterations = 0;
+        double medianNs = 0, minNs = 0, spreadPct = 0, itemsPerSec = 0;
+        const char* itemLabel = "items";
+    };
+
+    Result measure(const Case& c) const
+    {
+        // Étalonnage : lot de 1, 10, 100... puis extrapolation vers --min-ms (x1.2 de marge)
+        const double target = minMs * 1e6;
+        int64_t n = 1;
+        for (;;) {
+            MicroState st(n, c.args);
+            c.fn(st);
+            const double ns = std::max(st.elapsedNs(), 1.0);
+            if (ns >= target || n >= (int64_t)1e9) break;
+            const int64_t next = ns < target * 0.1 ? n * 10 : (int64_t)std::ceil(n * target * 1.2 / ns);
+            n = std::max(n + 1, std::min(next, n * 100));
+        }
+
+        Result r;
+        r.name = c.name;
+        r.iterations = n;
+        std::vector<double> perIt;
+        double items = 0.0, ns = 0.0;
+        for (int i = 0; i < reps; ++i) {
+            MicroState st(n, c.args);
+            c.fn(st);
+            perIt.push_back(st.elapsedNs() / n);
+            items += (double)st.itemsProcessed();
+            ns += st.elapsedNs();
+            r.itemLabel = st.label();
+        }
+        std::sort(perIt.begin(), perIt.end());
+        r.medianNs = perIt[perIt.size() / 2];
+        r.minNs = perIt.front();
+        r.spreadPct = 100.0 * (perIt.back() - perIt.front()) / std::max(perIt.front(), 1e-9);
+        r.itemsPerSec = items > 0.0 ? items * 1e9 / ns : 0.0;
+        return r;
+    }
+
+    bool writeJson(const std::vector<Result>& results) const
+    {
+        FILE* f = std::fopen(json.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "ecriture impossible : %s\n", json.c_str());
+            return false;
+        }
+        std::fprintf(f, "{\n  \"min_ms\": %.1f,\n  \"reps\": %d,\n  \"benchmarks\": [\n", minMs, reps);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(f, "    {\"name\": \"%s\", \"iterations\": %lld, \"median_ns\": %.3f, \"min_ns\": %.3f, "
+                            "\"spread_pct\": %.2f, \"items_per_second\": %.6g, \"item_label\": \"%s\"}%s\n",
+                         r.name.c_str(), (long long)r.iterations, r.medianNs, r.minNs, r.spreadPct, r.itemsPerSec,
+                         r.itemLabel, i + 1 < results.size() ? "," : "");
+        }
+        std::fputs("  ]\n}\n", f);
+        std::fclose(f);
+        std::printf("%s ecrit\n", json.c_str());
+        return true;
+    }
+
+    std::vector<Case> cases;
+    std::string filter, json;
+    double minMs = 100.0;
+    int reps = 5;
+};
@@ -0,0 +1,253 @@
+/**
+ * @file capture_source.cpp
+ * @brief Implémentation des sources d'images (direct / enregistrées) et de l'enregistreur.
+ */
+
+#include "capture_source.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool isImageFile(const fs::path& p) {
+    std::string ext = p.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp";
+}
+
+/// @brief Un temps (ms) par ligne ; lignes vides ou commençant par # ignorées.
+std::vector<double> readTimestamps(const std::string& path) {
+    std::vector<double> out;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        out.push_back(std::atof(line.c_str()));
+    }
+    return out;
+}
+
+} // namespace
+
+bool parseCaptureArg(int argc, char** argv, int& i, CaptureOptions& o, std::string& err) {
+    const std::string a = argv[i];
+    static const char* const withValue[] = { "--camera", "--url", "--video", "--images", "--blank", "--pace", "--fps" };
+    if (std::find(std::begin(withValue), std::end(withValue), a) == std::end(withValue)) return false;
+    if (i + 1 >= argc) {
+        err = a + " : valeur manquante";
+        return true;
+    }
+    const std::string v = argv[++i];
+    if (a == "--camera") {
+        o.kind = CaptureKind::Camera;
+        o.cameraIndex = std::atoi(v.c_str());
+    } else if (a == "--url") {
+        o.kind = CaptureKind::Url;
+        o.target = v;
+    } else if (a == "--video") {
+        o.kind = CaptureKind::File;
+        o.target = v;
+    } else if (a == "--images") {
+        o.kind = CaptureKind::Images;
+        o.target = v;
+    } else if (a == "--blank") {
+        o.kind = CaptureKind::Blank;
+        o.target = v;
+    } else if (a == "--pace") {
+        if (v == "realtime") o.pacing = CapturePacing::RealTime;
+        else if (v == "fast") o.pacing = CapturePacing::Throughput;
+        else err = "--pace : realtime ou fast attendu";
+    } else {
+        o.fps = std::atof(v.c_str());
+        if (!(o.fps > 0.0)) err = "--fps : cadence positive attendue";
+    }
+    return true;
+}
+
+const char* captureUsage() {
+    return "  --camera N              camera locale N\n"
+           "  --url URL               flux reseau (defaut : DroidCam http://192.168.1.158:4747/video)\n"
+           "  --video FICHIER         video enregistree (horodatages : FICHIER.timestamps si present)\n"
+           "  --images DOSSIER        sequence d'images (horodatages : DOSSIER/timestamps.txt si present)\n"
+           "  --blank LxH             image grise unie, sans fin (rendu seul avec --poses)\n"
+           "  --pace realtime|fast    enregistrement : cadence d'origine (defaut) ou au plus vite\n"
+           "  --fps F                 cadence supposee sans horodatages\n";
+}
+
+bool CaptureSource::open(const CaptureOptions& o) {
+    close();
+    opts = o;
+    err.clear();
+
+    switch (o.kind) {
+    case CaptureKind::Camera:
+        cap.open(o.cameraIndex);
+        break;
+    case CaptureKind::Url:
+    case CaptureKind::File:
+        cap.open(o.target);
+        break;
+    case CaptureKind::Images: {
+        std::error_code ec;
+        for (const auto& e : fs::directory_iterator(o.target, ec))
+            if (e.is_regular_file() && isImageFile(e.path())) files.push_back(e.path().string());
+        std::sort(files.begin(), files.end());
+        if (files.empty()) {
+            err = "aucune image dans " + o.target;
+            return false;
+        }
+        timestamps = readTimestamps((fs::path(o.target) / "timestamps.txt").string());
+        break;
+    }
+    case CaptureKind::Blank: {
+        int bw = 0, bh = 0;
+        if (std::sscanf(o.target.c_str(), "%dx%d", &bw, &bh) != 2 || bw <= 0 || bh <= 0) {
+            err = "taille invalide (LxH attendu) : " + o.target;
+            return false;
+        }
+        blank = cv::Mat(bh, bw, CV_8UC3, cv::Scalar(96, 96, 96));
+        break;
+    }
+    }
+    if (o.kind != CaptureKind::Images && o.kind != CaptureKind::Blank) {
+        if (!cap.isOpened()) {
+            err = "ouverture impossible : " + (o.kind == CaptureKind::Camera ? "camera " + std::to_string(o.cameraIndex) : o.target);
+            return false;
+        }
+        if (o.kind == CaptureKind::File) timestamps = readTimestamps(o.target + ".timestamps");
+    }
+
+    const double containerFps = cap.isOpened() ? cap.get(cv::CAP_PROP_FPS) : 0.0;
+    if (o.fps > 0.0) nominalFps = o.fps;
+    else if (containerFps > 0.0 && containerFps < 1000.0) nominalFps = containerFps; // flux HTTP : souvent non renseigné
+    else if (timestamps.size() > 1 && timestamps.back() > timestamps.front())
+        nominalFps = 1000.0 * (timestamps.size() - 1) / (timestamps.back() - timestamps.front());
+    else nominalFps = 30.0;
+    t0 = std::chrono::steady_clock::now();
+    return true;
+}
+
+void CaptureSource::close() {
+    cap.release();
+    files.clear();
+    blank.release();
+    timestamps.clear();
+    nominalFps = 30.0;
+    lastTs = lastRaw = 0.0;
+    firstTs = -1.0;
+    index = 0;
+}
+
+bool CaptureSource::grabNext(cv::Mat& frame, double& ts) {
+    if (opts.kind == CaptureKind::Images) {
+        if (index >= (int)files.size()) return false;
+        frame = cv::imread(files[index]);
+        if (frame.empty()) {
+            err = "image illisible : " + files[index];
+            return false;
+        }
+    } else if (opts.kind == CaptureKind::Blank) {
+        frame = blank;
+    } else if (!cap.read(frame) || frame.empty()) {
+        return false;
+    }
+
+    if (isLive()) {
+        ts = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    } else if (index < (int)timestamps.size()) {
+        ts = timestamps[index];
+    } else {
+        // Sans horodatages enregistrés : position du conteneur si elle avance, sinon cadence nominale
+        const double pos = cap.isOpened() ? cap.get(cv::CAP_PROP_POS_MSEC) : 0.0;
+        if (index == 0) ts = pos > 0.0 ? pos : 0.0;
+        else ts = pos > lastRaw ? pos : lastRaw + 1000.0 / nominalFps;
+    }
+    lastRaw = ts;
+    return true;
+}
+
+void CaptureSource::pace(double ts) {
+    if (isLive() || opts.pacing != CapturePacing::RealTime) return;
+    if (index == 0) {
+        t0 = std::chrono::steady_clock::now();
+        return;
+    }
+    std::this_thread::sleep_until(t0 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                           std::chrono::duration<double, std::milli>(ts)));
+}
+
+bool CaptureSource::read(cv::Mat& frame) {
+    double ts = 0.0;
+    if (!grabNext(frame, ts)) return false;
+    if (!isLive()) {
+        if (firstTs < 0.0) firstTs = ts;
+        ts -= firstTs;
+    }
+    pace(ts);
+    lastTs = ts;
+    ++index;
+    return true;
+}
+
+int CaptureSource::frameCount() const {
+    if (opts.kind == CaptureKind::Images) return (int)files.size();
+    if (opts.kind == CaptureKind::File) {
+        const int n = (int)cap.get(cv::CAP_PROP_FRAME_COUNT);
+        return n > 0 ? n : -1;
+    }
+    return -1;
+}
+
+std::string CaptureSource::describe() const {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), ", %.1f i/s", nominalFps);
+    switch (opts.kind) {
+    case CaptureKind::Camera: return "camera " + std::to_string(opts.cameraIndex) + buf;
+    case CaptureKind::Url:    return "flux " + opts.target + buf;
+    case CaptureKind::Blank:  return "image unie " + opts.target + buf +
+                                     (opts.pacing == CapturePacing::RealTime ? ", temps reel" : ", au plus vite");
+    default: break;
+    }
+    std::string s = (opts.kind == CaptureKind::File ? "video " : "images ") + opts.target + buf;
+    s += timestamps.empty() ? ", horodatages calcules" : ", horodatages enregistres";
+    s += opts.pacing == CapturePacing::RealTime ? ", temps reel" : ", au plus vite";
+    return s;
+}
+
+SessionRecorder::~SessionRecorder() {
+    close();
+}
+
+bool SessionRecorder::open(const std::string& dir, int jpegQuality) {
+    close();
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    ts = std::fopen((fs::path(dir) / "timestamps.txt").string().c_str(), "w");
+    if (!ts) return false;
+    std::fputs("# ms depuis le debut de la capture, une ligne par image (ordre des noms de fichiers)\n", ts);
+    folder = dir;
+    params = { cv::IMWRITE_JPEG_QUALITY, jpegQuality };
+    count = 0;
+    return true;
+}
+
+bool SessionRecorder::write(const cv::Mat& frame, double timestampMs) {
+    if (!ts) return false;
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06d.jpg", count);
+    if (!cv::imwrite((fs::path(folder) / name).string(), frame, params)) return false;
+    std::fprintf(ts, "%.3f\n", timestampMs);
+    ++count;
+    return true;
+}
+
+void SessionRecorder::close() {
+    if (ts) std::fclose(ts);
+    ts = nullptr;
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @file capture_source.hpp
+ * @brief Source d'images de la boucle : caméra locale, flux réseau (DroidCam), vidéo ou
+ *        séquence d'images enregistrée, rejouée à sa cadence d'origine ou au plus vite.
+ *
+ * @details
+ * - Camera / Url : cv::VideoCapture en direct ; l'horodatage est l'instant de réception
+ *   (horloge monotone depuis open()).
+ * - File : vidéo enregistrée (cv::VideoCapture). Horodatages : fichier voisin
+ *   "<vidéo>.timestamps" s'il existe (un temps en ms par ligne, celui de la capture
+ *   d'origine), sinon CAP_PROP_POS_MSEC, sinon index / fps.
+ * - Images : dossier d'images (.png, .jpg, .jpeg, .bmp) triées par nom, horodatages dans
+ *   "timestamps.txt" du dossier (format de SessionRecorder), sinon index / fps.
+ * - Blank : image grise unie "LxH", sans fin, traitée comme un enregistrement à fps
+ *   (rendu seul avec arcube --poses, sans caméra ni fichier).
+ *
+ * Cadence (sources enregistrées seulement) :
+ * - RealTime : read() attend l'instant d'origine de l'image relativement à la première.
+ *   Si la boucle est plus lente, aucune image n'est sautée : la suite d'images traitée
+ *   reste identique d'une exécution à l'autre.
+ * - Throughput : pas d'attente, débit maximal (benchmarks, CI).
+ * Dans les deux cas timestampMs() rend le temps d'origine : la physique peut avancer au
+ * pas enregistré et non au pas mesuré, pour un rejeu déterministe.
+ *
+ * Usage :
+ * @code
+ * CaptureOptions o;
+ * o.kind = CaptureKind::File; o.target = "session.mp4"; o.pacing = CapturePacing::Throughput;
+ * CaptureSource src;
+ * if (!src.open(o)) std::cerr << src.error();
+ * cv::Mat frame;
+ * while (src.read(frame)) { const double t = src.timestampMs(); ... }
+ * @endcode
+ */
+
+enum class CaptureKind { Camera, Url, File, Images, Blank };
+enum class CapturePacing { RealTime, Throughput };
+
+/// @brief Choix de la source (voir parseCaptureArg()).
+struct CaptureOptions {
+    CaptureKind kind = CaptureKind::Url;
+    std::string target = "http://192.168.1.158:4747/video"; ///< URL, vidéo, dossier ou taille "LxH".
+    int cameraIndex = 0;
+    CapturePacing pacing = CapturePacing::RealTime;
+    double fps = 0.0; ///< Cadence supposée sans horodatages (0 : celle du conteneur, sinon 30).
+};
+
+/**
+ * @brief Reconnaît une option de source à la position i de argv et avance i sur sa valeur.
+ * @details --camera N | --url URL | --video FICHIER | --images DOSSIER | --blank LxH
+ *          | --pace realtime|fast | --fps F
+ * @return false si argv[i] n'est pas une option de source ; err renseigné si la valeur
+ *         manque ou est invalide.
+ */
+bool parseCaptureArg(int argc, char** argv, int& i, CaptureOptions& o, std::string& err);
+
+/// @brief Aide des options de parseCaptureArg() (une option par ligne).
+const char* captureUsage();
+
+/**
+ * @class CaptureSource
+ * @brief Lecture cadencée d'une source en direct ou enregistrée.
+ */
+class CaptureSource {
+public:
+    bool open(const CaptureOptions& o);
+    void close();
+
+    /// @brief Image suivante (BGR). @return false en fin de source ou sur erreur de lecture.
+    bool read(cv::Mat& frame);
+
+    /// @brief Horodatage de la dernière image lue (ms, origine = première image pour un enregistrement).
+    double timestampMs() const { return lastTs; }
+    /// @brief Nombre d'images lues depuis open().
+    int frameIndex() const { return index; }
+    /// @brief Nombre d'images de l'enregistrement (-1 : direct ou inconnu).
+    int frameCount() const;
+    /// @brief Cadence nominale (images / s).
+    double fps() const { return nominalFps; }
+
+    bool isLive() const { return opts.kind == CaptureKind::Camera || opts.kind == CaptureKind::Url; }
+    CapturePacing pacing() const { return opts.pacing; }
+    const std::string& error() const { return err; }
+    /// @brief Description courte ("vidéo session.mp4, 30 i/s, temps réel").
+    std::string describe() const;
+
+private:
+    bool grabNext(cv::Mat& frame, double& ts);
+    void pace(double ts);
+
+    CaptureOptions opts;
+    cv::VideoCapture cap;
+    std::vector<std::string> files;   ///< Séquence d'images.
+    cv::Mat blank;                    ///< Image unie (Blank), partagée par toutes les frames.
+    std::vector<double> timestamps;   ///< Horodatages enregistrés (vide : calculés).
+    double nominalFps = 30.0;
+    double lastTs = 0.0, firstTs = -1.0;
+    double lastRaw = 0.0;             ///< Horodatage source de la dernière image (avant recalage).
+    int index = 0;
+    std::chrono::steady_clock::time_point t0;
+    std::string err;
+};
+
+/**
+ * @class SessionRecorder
+ * @brief Enregistre les images reçues avec leur horodatage, au format lu par
+ *        CaptureKind::Images (frame_000000.jpg ..., timestamps.txt).
+ */
+class SessionRecorder {
+public:
+    ~SessionRecorder();
+
+    /// @brief Crée le dossier (et ses parents). @return false si impossible.
+    bool open(const std::string& dir, int jpegQuality = 95);
+    bool write(const cv::Mat& frame, double timestampMs);
+    void close();
+
+    bool isOpen() const { return ts != nullptr; }
+    int frames() const { return count; }
+
+private:
+    std::string folder;
+    std::FILE* ts = nullptr;
+    std::vector<int> params;
+    int count = 0;
+};
@@ -0,0 +1,71 @@
+/**
+ * @file pose_source.cpp
+ * @brief Trajectoire scriptée et lecture / écriture des poses enregistrées.
+ */
+
+#include "pose_source.hpp"
+#include <opencv2/calib3d.hpp>
+#include <cmath>
+#include <fstream>
+
+void scriptedPose(double tSec, cv::Mat& rvec, cv::Mat& tvec) {
+    const double kPi = 3.14159265358979323846;
+    const double yaw = 2.0 * kPi * tSec / 12.0;
+    const double tiltX = 0.26 * std::sin(tSec * 0.9), tiltY = 0.26 * std::sin(tSec * 0.6 + 1.0);
+    const double dist = 0.45 + 0.10 * std::sin(tSec * 0.4);
+
+    auto rot = [](int axis, double a) {
+        const double c = std::cos(a), s = std::sin(a);
+        if (axis == 0) return (cv::Mat)(cv::Mat_<double>(3, 3) << 1, 0, 0, 0, c, -s, 0, s, c);
+        if (axis == 1) return (cv::Mat)(cv::Mat_<double>(3, 3) << c, 0, s, 0, 1, 0, -s, 0, c);
+        return (cv::Mat)(cv::Mat_<double>(3, 3) << c, -s, 0, s, c, 0, 0, 0, 1);
+    };
+    // Planche face à la caméra (z de la planche vers la caméra), puis inclinaison et rotation
+    // autour du centre de la feuille (210 x 297 mm, origine au coin de la planche)
+    const cv::Mat R = rot(0, kPi) * rot(0, tiltX) * rot(1, tiltY) * rot(2, yaw);
+    const cv::Mat center = (cv::Mat_<double>(3, 1) << SCRIPTED_POSE_CENTER[0], SCRIPTED_POSE_CENTER[1],
+                            SCRIPTED_POSE_CENTER[2]);
+    tvec = (cv::Mat)(cv::Mat_<double>(3, 1) << 0.0, 0.0, dist) - R * center;
+    cv::Rodrigues(R, rvec);
+}
+
+bool loadPoseCsv(const std::string& path, std::vector<PoseSample>& out) {
+    out.clear();
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        PoseSample p;
+        if (std::sscanf(line.c_str(), "%lf,%lf,%lf,%lf,%lf,%lf,%lf", &p.tMs, &p.r[0], &p.r[1], &p.r[2],
+                        &p.t[0], &p.t[1], &p.t[2]) == 7)
+            out.push_back(p);
+    }
+    return !out.empty();
+}
+
+PoseLog::~PoseLog() {
+    close();
+}
+
+bool PoseLog::open(const std::string& path) {
+    close();
+    f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fputs("t_ms,rx,ry,rz,tx,ty,tz\n", f);
+    n = 0;
+    return true;
+}
+
+void PoseLog::write(double tMs, const cv::Mat& rvec, const cv::Mat& tvec) {
+    if (!f || rvec.total() < 3 || tvec.total() < 3) return;
+    cv::Mat r, t;
+    rvec.convertTo(r, CV_64F);
+    tvec.convertTo(t, CV_64F);
+    std::fprintf(f, "%.3f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f\n", tMs, r.at<double>(0), r.at<double>(1), r.at<double>(2),
+                 t.at<double>(0), t.at<double>(1), t.at<double>(2));
+    ++n;
+}
+
+void PoseLog::close() {
+    if (f) std::fclose(f);
+    f = nullptr;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <opencv2/core.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @file pose_source.hpp
+ * @brief Poses de la planche sans détection : trajectoire scriptée ou poses enregistrées
+ *        (CSV), pour mesurer le rendu seul (arcube --poses).
+ *
+ * @details
+ * Format CSV (PoseLog, loadPoseCsv) : une ligne par frame, "t_ms,rx,ry,rz,tx,ty,tz"
+ * (Rodrigues et translation en mètres, repère caméra OpenCV), précédée d'une ligne
+ * d'en-tête. Les poses enregistrées par arcube --save-poses sont celles utilisées pour
+ * le rendu (après lissage).
+ *
+ * La trajectoire scriptée ne dépend que du temps fourni : deux exécutions avec les mêmes
+ * temps rendent les mêmes images.
+ */
+
+/// @brief Une pose horodatée.
+struct PoseSample {
+    double tMs = 0.0;
+    cv::Vec3d r, t;
+};
+
+/// @brief Centre de rotation de scriptedPose() : centre de la feuille, repère de la planche (m).
+constexpr double SCRIPTED_POSE_CENTER[3] = { 0.065, 0.095, 0.0 };
+
+/**
+ * @brief Pose scriptée à l'instant tSec : feuille A4 face à la caméra, qui tourne sur
+ *        elle-même (un tour en 12 s), s'incline de ±15° et s'éloigne de 0.35 à 0.55 m.
+ * @param rvec (out) Rodrigues 3x1 CV_64F.
+ * @param tvec (out) Translation 3x1 CV_64F.
+ */
+void scriptedPose(double tSec, cv::Mat& rvec, cv::Mat& tvec);
+
+/// @brief Lit un CSV de poses. @return false si le fichier est absent ou ne contient aucune pose.
+bool loadPoseCsv(const std::string& path, std::vector<PoseSample>& out);
+
+/**
+ * @class PoseLog
+ * @brief Écrit les poses d'une session au format de loadPoseCsv().
+ */
+class PoseLog {
+public:
+    ~PoseLog();
+
+    bool open(const std::string& path);
+    void write(double tMs, const cv::Mat& rvec, const cv::Mat& tvec);
+    void close();
+
+    bool isOpen() const { return f != nullptr; }
+    int count() const { return n; }
+
+private:
+    std::FILE* f = nullptr;
+    int n = 0;
+};
@@ -0,0 +1,108 @@
+/**
+ * @file culling.cpp
+ * @brief Implémentation des bornes et du frustum culling.
+ */
+
+#include "culling.hpp"
+#include <cmath>
+#include <algorithm>
+
+MeshBounds computeBounds(const float* pos, size_t nVerts, size_t stride)
+{
+    MeshBounds b;
+    if (!pos || nVerts == 0) return b;
+
+    glm::vec3 mn(pos[0], pos[1], pos[2]);
+    glm::vec3 mx = mn;
+    for (size_t i = 1; i < nVerts; ++i) {
+        const float* p = pos + i * stride;
+        mn = glm::min(mn, glm::vec3(p[0], p[1], p[2]));
+        mx = glm::max(mx, glm::vec3(p[0], p[1], p[2]));
+    }
+
+    // Sphère centrée sur l'AABB, rayon = distance max réelle (plus serré que la demi-diagonale)
+    const glm::vec3 c = (mn + mx) * 0.5f;
+    float r2 = 0.0f;
+    for (size_t i = 0; i < nVerts; ++i) {
+        const float* p = pos + i * stride;
+        const glm::vec3 d = glm::vec3(p[0], p[1], p[2]) - c;
+        r2 = std::max(r2, glm::dot(d, d));
+    }
+
+    b.min = mn;
+    b.max = mx;
+    b.center = c;
+    b.radius = std::sqrt(r2);
+    return b;
+}
+
+glm::vec4 transformBounds(const MeshBounds& b, const glm::mat4& M, glm::vec3& outMin, glm::vec3& outMax)
+{
+    if (!b.valid()) {
+        outMin = outMax = glm::vec3(0.0f);
+        return glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+    }
+
+    // AABB monde (Arvo) : pour chaque axe, on cumule la contribution min/max de chaque colonne
+    const glm::vec3 t(M[3]);
+    outMin = t;
+    outMax = t;
+    for (int j = 0; j < 3; ++j) {
+        const glm::vec3 col(M[j]);
+        const glm::vec3 a = col * b.min[j];
+        const glm::vec3 c = col * b.max[j];
+        outMin += glm::min(a, c);
+        outMax += glm::max(a, c);
+    }
+
+    // Sphère monde : rayon multiplié par la plus grande échelle
+    const float sx = glm::length(glm::vec3(M[0]));
+    const float sy = glm::length(glm::vec3(M[1]));
+    const float sz = glm::length(glm::vec3(M[2]));
+    const glm::vec4 c = M * glm::vec4(b.center, 1.0f);
+    return glm::vec4(c.x, c.y, c.z, b.radius * std::max(sx, std::max(sy, sz)));
+}
+
+Frustum Frustum::fromMatrix(const glm::mat4& M)
+{
+    // Lignes de la matrice (GLM est column-major : M[col][row])
+    glm::vec4 r[4];
+    for (int i = 0; i < 4; ++i) r[i] = glm::vec4(M[0][i], M[1][i], M[2][i], M[3][i]);
+
+    Frustum f;
+    f.planes[0] = r[3] + r[0]; // gauche
+    f.planes[1] = r[3] - r[0]; // droite
+    f.planes[2] = r[3] + r[1]; // bas
+    f.planes[3] = r[3] - r[1]; // haut
+    f.planes[4] = r[3] + r[2]; // near
+    f.planes[5] = r[3] - r[2]; // far
+
+    for (auto& p : f.planes) {
+        const float len = glm::length(glm::vec3(p));
+        if (len > 0.0f) p /= len;
+    }
+    return f;
+}
+
+int Frustum::classifySphere(const glm::vec3& c, float r) const
+{
+    int result = 1;
+    for (const auto& p : planes) {
+        const float d = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+        if (d < -r) return -1;
+        if (d < r) result = 0;
+    }
+    return result;
+}
+
+bool Frustum::intersectsAABB(const glm::vec3& mn, const glm::vec3& mx) const
+{
+    for (const auto& p : planes) {
+        // Sommet le plus avancé dans la direction de la normale
+        const glm::vec3 v(p.x >= 0.0f ? mx.x : mn.x,
+                          p.y >= 0.0f ? mx.y : mn.y,
+                          p.z >= 0.0f ? mx.z : mn.z);
+        if (p.x * v.x + p.y * v.y + p.z * v.z + p.w < 0.0f) return false;
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <glm/glm.hpp>
+
+/**
+ * @file culling.hpp
+ * @brief Volumes englobants (AABB + sphère) et test de visibilité contre le frustum.
+ *
+ * @details
+ * Le frustum est extrait directement d'une matrice de projection combinée (méthode
+ * Gribb/Hartmann) : avec MVP = P * M_board * modelMaze, les plans obtenus sont exprimés
+ * dans le repère du labyrinthe, celui des bornes "monde" de SceneObjects.
+ */
+
+/**
+ * @struct MeshBounds
+ * @brief Bornes locales d'un maillage : AABB et sphère englobante.
+ * @note radius < 0 signifie "bornes inconnues" (l'objet n'est jamais rejeté).
+ */
+struct MeshBounds {
+    glm::vec3 min{0.0f};     ///< Coin minimal de l'AABB.
+    glm::vec3 max{0.0f};     ///< Coin maximal de l'AABB.
+    glm::vec3 center{0.0f};  ///< Centre de la sphère englobante.
+    float radius = -1.0f;    ///< Rayon de la sphère englobante (< 0 : invalide).
+
+    bool valid() const { return radius >= 0.0f; }
+};
+
+/**
+ * @brief Calcule AABB + sphère (centrée sur l'AABB) d'un tableau de positions xyz.
+ * @param pos Positions contiguës (3 floats par sommet).
+ * @param nVerts Nombre de sommets.
+ * @param stride Nombre de floats entre deux sommets (3 pour des positions seules).
+ */
+MeshBounds computeBounds(const float* pos, size_t nVerts, size_t stride = 3);
+
+/**
+ * @brief Transforme des bornes locales par une matrice modèle.
+ * @param b Bornes locales.
+ * @param M Matrice modèle (affine).
+ * @param outMin AABB monde (min).
+ * @param outMax AABB monde (max).
+ * @return Sphère monde (xyz = centre, w = rayon ; w < 0 si b invalide).
+ */
+glm::vec4 transformBounds(const MeshBounds& b, const glm::mat4& M, glm::vec3& outMin, glm::vec3& outMax);
+
+/**
+ * @struct Frustum
+ * @brief 6 plans (a,b,c,d) normalisés, normales vers l'intérieur.
+ */
+struct Frustum {
+    glm::vec4 planes[6];
+
+    /// @brief Extrait les plans d'une matrice de projection combinée (clip = M * p).
+    static Frustum fromMatrix(const glm::mat4& M);
+
+    /// @brief -1 : dehors, 0 : intersecte, 1 : entièrement dedans.
+    int classifySphere(const glm::vec3& c, float r) const;
+
+    /// @brief false si l'AABB est entièrement derrière un plan (test du sommet positif).
+    bool intersectsAABB(const glm::vec3& mn, const glm::vec3& mx) const;
+};
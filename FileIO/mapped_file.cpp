@@ -0,0 +1,111 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implémentation de MappedFile (POSIX mmap, MapViewOfFile sous Windows).
+ */
+
+#include "mapped_file.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& o) noexcept {
+    *this = std::move(o);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept {
+    if (this == &o) return *this;
+    close();
+    std::swap(ptr, o.ptr);
+    std::swap(len, o.len);
+    std::swap(opened, o.opened);
+#ifdef _WIN32
+    std::swap(fileHandle, o.fileHandle);
+    std::swap(mapHandle, o.mapHandle);
+#endif
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path, bool sequential) {
+    close();
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz)) { CloseHandle(f); return false; }
+
+    fileHandle = f;
+    len = (std::size_t)sz.QuadPart;
+    opened = true;
+    if (len == 0) return true;
+
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m) { close(); return false; }
+    mapHandle = m;
+
+    ptr = (const char*)MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (!ptr) { close(); return false; }
+    return true;
+}
+
+void MappedFile::close() {
+    if (ptr) UnmapViewOfFile(ptr);
+    if (mapHandle) CloseHandle((HANDLE)mapHandle);
+    if (fileHandle) CloseHandle((HANDLE)fileHandle);
+    ptr = nullptr;
+    mapHandle = fileHandle = nullptr;
+    len = 0;
+    opened = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path, bool sequential) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+
+    len = (std::size_t)st.st_size;
+    opened = true;
+    if (len > 0) {
+        void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            len = 0;
+            opened = false;
+            return false;
+        }
+        if (sequential) madvise(p, len, MADV_SEQUENTIAL);
+        ptr = (const char*)p;
+    }
+    ::close(fd); // la projection reste valide après fermeture du descripteur
+    return true;
+}
+
+void MappedFile::close() {
+    if (ptr) munmap((void*)ptr, len);
+    ptr = nullptr;
+    len = 0;
+    opened = false;
+}
+
+#endif
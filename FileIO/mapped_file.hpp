@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @file mapped_file.hpp
+ * @brief Fichier projeté en mémoire en lecture seule (mmap / MapViewOfFile).
+ *
+ * @details
+ * Évite la copie dans un buffer applicatif : les pages sont lues à la demande
+ * par le noyau et partagées avec le cache disque. Un fichier vide s'ouvre
+ * correctement (size() == 0, data() == nullptr).
+ */
+
+/**
+ * @class MappedFile
+ * @brief Projection mémoire d'un fichier entier (non copiable, déplaçable).
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept;
+    MappedFile& operator=(MappedFile&& o) noexcept;
+
+    /**
+     * @brief Projette le fichier en mémoire.
+     * @param path Chemin du fichier.
+     * @param sequential Indique au noyau une lecture séquentielle (lecture anticipée agressive).
+     * @return false si le fichier ne peut pas être ouvert ou projeté.
+     */
+    bool open(const std::string& path, bool sequential = true);
+
+    /// @brief Libère la projection.
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return ptr; }
+    std::size_t size() const { return len; }
+
+private:
+    const char* ptr = nullptr;
+    std::size_t len = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mapHandle = nullptr;
+#endif
+};
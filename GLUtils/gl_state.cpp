@@ -0,0 +1,69 @@
+/**
+ * @file gl_state.cpp
+ * @brief Implémentation du cache d'état OpenGL.
+ */
+
+#include "gl_state.hpp"
+
+GLStateCache& glState() {
+    static GLStateCache cache;
+    return cache;
+}
+
+void GLStateCache::beginFrame() {
+    counters = GLFrameCounters{};
+    invalidate();
+}
+
+void GLStateCache::invalidate() {
+    program = UNKNOWN;
+    vao = UNKNOWN;
+    activeUnit = -1;
+    for (int i = 0; i < MAX_UNITS; ++i) { textures[i] = UNKNOWN; targets[i] = 0; }
+    for (int i = 0; i < MAX_BINDINGS; ++i) uniformRanges[i] = RangeBinding{UNKNOWN, 0, 0};
+}
+
+void GLStateCache::useProgram(GLuint prog) {
+    if (enabled && prog == program) { counters.skipped++; return; }
+    glUseProgram(prog);
+    program = prog;
+    counters.programBinds++;
+}
+
+void GLStateCache::bindVertexArray(GLuint v) {
+    if (enabled && v == vao) { counters.skipped++; return; }
+    glBindVertexArray(v);
+    vao = v;
+    counters.vaoBinds++;
+}
+
+void GLStateCache::bindTexture(int unit, GLenum target, GLuint tex) {
+    if (unit < 0 || unit >= MAX_UNITS) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, tex);
+        activeUnit = unit;
+        counters.textureBinds += 2;
+        return;
+    }
+    if (enabled && textures[unit] == tex && targets[unit] == target) { counters.skipped++; return; }
+    if (!enabled || activeUnit != unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        activeUnit = unit;
+        counters.textureBinds++;
+    }
+    glBindTexture(target, tex);
+    textures[unit] = tex;
+    targets[unit] = target;
+    counters.textureBinds++;
+}
+
+void GLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buf, GLintptr offset, GLsizeiptr size) {
+    const bool tracked = (target == GL_UNIFORM_BUFFER && index < (GLuint)MAX_BINDINGS);
+    if (enabled && tracked) {
+        const RangeBinding& r = uniformRanges[index];
+        if (r.buf == buf && r.offset == offset && r.size == size) { counters.skipped++; return; }
+    }
+    glBindBufferRange(target, index, buf, offset, size);
+    if (tracked) uniformRanges[index] = RangeBinding{buf, offset, size};
+    counters.bufferBinds++;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <GL/glew.h>
+
+/**
+ * @file gl_state.hpp
+ * @brief Cache d'état OpenGL minimal : évite les glUseProgram / glBindVertexArray /
+ *        glBindTexture / glBindBufferRange redondants et compte les appels par frame.
+ *
+ * @details
+ * Le cache ne connaît que ce qui passe par lui. Règles d'usage :
+ *  - beginFrame() en début de frame : remet les compteurs à zéro et oublie l'état
+ *    (du code de chargement a pu binder directement entre deux frames) ;
+ *  - tout code qui binde directement pendant une frame doit appeler invalidate() ensuite.
+ * setEnabled(false) transmet tous les appels (mesure "avant/après").
+ */
+
+/**
+ * @struct GLFrameCounters
+ * @brief Appels GL d'une frame (émis réellement) et appels d'état évités.
+ */
+struct GLFrameCounters {
+    int programBinds = 0;  ///< glUseProgram émis.
+    int vaoBinds = 0;      ///< glBindVertexArray émis.
+    int textureBinds = 0;  ///< glActiveTexture + glBindTexture émis.
+    int bufferBinds = 0;   ///< glBindBufferBase / glBindBufferRange émis.
+    int uniforms = 0;      ///< glUniform* émis.
+    int uploads = 0;       ///< glBufferData / glBufferSubData émis.
+    int draws = 0;         ///< Appels de dessin émis.
+    int skipped = 0;       ///< Appels d'état redondants évités.
+
+    /// @brief Nombre total d'appels GL comptés.
+    int total() const { return programBinds + vaoBinds + textureBinds + bufferBinds + uniforms + uploads + draws; }
+};
+
+/**
+ * @class GLStateCache
+ * @brief Cache des bindings courants (programme, VAO, textures par unité, buffers indexés).
+ */
+class GLStateCache {
+public:
+    static constexpr int MAX_UNITS = 8;     ///< Unités de texture suivies.
+    static constexpr int MAX_BINDINGS = 8;  ///< Points de binding UBO suivis.
+
+    /// @brief Remet les compteurs à zéro et oublie l'état connu.
+    void beginFrame();
+    /// @brief Oublie l'état connu (après des binds directs hors cache).
+    void invalidate();
+    /// @brief Active / désactive le filtrage des appels redondants.
+    void setEnabled(bool on) { enabled = on; invalidate(); }
+    bool isEnabled() const { return enabled; }
+
+    void useProgram(GLuint prog);
+    void bindVertexArray(GLuint vao);
+    void bindTexture(int unit, GLenum target, GLuint tex);
+    void bindBufferRange(GLenum target, GLuint index, GLuint buf, GLintptr offset, GLsizeiptr size);
+
+    // Appels non filtrés, seulement comptés
+    void noteUniform(int n = 1) { counters.uniforms += n; }
+    void noteUpload(int n = 1) { counters.uploads += n; }
+    void noteDraw(int n = 1) { counters.draws += n; }
+
+    /// @brief Compteurs de la frame en cours.
+    const GLFrameCounters& frameCounters() const { return counters; }
+
+private:
+    static constexpr GLuint UNKNOWN = 0xFFFFFFFFu;
+
+    struct RangeBinding { GLuint buf; GLintptr offset; GLsizeiptr size; };
+
+    bool enabled = true;
+    GLuint program = UNKNOWN;
+    GLuint vao = UNKNOWN;
+    int activeUnit = -1;
+    GLuint textures[MAX_UNITS];
+    GLenum targets[MAX_UNITS];
+    RangeBinding uniformRanges[MAX_BINDINGS];
+    GLFrameCounters counters;
+};
+
+/// @brief Cache d'état du contexte principal (thread de rendu).
+GLStateCache& glState();
@@ -0,0 +1,192 @@
+/**
+ * @file gpu_timers.cpp
+ * @brief Implémentation des requêtes d'horodatage par passe et des fenêtres de mesures.
+ */
+
+#include "gpu_timers.hpp"
+#include <algorithm>
+#include <cstdio>
+
+void TimingWindow::add(double ms) {
+    if ((int)samples.size() < capacity) {
+        samples.push_back(ms);
+        return;
+    }
+    samples[next] = ms;
+    next = (next + 1) % samples.size();
+}
+
+TimingSummary TimingWindow::summary() const {
+    TimingSummary s;
+    s.samples = (int)samples.size();
+    if (samples.empty()) return s;
+    std::vector<double> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](double p) { return sorted[std::min(sorted.size() - 1, (std::size_t)(p * (sorted.size() - 1) + 0.5))]; };
+    double sum = 0.0;
+    for (double v : sorted) sum += v;
+    s.avg = sum / sorted.size();
+    s.p50 = pct(0.50);
+    s.p95 = pct(0.95);
+    s.p99 = pct(0.99);
+    s.max = sorted.back();
+    return s;
+}
+
+GpuTimers::~GpuTimers() {
+    destroy();
+}
+
+void GpuTimers::create() {
+    destroy();
+    if (!(GLEW_VERSION_3_3 || GLEW_ARB_timer_query)) return;
+    GLint bits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+    if (bits == 0) return; // horodatages non implémentés par le driver
+
+    queries.resize((std::size_t)RING * perSet());
+    glGenQueries((GLsizei)queries.size(), queries.data());
+    for (Set& s : sets) {
+        s.pending = false;
+        s.used.assign(MAX_PASSES, 0);
+    }
+    current = -1;
+    frameIdx = 0;
+    skipped = 0;
+}
+
+void GpuTimers::destroy() {
+    if (!queries.empty()) glDeleteQueries((GLsizei)queries.size(), queries.data());
+    queries.clear();
+    current = -1;
+}
+
+int GpuTimers::addPass(const std::string& name) {
+    if ((int)passes.size() >= MAX_PASSES) return -1;
+    passes.push_back(Pass{ name, TimingWindow() });
+    return (int)passes.size() - 1;
+}
+
+bool GpuTimers::collect(int set) {
+    Set& s = sets[set];
+    // Le dernier horodatage (fin de frame) est disponible en dernier
+    GLint ready = 0;
+    glGetQueryObjectiv(query(set, perSet() - 1), GL_QUERY_RESULT_AVAILABLE, &ready);
+    if (!ready) return false;
+
+    auto ts = [&](int i) {
+        GLuint64 v = 0;
+        glGetQueryObjectui64v(query(set, i), GL_QUERY_RESULT, &v);
+        return v;
+    };
+    for (int p = 0; p < (int)passes.size(); ++p) {
+        if (!s.used[p]) continue;
+        passes[p].window.add((double)(ts(2 * p + 1) - ts(2 * p)) * 1e-6);
+        s.used[p] = 0;
+    }
+    frame.add((double)(ts(perSet() - 1) - ts(perSet() - 2)) * 1e-6);
+    s.pending = false;
+    return true;
+}
+
+void GpuTimers::beginFrame() {
+    if (queries.empty()) return;
+    // Jeux des frames précédentes, du plus ancien au plus récent
+    for (int k = RING - 1; k >= 1; --k) {
+        const int set = (frameIdx - k + RING * 2) % RING;
+        if (sets[set].pending) collect(set);
+    }
+
+    const int set = frameIdx % RING;
+    ++frameIdx;
+    if (sets[set].pending && !collect(set)) {
+        current = -1; // GPU trop en retard : on ne bloque pas, la frame n'est pas mesurée
+        ++skipped;
+        return;
+    }
+    current = set;
+    glQueryCounter(query(set, perSet() - 2), GL_TIMESTAMP);
+}
+
+void GpuTimers::endFrame() {
+    if (current < 0) return;
+    glQueryCounter(query(current, perSet() - 1), GL_TIMESTAMP);
+    sets[current].pending = true;
+    current = -1;
+}
+
+void GpuTimers::begin(int pass) {
+    if (current < 0 || pass < 0) return;
+    glQueryCounter(query(current, 2 * pass), GL_TIMESTAMP);
+}
+
+void GpuTimers::end(int pass) {
+    if (current < 0 || pass < 0) return;
+    glQueryCounter(query(current, 2 * pass + 1), GL_TIMESTAMP);
+    sets[current].used[pass] = 1;
+}
+
+void drawGpuTimersOverlay(const GpuTimers& timers, int fbw, int fbh, double msFullScale) {
+    static const float palette[][3] = { { 0.90f, 0.30f, 0.25f }, { 0.25f, 0.75f, 0.30f }, { 0.25f, 0.50f, 0.95f },
+                                        { 0.95f, 0.80f, 0.20f }, { 0.70f, 0.35f, 0.90f }, { 0.20f, 0.85f, 0.85f } };
+    const int x0 = 10, barH = 8, gap = 4, fullW = std::min(300, fbw - 2 * x0);
+    if (fullW <= 0) return;
+
+    GLfloat clear[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clear);
+    glEnable(GL_SCISSOR_TEST);
+
+    auto bar = [&](int row, double ms, const float* rgb) {
+        const int y = fbh - 10 - (row + 1) * (barH + gap);
+        if (y < 0) return;
+        glScissor(x0, y, fullW, barH);
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        const int w = std::min(fullW, (int)(ms / msFullScale * fullW + 0.5));
+        if (w <= 0) return;
+        glScissor(x0, y, w, barH);
+        glClearColor(rgb[0], rgb[1], rgb[2], 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    };
+    const int n = sizeof(palette) / sizeof(palette[0]);
+    for (int p = 0; p < timers.passCount(); ++p) bar(p, timers.stats(p).summary().avg, palette[p % n]);
+    static const float white[3] = { 0.9f, 0.9f, 0.9f };
+    bar(timers.passCount(), timers.frameStats().summary().avg, white);
+
+    glDisable(GL_SCISSOR_TEST);
+    glClearColor(clear[0], clear[1], clear[2], clear[3]);
+}
+
+bool writeTimingsCsv(const std::string& path, const GpuTimers& timers,
+                     const std::vector<std::pair<std::string, const TimingWindow*>>& cpu) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fputs("mesure,source,echantillons,avg_ms,p50_ms,p95_ms,p99_ms,max_ms\n", f);
+    auto row = [&](const std::string& name, const char* source, const TimingWindow& w) {
+        const TimingSummary s = w.summary();
+        std::fprintf(f, "%s,%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f\n", name.c_str(), source, s.samples, s.avg, s.p50,
+                     s.p95, s.p99, s.max);
+    };
+    for (int p = 0; p < timers.passCount(); ++p) row(timers.passName(p), "gpu", timers.stats(p));
+    row("frame", "gpu", timers.frameStats());
+    for (const auto& c : cpu) row(c.first, "cpu", *c.second);
+    return std::fclose(f) == 0;
+}
+
+void reportTimings(std::ostream& os, const GpuTimers& timers,
+                   const std::vector<std::pair<std::string, const TimingWindow*>>& cpu) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-16s %-6s %6s %9s %9s %9s %9s %9s\n", "mesure (ms)", "source", "n", "avg",
+                  "p50", "p95", "p99", "max");
+    os << line;
+    auto row = [&](const std::string& name, const char* source, const TimingWindow& w) {
+        const TimingSummary s = w.summary();
+        if (s.samples == 0) return;
+        std::snprintf(line, sizeof(line), "  %-16s %-6s %6d %9.3f %9.3f %9.3f %9.3f %9.3f\n", name.c_str(), source,
+                      s.samples, s.avg, s.p50, s.p95, s.p99, s.max);
+        os << line;
+    };
+    for (int p = 0; p < timers.passCount(); ++p) row(timers.passName(p), "gpu", timers.stats(p));
+    row("frame", "gpu", timers.frameStats());
+    for (const auto& c : cpu) row(c.first, "cpu", *c.second);
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <GL/glew.h>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file gpu_timers.hpp
+ * @brief Temps GPU par passe de rendu (requêtes GL_TIMESTAMP relues quelques frames plus
+ *        tard, jamais d'attente) et statistiques glissantes (moyenne, percentiles).
+ *
+ * @details
+ * Chaque passe pose deux horodatages (glQueryCounter, GL 3.3 / ARB_timer_query, disponibles
+ * sous Mesa llvmpipe) : les passes peuvent se suivre ou s'imbriquer, contrairement à
+ * GL_TIME_ELAPSED. Les requêtes d'une frame forment un jeu ; RING jeux tournent. beginFrame()
+ * relit les jeux dont tous les résultats sont disponibles (GL_QUERY_RESULT_AVAILABLE) ; si
+ * le jeu à réutiliser n'est pas encore prêt, la frame n'est simplement pas mesurée.
+ *
+ * Usage :
+ * @code
+ * const int passBG = timers.addPass("background");
+ * timers.beginFrame();
+ * timers.begin(passBG); ... draws ... timers.end(passBG);
+ * timers.endFrame();
+ * timers.stats(passBG).summary().avg;   // ms
+ * @endcode
+ */
+
+/**
+ * @struct TimingSummary
+ * @brief Résumé d'une fenêtre d'échantillons (millisecondes).
+ */
+struct TimingSummary {
+    int samples = 0;
+    double avg = 0.0, p50 = 0.0, p95 = 0.0, p99 = 0.0, max = 0.0;
+};
+
+/**
+ * @class TimingWindow
+ * @brief Derniers N échantillons d'une mesure (CPU ou GPU), en millisecondes.
+ */
+class TimingWindow {
+public:
+    explicit TimingWindow(int capacity = 240) : capacity(capacity) {}
+
+    void add(double ms);
+    /// @brief Moyenne et percentiles de la fenêtre (tri d'une copie).
+    TimingSummary summary() const;
+    /// @brief Dernier échantillon (0 si aucun).
+    double last() const { return samples.empty() ? 0.0 : samples[(next + samples.size() - 1) % samples.size()]; }
+
+private:
+    int capacity;
+    std::vector<double> samples;
+    std::size_t next = 0; ///< Prochaine case écrasée une fois la fenêtre pleine.
+};
+
+/**
+ * @class GpuTimers
+ * @brief Anneau de requêtes d'horodatage par passe.
+ * @warning Contexte OpenGL actif requis (create / destroy / begin / end).
+ */
+class GpuTimers {
+public:
+    static constexpr int RING = 4;       ///< Jeux de requêtes (latence de relecture max).
+    static constexpr int MAX_PASSES = 16;
+
+    ~GpuTimers();
+
+    /// @brief Crée les requêtes. Sans ARB_timer_query, reste inactif (supported() == false).
+    void create();
+    void destroy();
+    bool supported() const { return !queries.empty(); }
+
+    /// @brief Déclare une passe (avant la première frame). @return Indice de la passe, -1 si plein.
+    int addPass(const std::string& name);
+    int passCount() const { return (int)passes.size(); }
+    const std::string& passName(int pass) const { return passes[pass].name; }
+
+    /// @brief Relit les jeux terminés, puis ouvre celui de la frame (horodatage de début).
+    void beginFrame();
+    /// @brief Horodatage de fin de frame (stats frameStats()).
+    void endFrame();
+
+    void begin(int pass);
+    void end(int pass);
+
+    const TimingWindow& stats(int pass) const { return passes[pass].window; }
+    /// @brief Temps GPU du premier au dernier horodatage de la frame.
+    const TimingWindow& frameStats() const { return frame; }
+    /// @brief Frames non mesurées faute de jeu libre (GPU plus de RING frames en retard).
+    int skippedFrames() const { return skipped; }
+
+private:
+    struct Pass {
+        std::string name;
+        TimingWindow window;
+    };
+    /// @brief Requêtes d'une frame : [2 * passe] début, [2 * passe + 1] fin, puis début / fin de frame.
+    struct Set {
+        bool pending = false;
+        std::vector<char> used; ///< Passe mesurée dans cette frame.
+    };
+
+    GLuint query(int set, int index) const { return queries[set * perSet() + index]; }
+    int perSet() const { return 2 * MAX_PASSES + 2; }
+    bool collect(int set);
+
+    std::vector<GLuint> queries;
+    std::vector<Pass> passes;
+    Set sets[RING];
+    TimingWindow frame;
+    int current = -1;   ///< Jeu de la frame en cours (-1 : frame non mesurée).
+    int frameIdx = 0;
+    int skipped = 0;
+};
+
+/**
+ * @brief Overlay en haut à gauche : une barre par passe (moyenne glissante, msFullScale = 300 px)
+ *        puis la frame GPU, en glScissor + glClear (aucun shader ni état de pipeline touché).
+ * @details Ordre et couleurs des barres fixes ; les valeurs exactes sont dans le CSV / le titre.
+ */
+void drawGpuTimersOverlay(const GpuTimers& timers, int fbw, int fbh, double msFullScale = 16.67);
+
+/**
+ * @brief Écrit un CSV "mesure,source,echantillons,avg_ms,p50_ms,p95_ms,p99_ms,max_ms" :
+ *        les passes GPU et la frame GPU de timers, puis les fenêtres CPU fournies.
+ */
+bool writeTimingsCsv(const std::string& path, const GpuTimers& timers,
+                     const std::vector<std::pair<std::string, const TimingWindow*>>& cpu);
+
+/**
+ * @brief Même contenu que writeTimingsCsv() en tableau lisible (passes sans mesure omises).
+ */
+void reportTimings(std::ostream& os, const GpuTimers& timers,
+                   const std::vector<std::pair<std::string, const TimingWindow*>>& cpu);
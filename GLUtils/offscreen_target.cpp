@@ -0,0 +1,64 @@
+/**
+ * @file offscreen_target.cpp
+ * @brief Implémentation de la cible de rendu hors écran.
+ */
+
+#include "offscreen_target.hpp"
+#include <iostream>
+
+OffscreenTarget::~OffscreenTarget() {
+    destroy();
+}
+
+bool OffscreenTarget::create(int width, int height) {
+    destroy();
+    w = width;
+    h = height;
+
+    glGenRenderbuffers(1, &color);
+    glBindRenderbuffer(GL_RENDERBUFFER, color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glGenRenderbuffers(1, &depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "[offscreen] FBO " << w << "x" << h << " incomplet (0x" << std::hex << status << std::dec << ")\n";
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void OffscreenTarget::destroy() {
+    if (fbo) glDeleteFramebuffers(1, &fbo);
+    if (color) glDeleteRenderbuffers(1, &color);
+    if (depth) glDeleteRenderbuffers(1, &depth);
+    fbo = color = depth = 0;
+}
+
+void OffscreenTarget::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+void OffscreenTarget::unbind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+bool OffscreenTarget::readRGBA(std::vector<unsigned char>& rgba) const {
+    if (!fbo) return false;
+    rgba.resize((size_t)w * h * 4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return glGetError() == GL_NO_ERROR;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <GL/glew.h>
+#include <vector>
+
+/**
+ * @file offscreen_target.hpp
+ * @brief Cible de rendu hors écran (FBO couleur RGBA8 + profondeur/stencil 24/8).
+ *
+ * @details
+ * Sert au mode --offscreen d'arcube : la frame est rendue dans le FBO au lieu du
+ * framebuffer par défaut de la fenêtre (invisible, sans vsync), ce qui rend la mesure
+ * indépendante de la composition et de l'affichage. Les renderbuffers ne sont jamais
+ * relus pendant la boucle ; readRGBA() est réservé à une capture ponctuelle.
+ *
+ * Le framebuffer lié n'est pas suivi par GLStateCache : bind() / unbind() appellent
+ * glBindFramebuffer directement.
+ */
+class OffscreenTarget {
+public:
+    ~OffscreenTarget();
+
+    /// @brief Crée (ou recrée) le FBO. @return false si incomplet (message sur stderr).
+    bool create(int width, int height);
+    void destroy();
+
+    void bind() const;
+    /// @brief Revient au framebuffer par défaut.
+    static void unbind();
+
+    bool isCreated() const { return fbo != 0; }
+    int width() const { return w; }
+    int height() const { return h; }
+
+    /**
+     * @brief Relit la couleur (bloquant : attend la fin du rendu).
+     * @param rgba (out) w * h * 4 octets, première ligne = bas de l'image (convention GL).
+     */
+    bool readRGBA(std::vector<unsigned char>& rgba) const;
+
+private:
+    GLuint fbo = 0;
+    GLuint color = 0;
+    GLuint depth = 0;
+    int w = 0, h = 0;
+};
@@ -0,0 +1,160 @@
+/**
+ * @file stream_buffer.cpp
+ * @brief Implémentation de l'anneau de streaming (persistant / map non synchronisé).
+ */
+
+#include "stream_buffer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+GLintptr alignUp(GLintptr v, GLsizeiptr a) { return (v + a - 1) / a * a; }
+
+} // namespace
+
+StreamBuffer& frameStream() {
+    static StreamBuffer stream;
+    return stream;
+}
+
+StreamBuffer::~StreamBuffer() {
+    destroy();
+}
+
+void StreamBuffer::create(GLsizeiptr bytesPerFrame, bool allowPersistent) {
+    destroy();
+    usePersistent = allowPersistent;
+    allocate(std::max<GLsizeiptr>(bytesPerFrame, 256));
+    frame = 0;
+    cursor = 0;
+    st = StreamStats{};
+}
+
+void StreamBuffer::allocate(GLsizeiptr bytesPerFrame) {
+    region = bytesPerFrame;
+    const GLsizeiptr total = region * FRAMES;
+    glGenBuffers(1, &buf);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buf);
+    if (usePersistent && (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage)) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, total, nullptr, flags);
+        mapped = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, total, flags);
+    }
+    if (!mapped) glBufferData(GL_COPY_WRITE_BUFFER, total, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void StreamBuffer::destroy() {
+    unmap();
+    for (GLsync& f : fences) {
+        if (f) glDeleteSync(f);
+        f = nullptr;
+    }
+    if (buf) {
+        if (mapped) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buf);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buf);
+    }
+    for (const auto& r : retired) glDeleteBuffers(1, &r.first);
+    retired.clear();
+    buf = 0;
+    mapped = nullptr;
+    region = 0;
+}
+
+void StreamBuffer::beginFrame() {
+    frame = (frame + 1) % FRAMES;
+    cursor = 0;
+    st.frames++;
+
+    GLsync& f = fences[frame];
+    if (f) {
+        // Attente non bloquante d'abord : le cas normal (GPU en avance de FRAMES-1 frames)
+        GLenum r = glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (r == GL_TIMEOUT_EXPIRED) {
+            const auto t0 = std::chrono::steady_clock::now();
+            do r = glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+            while (r == GL_TIMEOUT_EXPIRED);
+            st.stalls++;
+            st.stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        }
+        glDeleteSync(f);
+        f = nullptr;
+    }
+
+    // Buffers remplacés : la fence attendue ci-dessus couvre la dernière frame qui les lisait
+    for (std::size_t i = 0; i < retired.size();) {
+        if (--retired[i].second > 0) { ++i; continue; }
+        glDeleteBuffers(1, &retired[i].first);
+        retired[i] = retired.back();
+        retired.pop_back();
+    }
+}
+
+void StreamBuffer::endFrame() {
+    unmap();
+    if (fences[frame]) glDeleteSync(fences[frame]);
+    fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+StreamAlloc StreamBuffer::alloc(GLsizeiptr bytes, GLsizeiptr align) {
+    StreamAlloc a;
+    if (!buf || bytes <= 0) return a;
+    unmap();
+
+    GLintptr local = alignUp(cursor, align);
+    if (local + bytes > region) {
+        // Région trop petite : nouveau buffer (les plages déjà rendues restent lisibles)
+        if (mapped) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buf);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            mapped = nullptr;
+        }
+        retired.emplace_back(buf, FRAMES);
+        for (GLsync& f : fences) {
+            if (f) glDeleteSync(f);
+            f = nullptr;
+        }
+        allocate(std::max(region * 2, alignUp(bytes, align) * 2));
+        st.grows++;
+        local = 0;
+    }
+
+    const GLintptr offset = (GLintptr)frame * region + local;
+    cursor = local + bytes;
+    st.bytes += (std::size_t)bytes;
+
+    a.buffer = buf;
+    a.offset = offset;
+    if (mapped) {
+        a.ptr = mapped + offset;
+    } else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buf);
+        a.ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, bytes,
+                                 GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        pendingUnmap = a.ptr != nullptr;
+    }
+    return a;
+}
+
+void StreamBuffer::unmap() {
+    if (!pendingUnmap) return;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buf);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    pendingUnmap = false;
+}
+
+StreamAlloc StreamBuffer::write(const void* data, GLsizeiptr bytes, GLsizeiptr align) {
+    StreamAlloc a = alloc(bytes, align);
+    if (a.ptr) std::memcpy(a.ptr, data, (std::size_t)bytes);
+    unmap();
+    return a;
+}
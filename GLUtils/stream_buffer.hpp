@@ -0,0 +1,118 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @file stream_buffer.hpp
+ * @brief Anneau de streaming pour les données dynamiques de chaque frame (blocs uniformes,
+ *        instances de lignes...) : un buffer découpé en FRAMES régions protégées par fences.
+ *
+ * @details
+ * La frame N écrit dans la région N % FRAMES pendant que le GPU lit encore les deux
+ * précédentes ; beginFrame() n'attend que la fence posée par endFrame() FRAMES frames plus
+ * tôt (en pratique déjà passée : pas d'attente).
+ *  - ARB_buffer_storage (GL 4.4, disponible sous Mesa) : glBufferStorage + une projection
+ *    persistante et cohérente, faite une fois. alloc() rend un pointeur d'écriture direct.
+ *  - Sinon : glMapBufferRange(UNSYNCHRONIZED | INVALIDATE_RANGE) sur la plage allouée,
+ *    démappée par unmap() ; les fences garantissent que la plage n'est plus lue.
+ * Contrairement à glBufferData(NULL) + glBufferSubData (orphelinage), aucun driver n'a à
+ * réallouer ni à attendre.
+ *
+ * Si une frame dépasse sa région, le buffer est recréé deux fois plus grand (les
+ * allocations déjà faites restent valides dans l'ancien, que GL libère après usage) :
+ * toujours utiliser StreamAlloc::buffer, pas seulement buffer().
+ *
+ * Usage :
+ * @code
+ * frameStream().beginFrame();
+ * StreamAlloc a = frameStream().alloc(bytes, 16);
+ * std::memcpy(a.ptr, data, bytes); frameStream().unmap();
+ * glBindBufferRange(GL_UNIFORM_BUFFER, 1, a.buffer, a.offset, bytes);
+ * ... draws ...
+ * frameStream().endFrame();
+ * @endcode
+ */
+
+/**
+ * @struct StreamAlloc
+ * @brief Plage allouée dans la région de la frame.
+ */
+struct StreamAlloc {
+    void* ptr = nullptr;  ///< Destination des écritures (nullptr si échec).
+    GLuint buffer = 0;    ///< Buffer GL contenant la plage.
+    GLintptr offset = 0;  ///< Offset de la plage dans ce buffer.
+};
+
+/**
+ * @struct StreamStats
+ * @brief Compteurs cumulés depuis create() (ou resetStats()).
+ */
+struct StreamStats {
+    std::size_t bytes = 0;     ///< Octets alloués.
+    int frames = 0;
+    int stalls = 0;            ///< beginFrame() ayant dû attendre une fence.
+    double stallMs = 0.0;      ///< Temps CPU passé à attendre.
+    int grows = 0;             ///< Recréations (région trop petite).
+};
+
+/**
+ * @class StreamBuffer
+ * @brief Buffer de streaming triple (persistant si possible, sinon map non synchronisé).
+ * @warning Contexte OpenGL actif requis.
+ */
+class StreamBuffer {
+public:
+    static constexpr int FRAMES = 3;
+
+    ~StreamBuffer();
+
+    /**
+     * @brief Crée le buffer (FRAMES régions de bytesPerFrame octets).
+     * @param allowPersistent false : force le repli glMapBufferRange (mesure, drivers fautifs).
+     */
+    void create(GLsizeiptr bytesPerFrame, bool allowPersistent = true);
+    void destroy();
+
+    bool isCreated() const { return buf != 0; }
+    bool persistent() const { return mapped != nullptr; }
+    GLuint buffer() const { return buf; }
+    GLsizeiptr regionBytes() const { return region; }
+
+    /// @brief Passe à la région suivante ; attend sa fence si le GPU la lit encore.
+    void beginFrame();
+    /// @brief Pose la fence de la région (après le dernier draw qui la lit).
+    void endFrame();
+
+    /**
+     * @brief Réserve bytes octets (offset multiple de align) dans la région courante.
+     * @details Repli non persistant : la plage reste mappée jusqu'à unmap() (une seule à la fois).
+     */
+    StreamAlloc alloc(GLsizeiptr bytes, GLsizeiptr align = 16);
+    /// @brief Termine les écritures de la dernière alloc() (sans effet en mode persistant).
+    void unmap();
+
+    /// @brief alloc() + copie + unmap().
+    StreamAlloc write(const void* data, GLsizeiptr bytes, GLsizeiptr align = 16);
+
+    const StreamStats& stats() const { return st; }
+    void resetStats() { st = StreamStats{}; }
+
+private:
+    void allocate(GLsizeiptr bytesPerFrame);
+
+    GLuint buf = 0;
+    GLsizeiptr region = 0;
+    char* mapped = nullptr;     ///< Projection persistante (nullptr en repli).
+    bool usePersistent = true;
+    bool pendingUnmap = false;
+    int frame = 0;              ///< Région courante.
+    GLsizeiptr cursor = 0;      ///< Octets utilisés dans la région courante.
+    GLsync fences[FRAMES] = {};
+    std::vector<std::pair<GLuint, int>> retired; ///< Buffers remplacés, supprimés après FRAMES frames.
+    StreamStats st;
+};
+
+/// @brief Anneau partagé des données par frame (UniformBuffers, LineBatch) ; à créer par l'application.
+StreamBuffer& frameStream();
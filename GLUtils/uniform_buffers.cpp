@@ -0,0 +1,121 @@
+/**
+ * @file uniform_buffers.cpp
+ * @brief Implémentation des UBO Camera / Object.
+ */
+
+#include "uniform_buffers.hpp"
+#include "gl_state.hpp"
+#include "stream_buffer.hpp"
+#include <cstring>
+#include <algorithm>
+
+static_assert(sizeof(CameraBlock) == 144, "CameraBlock doit respecter std140");
+static_assert(sizeof(ObjectBlock) == 96, "ObjectBlock doit respecter std140");
+
+UniformBuffers::~UniformBuffers() {
+    destroy();
+}
+
+void UniformBuffers::create(int maxObjects) {
+    destroy();
+
+    GLint align = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+    align = std::max(align, 16);
+    uboAlign = align;
+    objectStride = ((GLsizeiptr)sizeof(ObjectBlock) + align - 1) / align * align;
+
+    glGenBuffers(1, &cameraUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUbo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), nullptr, GL_DYNAMIC_DRAW);
+
+    objectCapacity = std::max(1, maxObjects);
+    glGenBuffers(1, &objectUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, objectUbo);
+    glBufferData(GL_UNIFORM_BUFFER, objectStride * objectCapacity, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    objectBuffer = objectUbo;
+    objectBase = 0;
+
+    objects.reserve(objectCapacity);
+}
+
+void UniformBuffers::destroy() {
+    if (cameraUbo) glDeleteBuffers(1, &cameraUbo);
+    if (objectUbo) glDeleteBuffers(1, &objectUbo);
+    cameraUbo = objectUbo = objectBuffer = 0;
+    objectBase = 0;
+    objectCapacity = 0;
+    objects.clear();
+}
+
+void UniformBuffers::bindBlocks(GLuint prog) {
+    GLuint cam = glGetUniformBlockIndex(prog, "Camera");
+    if (cam != GL_INVALID_INDEX) glUniformBlockBinding(prog, cam, CAMERA_BINDING);
+    GLuint obj = glGetUniformBlockIndex(prog, "Object");
+    if (obj != GL_INVALID_INDEX) glUniformBlockBinding(prog, obj, OBJECT_BINDING);
+}
+
+void UniformBuffers::setCamera(const glm::mat4& P, const glm::mat4& V, float width, float height) {
+    CameraBlock cb;
+    cb.P = P;
+    cb.V = V;
+    cb.viewport = glm::vec4(width, height, 1.0f / std::max(width, 1.0f), 1.0f / std::max(height, 1.0f));
+
+    if (frameStream().isCreated()) {
+        const StreamAlloc a = frameStream().write(&cb, sizeof(CameraBlock), uboAlign);
+        if (a.ptr) {
+            glState().bindBufferRange(GL_UNIFORM_BUFFER, CAMERA_BINDING, a.buffer, a.offset, sizeof(CameraBlock));
+            return;
+        }
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUbo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &cb);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glState().noteUpload();
+    glState().bindBufferRange(GL_UNIFORM_BUFFER, CAMERA_BINDING, cameraUbo, 0, sizeof(CameraBlock));
+}
+
+int UniformBuffers::pushObject(const glm::mat4& model, const glm::vec4& color, const glm::vec4& params) {
+    objects.push_back(ObjectBlock{model, color, params});
+    return (int)objects.size() - 1;
+}
+
+void UniformBuffers::uploadObjects() {
+    if (objects.empty()) return;
+
+    // Anneau de la frame : objets écrits directement à leur place, sans copie intermédiaire
+    if (frameStream().isCreated()) {
+        const StreamAlloc a = frameStream().alloc(objectStride * (GLsizeiptr)objects.size(), uboAlign);
+        if (a.ptr) {
+            for (size_t i = 0; i < objects.size(); ++i)
+                std::memcpy((char*)a.ptr + i * objectStride, &objects[i], sizeof(ObjectBlock));
+            frameStream().unmap();
+            objectBuffer = a.buffer;
+            objectBase = a.offset;
+            return;
+        }
+    }
+
+    objectBuffer = objectUbo;
+    objectBase = 0;
+    glBindBuffer(GL_UNIFORM_BUFFER, objectUbo);
+    if ((int)objects.size() > objectCapacity) {
+        objectCapacity = std::max((int)objects.size(), objectCapacity * 2);
+        glBufferData(GL_UNIFORM_BUFFER, objectStride * objectCapacity, nullptr, GL_DYNAMIC_DRAW);
+        glState().invalidate(); // les ranges liés pointent sur l'ancien stockage
+    }
+
+    staging.resize((size_t)objectStride * objects.size());
+    for (size_t i = 0; i < objects.size(); ++i)
+        std::memcpy(staging.data() + i * objectStride, &objects[i], sizeof(ObjectBlock));
+
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, (GLsizeiptr)staging.size(), staging.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glState().noteUpload();
+}
+
+void UniformBuffers::bindObject(int slot) {
+    glState().bindBufferRange(GL_UNIFORM_BUFFER, OBJECT_BINDING, objectBuffer,
+                              objectBase + (GLintptr)slot * objectStride, sizeof(ObjectBlock));
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file uniform_buffers.hpp
+ * @brief Uniform buffers partagés : bloc caméra par frame + blocs objet indexés par offset.
+ *
+ * @details
+ * Blocs std140 déclarés par les shaders (voir shaders.cpp) :
+ * @code
+ * layout(std140) uniform Camera { mat4 uP; mat4 uV; vec4 uViewport; };          // binding 0
+ * layout(std140) uniform Object { mat4 uModel; vec4 uColor; vec4 uParams; };    // binding 1
+ * @endcode
+ * - Camera : écrit une fois par frame, lu par tous les programmes qui le déclarent.
+ * - Object : tous les objets de la frame sont écrits dans un seul buffer (un upload),
+ *   puis chaque draw sélectionne le sien par glBindBufferRange (offset aligné sur
+ *   GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT).
+ * Si frameStream() est créé (stream_buffer.hpp), les deux blocs sont écrits directement
+ * dans la région de la frame de l'anneau ; sinon dans des UBO propres (glBufferSubData).
+ */
+
+/// @brief Layout std140 du bloc Camera.
+struct CameraBlock {
+    glm::mat4 P{1.0f};        ///< Projection.
+    glm::mat4 V{1.0f};        ///< Vue (board -> caméra, repère GL).
+    glm::vec4 viewport{0.0f}; ///< (largeur, hauteur, 1/largeur, 1/hauteur) en pixels.
+};
+
+/// @brief Layout std140 du bloc Object.
+struct ObjectBlock {
+    glm::mat4 model{1.0f};    ///< Matrice modèle (repère board).
+    glm::vec4 color{1.0f};    ///< Couleur RGBA.
+    glm::vec4 params{0.0f};   ///< Paramètres libres (x = épaisseur des lignes en pixels).
+};
+
+/**
+ * @class UniformBuffers
+ * @brief Gestion des UBO Camera (binding 0) et Object (binding 1).
+ */
+class UniformBuffers {
+public:
+    static constexpr GLuint CAMERA_BINDING = 0;
+    static constexpr GLuint OBJECT_BINDING = 1;
+
+    ~UniformBuffers();
+
+    /// @brief Crée les buffers (contexte requis). maxObjects grandit si besoin.
+    void create(int maxObjects = 16);
+    void destroy();
+
+    /// @brief Relie les blocs "Camera"/"Object" d'un programme à leurs points de binding.
+    static void bindBlocks(GLuint prog);
+
+    /// @brief Écrit le bloc caméra et le lie au binding 0.
+    void setCamera(const glm::mat4& P, const glm::mat4& V, float width, float height);
+
+    /// @brief Vide la liste des objets de la frame.
+    void beginObjects() { objects.clear(); }
+    /// @brief Ajoute un objet ; renvoie son slot (à passer à bindObject()).
+    int pushObject(const glm::mat4& model, const glm::vec4& color, const glm::vec4& params = glm::vec4(0.0f));
+    /// @brief Envoie tous les objets de la frame en un seul upload.
+    void uploadObjects();
+    /// @brief Sélectionne le bloc objet d'un slot (binding 1).
+    void bindObject(int slot);
+
+private:
+    GLuint cameraUbo = 0;
+    GLuint objectUbo = 0;
+    GLsizeiptr uboAlign = 256;    ///< GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+    GLsizeiptr objectStride = 0;  ///< sizeof(ObjectBlock) arrondi à l'alignement d'offset.
+    GLuint objectBuffer = 0;      ///< Buffer des objets de la frame (objectUbo ou anneau).
+    GLintptr objectBase = 0;      ///< Offset du slot 0 dans objectBuffer.
+    int objectCapacity = 0;
+    std::vector<ObjectBlock> objects;
+    std::vector<uint8_t> staging; ///< Objets espacés de objectStride.
+};
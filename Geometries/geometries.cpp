@@ -12,6 +12,7 @@
  #include <cmath>
  
  #include "geometries.hpp"
+ #include "MeshOptimizer/mesh_optimizer.hpp"
  
  // IMPORTANT : on inclut ball.h ici pour connaître la structure Maze
  // (Maze est défini chez toi dans ce header)
@@ -90,7 +91,7 @@
          -0.5f,-0.5f,-0.5f,  +0.5f,-0.5f,-0.5f,  +0.5f,+0.5f,-0.5f,  -0.5f,+0.5f,-0.5f,
          -0.5f,-0.5f,+0.5f,  +0.5f,-0.5f,+0.5f,  +0.5f,+0.5f,+0.5f,  -0.5f,+0.5f,+0.5f
      };
-     const GLuint I[] = {
+     const GLushort I[] = {
          0,1,2,  0,2,3,      // face -Z
          4,6,5,  4,7,6,      // face +Z
          0,3,7,  0,7,4,      // face -X
@@ -99,6 +100,7 @@
          3,2,6,  3,6,7       // face +Y
      };
      Mesh m; m.count = (GLsizei)(sizeof(I)/sizeof(I[0]));
+     m.indexType = GL_UNSIGNED_SHORT;
      glGenVertexArrays(1,&m.vao);
      glGenBuffers(1,&m.vbo);
      glGenBuffers(1,&m.ebo);
@@ -127,6 +129,106 @@
      m = {};
  }
  
+ // ------------------------------------------------------------
+ // Indices : 16 bits si les sommets le permettent (moitié moins de bande passante)
+ // ------------------------------------------------------------
+ static void uploadIndices(Mesh& m, const uint32_t* idx, size_t indexCount, size_t vertexCount){
+     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
+     if (vertexCount <= 65536) {
+         std::vector<uint16_t> I16(idx, idx + indexCount);
+         glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount*sizeof(uint16_t), I16.data(), GL_STATIC_DRAW);
+         m.indexType = GL_UNSIGNED_SHORT;
+     } else {
+         glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount*sizeof(uint32_t), idx, GL_STATIC_DRAW);
+         m.indexType = GL_UNSIGNED_INT;
+     }
+ }
+
+ // ------------------------------------------------------------
+ // Upload CPU -> VAO/VBO/EBO (positions xyz + indices)
+ // ------------------------------------------------------------
+ Mesh uploadMeshData(const MeshData& d){
+     return uploadMesh(d.pos.data(), d.pos.size() / 3, d.idx.data(), d.idx.size());
+ }
+
+ Mesh uploadMesh(const float* pos, size_t vertexCount, const uint32_t* idx, size_t indexCount){
+     Mesh m{};
+     m.count = (GLsizei)indexCount;
+ 
+     glGenVertexArrays(1,&m.vao);
+     glGenBuffers(1,&m.vbo);
+     glGenBuffers(1,&m.ebo);
+ 
+     glBindVertexArray(m.vao);
+ 
+     glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+     glBufferData(GL_ARRAY_BUFFER, vertexCount*3*sizeof(float), pos, GL_STATIC_DRAW);
+ 
+     uploadIndices(m, idx, indexCount, vertexCount);
+ 
+     glEnableVertexAttribArray(0);
+     glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,3*sizeof(float),(void*)0);
+ 
+     glBindVertexArray(0);
+     return m;
+ }
+ 
+ Mesh uploadMeshPNT(const float* pnt, size_t vertexCount, const uint32_t* idx, size_t indexCount){
+     Mesh m{};
+     m.count = (GLsizei)indexCount;
+ 
+     glGenVertexArrays(1,&m.vao);
+     glGenBuffers(1,&m.vbo);
+     glGenBuffers(1,&m.ebo);
+ 
+     glBindVertexArray(m.vao);
+ 
+     const GLsizei stride = 8*sizeof(float);
+     glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+     glBufferData(GL_ARRAY_BUFFER, vertexCount*stride, pnt, GL_STATIC_DRAW);
+ 
+     uploadIndices(m, idx, indexCount, vertexCount);
+ 
+     glEnableVertexAttribArray(0);
+     glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,stride,(void*)0);
+     glEnableVertexAttribArray(1);
+     glVertexAttribPointer(1,3,GL_FLOAT,GL_FALSE,stride,(void*)(3*sizeof(float)));
+     glEnableVertexAttribArray(2);
+     glVertexAttribPointer(2,2,GL_FLOAT,GL_FALSE,stride,(void*)(6*sizeof(float)));
+ 
+     glBindVertexArray(0);
+     return m;
+ }
+
+ Mesh uploadMeshQuantized(const void* vertices, size_t vertexCount, const uint32_t* idx, size_t indexCount,
+                          const float posScale[3], const float posOffset[3]){
+     Mesh m{};
+     m.count = (GLsizei)indexCount;
+     for (int k = 0; k < 3; ++k) { m.posScale[k] = posScale[k]; m.posOffset[k] = posOffset[k]; }
+ 
+     glGenVertexArrays(1,&m.vao);
+     glGenBuffers(1,&m.vbo);
+     glGenBuffers(1,&m.ebo);
+ 
+     glBindVertexArray(m.vao);
+ 
+     const GLsizei stride = sizeof(QuantizedVertex);
+     glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+     glBufferData(GL_ARRAY_BUFFER, vertexCount*stride, vertices, GL_STATIC_DRAW);
+ 
+     uploadIndices(m, idx, indexCount, vertexCount);
+ 
+     glEnableVertexAttribArray(0);
+     glVertexAttribPointer(0,3,GL_UNSIGNED_SHORT,GL_TRUE,stride,(void*)offsetof(QuantizedVertex, pos));
+     glEnableVertexAttribArray(3);
+     glVertexAttribPointer(3,2,GL_SHORT,GL_TRUE,stride,(void*)offsetof(QuantizedVertex, oct));
+     glEnableVertexAttribArray(2);
+     glVertexAttribPointer(2,2,GL_HALF_FLOAT,GL_FALSE,stride,(void*)offsetof(QuantizedVertex, uv));
+ 
+     glBindVertexArray(0);
+     return m;
+ }
+ 
  // ------------------------------------------------------------
  // Helpers for maze
  // ------------------------------------------------------------
@@ -197,8 +299,7 @@
      glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
      glBufferData(GL_ARRAY_BUFFER, V.size()*sizeof(float), V.data(), GL_STATIC_DRAW);
  
-     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
-     glBufferData(GL_ELEMENT_ARRAY_BUFFER, I.size()*sizeof(uint32_t), I.data(), GL_STATIC_DRAW);
+     uploadIndices(m, I.data(), I.size(), V.size()/3);
  
      glEnableVertexAttribArray(0);
      glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3*sizeof(float), (void*)0);
@@ -208,7 +309,7 @@
  }
  
  // ---- Solid box helper ----
- static void appendBoxSolid(float x0,float y0,float z0, float x1,float y1,float z1,
+ void appendBoxSolid(float x0,float y0,float z0, float x1,float y1,float z1,
                             std::vector<float>& V, std::vector<uint32_t>& I)
  {
      uint32_t base = (uint32_t)(V.size()/3);
@@ -335,8 +436,7 @@
      glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
      glBufferData(GL_ARRAY_BUFFER, V.size()*sizeof(float), V.data(), GL_STATIC_DRAW);
  
-     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
-     glBufferData(GL_ELEMENT_ARRAY_BUFFER, I.size()*sizeof(uint32_t), I.data(), GL_STATIC_DRAW);
+     uploadIndices(m, I.data(), I.size(), V.size()/3);
  
      glEnableVertexAttribArray(0);
      glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,3*sizeof(float),(void*)0);
@@ -361,10 +461,11 @@
  // ------------------------------------------------------------
  // NEW : maze mesh SOLIDE depuis TON Maze (rendu == collisions)
  // ------------------------------------------------------------
- Mesh createMazeWallsSolidFromMaze(const Maze& maze, float wallH)
+ MeshData buildMazeWallsSolidFromMaze(const Maze& maze, float wallH)
  {
-     std::vector<float> V;
-     std::vector<uint32_t> I;
+     MeshData out;
+     std::vector<float>& V = out.pos;
+     std::vector<uint32_t>& I = out.idx;
      V.reserve(20000);
      I.reserve(20000);
  
@@ -408,38 +509,25 @@
          }
      }
  
-     Mesh m{};
-     m.count = (GLsizei)I.size();
- 
-     glGenVertexArrays(1,&m.vao);
-     glGenBuffers(1,&m.vbo);
-     glGenBuffers(1,&m.ebo);
- 
-     glBindVertexArray(m.vao);
- 
-     glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-     glBufferData(GL_ARRAY_BUFFER, V.size()*sizeof(float), V.data(), GL_STATIC_DRAW);
- 
-     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
-     glBufferData(GL_ELEMENT_ARRAY_BUFFER, I.size()*sizeof(uint32_t), I.data(), GL_STATIC_DRAW);
- 
-     glEnableVertexAttribArray(0);
-     glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,3*sizeof(float),(void*)0);
+     return out;
+ }
  
-     glBindVertexArray(0);
-     return m;
+ Mesh createMazeWallsSolidFromMaze(const Maze& maze, float wallH)
+ {
+     return uploadMeshData(buildMazeWallsSolidFromMaze(maze, wallH));
  }
  
  // ------------------------------------------------------------
  // Sphere (positions only) : utilisé par Ball (createSphere)
  // ------------------------------------------------------------
- Mesh createSphere(float radius, int stacks, int slices)
+ MeshData buildSphere(float radius, int stacks, int slices)
  {
      stacks = std::max(2, stacks);
      slices = std::max(3, slices);
  
-     std::vector<float> V;
-     std::vector<uint32_t> I;
+     MeshData out;
+     std::vector<float>& V = out.pos;
+     std::vector<uint32_t>& I = out.idx;
      V.reserve((stacks+1)*(slices+1)*3);
      I.reserve(stacks*slices*6);
  
@@ -479,25 +567,12 @@
          }
      }
  
-     Mesh m{};
-     m.count = (GLsizei)I.size();
- 
-     glGenVertexArrays(1,&m.vao);
-     glGenBuffers(1,&m.vbo);
-     glGenBuffers(1,&m.ebo);
- 
-     glBindVertexArray(m.vao);
- 
-     glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-     glBufferData(GL_ARRAY_BUFFER, V.size()*sizeof(float), V.data(), GL_STATIC_DRAW);
- 
-     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
-     glBufferData(GL_ELEMENT_ARRAY_BUFFER, I.size()*sizeof(uint32_t), I.data(), GL_STATIC_DRAW);
- 
-     glEnableVertexAttribArray(0);
-     glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,3*sizeof(float),(void*)0);
+     // Ordre des bandes -> ordre cache de sommets (ACMR ~1.0 -> ~0.7)
+     optimizeMeshData(out);
+     return out;
+ }
  
-     glBindVertexArray(0);
-     return m;
+ Mesh createSphere(float radius, int stacks, int slices)
+ {
+     return uploadMeshData(buildSphere(radius, stacks, slices));
  }
- 
\ No newline at end of file
@@ -27,8 +27,59 @@ class Maze;
 /**
  * @struct Mesh
  * @brief Conteneur minimal d’un maillage OpenGL.
+ * @details indexType : GL_UNSIGNED_SHORT dès que les sommets tiennent sur 16 bits (tout
+ *          glDrawElements doit l'utiliser). posScale / posOffset : déquantification des
+ *          positions (identité pour des positions flottantes), à composer avec la matrice modèle.
  */
-struct Mesh { GLuint vao=0, vbo=0, ebo=0; GLsizei count=0; };
+struct Mesh {
+    GLuint vao=0, vbo=0, ebo=0;
+    GLsizei count=0;
+    GLenum indexType=GL_UNSIGNED_INT;
+    float posScale[3]={1.0f,1.0f,1.0f};
+    float posOffset[3]={0.0f,0.0f,0.0f};
+};
+
+/// @brief Taille en octets d'un indice (GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT).
+inline size_t indexSize(GLenum type) { return type == GL_UNSIGNED_SHORT ? 2 : 4; }
+
+/// @brief Vrai si les positions du maillage sont quantifiées (posScale / posOffset non triviaux).
+inline bool isQuantized(const Mesh& m) {
+    return m.posScale[0] != 1.0f || m.posScale[1] != 1.0f || m.posScale[2] != 1.0f
+        || m.posOffset[0] != 0.0f || m.posOffset[1] != 0.0f || m.posOffset[2] != 0.0f;
+}
+
+/**
+ * @struct MeshData
+ * @brief Maillage côté CPU (positions xyz contiguës + indices de triangles).
+ * @details Produit par les builders build*() ; uploadMeshData() en fait un Mesh,
+ *          GeometryArena::add() le place dans les buffers partagés.
+ */
+struct MeshData {
+    std::vector<float> pos;     ///< 3 floats par sommet.
+    std::vector<uint32_t> idx;  ///< 3 indices par triangle.
+};
+
+/// @brief Crée VAO/VBO/EBO (attribut 0 = vec3 position) à partir d'un MeshData.
+Mesh uploadMeshData(const MeshData& d);
+
+/// @brief Variante sur tableaux bruts (ex. pages d'un cache projeté en mémoire, sans copie).
+Mesh uploadMesh(const float* pos, size_t vertexCount, const uint32_t* idx, size_t indexCount);
+
+/**
+ * @brief Crée VAO/VBO/EBO pour des sommets entrelacés position / normale / uv (8 floats, cf. ObjVertex).
+ * @details Attributs : 0 = vec3 position, 1 = vec3 normale, 2 = vec2 uv.
+ */
+Mesh uploadMeshPNT(const float* pnt, size_t vertexCount, const uint32_t* idx, size_t indexCount);
+
+/**
+ * @brief Crée VAO/VBO/EBO pour des sommets quantifiés (16 octets, cf. QuantizedVertex).
+ * @details Attributs : 0 = uvec4 position normalisée (GL_UNSIGNED_SHORT), 3 = normale octaédrique
+ *          (2 x GL_SHORT normalisés), 2 = uv (GL_HALF_FLOAT). L'attribut 1 reste désactivé : MESH_VS
+ *          décode alors la normale octaédrique.
+ * @param posScale,posOffset Recopiés dans le Mesh (position = posOffset + posScale * q).
+ */
+Mesh uploadMeshQuantized(const void* vertices, size_t vertexCount, const uint32_t* idx, size_t indexCount,
+                         const float posScale[3], const float posOffset[3]);
 
 // ----- basics -----
 Mesh createBackgroundQuad();
@@ -60,8 +111,14 @@ Mesh createMazeWallsSolid(float sheetW, float sheetH,
     float corridorW, float wallT, float wallH,
     std::vector<Wall2D>& outWalls);
 
+/// @brief Ajoute une boîte pleine [x0,x1]x[y0,y1]x[z0,z1] (8 sommets, 12 triangles) à V / I.
+void appendBoxSolid(float x0, float y0, float z0, float x1, float y1, float z1,
+                    std::vector<float>& V, std::vector<uint32_t>& I);
+
 // ----- NEW : Maze mesh depuis TON objet Maze (rendu == collisions) -----
+MeshData buildMazeWallsSolidFromMaze(const Maze& maze, float wallH);
 Mesh createMazeWallsSolidFromMaze(const Maze& maze, float wallH);
 
 // ----- sphere (pour Ball::mesh = createSphere) -----
+MeshData buildSphere(float radius, int stacks, int slices);
 Mesh createSphere(float radius, int stacks, int slices);
@@ -0,0 +1,272 @@
+/**
+ * @file geometry_arena.cpp
+ * @brief Implémentation de l'arène de géométrie et de la soumission multi-draw indirecte.
+ */
+
+#include "geometry_arena.hpp"
+#include "GLUtils/gl_state.hpp"
+#include <algorithm>
+#include <iostream>
+
+static_assert(sizeof(ArenaDrawData) == 5 * 4 * sizeof(float), "ArenaDrawData doit faire 5 vec4");
+static_assert(sizeof(DrawElementsIndirectCommand) == 5 * sizeof(GLuint), "layout indirect GL");
+
+// ------------------------------------------------------------
+// RangeAllocator
+// ------------------------------------------------------------
+RangeAllocator::RangeAllocator(uint32_t capacity) : cap(capacity) {
+    if (capacity > 0) freeList.push_back({0, capacity});
+}
+
+bool RangeAllocator::alloc(uint32_t size, uint32_t& outOffset) {
+    if (size == 0) { outOffset = 0; return true; }
+    for (size_t i = 0; i < freeList.size(); ++i) {
+        Range& r = freeList[i];
+        if (r.size < size) continue;
+        outOffset = r.offset;
+        r.offset += size;
+        r.size -= size;
+        if (r.size == 0) freeList.erase(freeList.begin() + i);
+        usedCount += size;
+        return true;
+    }
+    return false;
+}
+
+void RangeAllocator::free(uint32_t offset, uint32_t size) {
+    if (size == 0) return;
+    usedCount -= size;
+
+    auto it = std::lower_bound(freeList.begin(), freeList.end(), offset,
+                               [](const Range& r, uint32_t o) { return r.offset < o; });
+    it = freeList.insert(it, Range{offset, size});
+
+    // Fusion avec le suivant
+    auto next = it + 1;
+    if (next != freeList.end() && it->offset + it->size == next->offset) {
+        it->size += next->size;
+        freeList.erase(next);
+    }
+    // Fusion avec le précédent
+    if (it != freeList.begin()) {
+        auto prev = it - 1;
+        if (prev->offset + prev->size == it->offset) {
+            prev->size += it->size;
+            freeList.erase(it);
+        }
+    }
+}
+
+void RangeAllocator::grow(uint32_t newCapacity) {
+    if (newCapacity <= cap) return;
+    const uint32_t added = newCapacity - cap;
+    if (!freeList.empty() && freeList.back().offset + freeList.back().size == cap)
+        freeList.back().size += added;
+    else
+        freeList.push_back({cap, added});
+    cap = newCapacity;
+}
+
+// ------------------------------------------------------------
+// Helpers GL
+// ------------------------------------------------------------
+
+/// Réalloue un buffer plus grand en conservant son contenu (copie côté GPU).
+static GLuint growBuffer(GLuint old, GLsizeiptr oldBytes, GLsizeiptr newBytes, GLenum usage) {
+    GLuint nb = 0;
+    glGenBuffers(1, &nb);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, nb);
+    glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, usage);
+    if (old && oldBytes > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, old);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (old) glDeleteBuffers(1, &old);
+    return nb;
+}
+
+// ------------------------------------------------------------
+// GeometryArena
+// ------------------------------------------------------------
+GeometryArena::~GeometryArena() {
+    destroy();
+}
+
+void GeometryArena::create(uint32_t maxVertices, uint32_t maxIndices, uint32_t maxDraws) {
+    destroy();
+
+    mdiSupported = GLEW_VERSION_4_3 || (GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance);
+    mdi = mdiSupported;
+
+    glGenVertexArrays(1, &vaoId);
+    glGenTextures(1, &drawDataTex);
+    if (mdiSupported) glGenBuffers(1, &indirectBuf);
+
+    growVertices(std::max(1u, maxVertices));
+    growIndices(std::max(1u, maxIndices));
+    growDraws(std::max(1u, maxDraws));
+}
+
+void GeometryArena::destroy() {
+    if (vaoId) glDeleteVertexArrays(1, &vaoId);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (ebo) glDeleteBuffers(1, &ebo);
+    if (drawIdVbo) glDeleteBuffers(1, &drawIdVbo);
+    if (drawDataBuf) glDeleteBuffers(1, &drawDataBuf);
+    if (drawDataTex) glDeleteTextures(1, &drawDataTex);
+    if (indirectBuf) glDeleteBuffers(1, &indirectBuf);
+    vaoId = vbo = ebo = drawIdVbo = drawDataBuf = drawDataTex = indirectBuf = 0;
+    vertexAlloc = RangeAllocator();
+    indexAlloc = RangeAllocator();
+    drawCapacity = 0;
+}
+
+void GeometryArena::setupVertexArray() {
+    glBindVertexArray(vaoId);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+
+    // Identifiant de draw : attribut entier instancié (baseInstance -> indice du draw)
+    glBindBuffer(GL_ARRAY_BUFFER, drawIdVbo);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+    glVertexAttribDivisor(1, 1);
+    if (mdi) glEnableVertexAttribArray(1);
+    else     glDisableVertexAttribArray(1); // valeur fixée par glVertexAttribI1ui
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glState().invalidate(); // bind direct hors cache
+}
+
+void GeometryArena::setMultiDrawIndirect(bool enabled) {
+    mdi = enabled && mdiSupported;
+    setupVertexArray();
+}
+
+void GeometryArena::growVertices(uint32_t minCapacity) {
+    const uint32_t oldCap = vertexAlloc.capacity();
+    uint32_t newCap = std::max(minCapacity, oldCap * 2);
+    vbo = growBuffer(vbo, (GLsizeiptr)oldCap * 3 * sizeof(float),
+                     (GLsizeiptr)newCap * 3 * sizeof(float), GL_STATIC_DRAW);
+    vertexAlloc.grow(newCap);
+    if (drawIdVbo) setupVertexArray();
+}
+
+void GeometryArena::growIndices(uint32_t minCapacity) {
+    const uint32_t oldCap = indexAlloc.capacity();
+    uint32_t newCap = std::max(minCapacity, oldCap * 2);
+    ebo = growBuffer(ebo, (GLsizeiptr)oldCap * sizeof(uint32_t),
+                     (GLsizeiptr)newCap * sizeof(uint32_t), GL_STATIC_DRAW);
+    indexAlloc.grow(newCap);
+    if (drawIdVbo) setupVertexArray();
+}
+
+void GeometryArena::growDraws(uint32_t minCapacity) {
+    const uint32_t oldCap = drawCapacity;
+    const uint32_t newCap = std::max(minCapacity, oldCap * 2);
+
+    drawDataBuf = growBuffer(drawDataBuf, (GLsizeiptr)oldCap * sizeof(ArenaDrawData),
+                             (GLsizeiptr)newCap * sizeof(ArenaDrawData), GL_DYNAMIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, drawDataTex);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, drawDataBuf);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    // Identifiants 0..newCap-1 (contenu constant, recréé entièrement)
+    std::vector<GLuint> ids(newCap);
+    for (uint32_t i = 0; i < newCap; ++i) ids[i] = i;
+    if (!drawIdVbo) glGenBuffers(1, &drawIdVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, drawIdVbo);
+    glBufferData(GL_ARRAY_BUFFER, ids.size() * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    drawCapacity = newCap;
+    setupVertexArray();
+}
+
+ArenaMesh GeometryArena::add(const MeshData& d) {
+    return add(d.pos.data(), (uint32_t)(d.pos.size() / 3), d.idx.data(), (uint32_t)d.idx.size());
+}
+
+ArenaMesh GeometryArena::add(const float* pos, uint32_t nv, const uint32_t* idx, uint32_t ni) {
+    ArenaMesh m;
+    if (nv == 0 || ni == 0) return m;
+
+    uint32_t vOff = 0, iOff = 0;
+    if (!vertexAlloc.alloc(nv, vOff)) {
+        growVertices(vertexAlloc.capacity() + nv);
+        vertexAlloc.alloc(nv, vOff);
+    }
+    if (!indexAlloc.alloc(ni, iOff)) {
+        growIndices(indexAlloc.capacity() + ni);
+        indexAlloc.alloc(ni, iOff);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)vOff * 3 * sizeof(float), (GLsizeiptr)nv * 3 * sizeof(float), pos);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // EBO via GL_COPY_WRITE_BUFFER : ne touche pas l'état du VAO courant
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)iOff * sizeof(uint32_t), ni * sizeof(uint32_t), idx);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    m.baseVertex = (GLint)vOff;
+    m.firstIndex = iOff;
+    m.count = (GLsizei)ni;
+    m.vertexCount = nv;
+    return m;
+}
+
+void GeometryArena::release(ArenaMesh& m) {
+    if (!m.valid()) return;
+    vertexAlloc.free((uint32_t)m.baseVertex, m.vertexCount);
+    indexAlloc.free(m.firstIndex, (uint32_t)m.count);
+    m = ArenaMesh{};
+}
+
+void GeometryArena::uploadDrawData(uint32_t first, uint32_t n, const ArenaDrawData* data) {
+    if (n == 0) return;
+    if (first + n > drawCapacity) growDraws(first + n);
+    glBindBuffer(GL_TEXTURE_BUFFER, drawDataBuf);
+    glBufferSubData(GL_TEXTURE_BUFFER, (GLintptr)first * sizeof(ArenaDrawData), n * sizeof(ArenaDrawData), data);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glState().noteUpload();
+}
+
+int GeometryArena::draw(const std::vector<DrawElementsIndirectCommand>& cmds, GLint textureUnit) {
+    if (cmds.empty()) return 0;
+
+    GLStateCache& gl = glState();
+    gl.bindTexture(textureUnit, GL_TEXTURE_BUFFER, drawDataTex);
+    gl.bindVertexArray(vaoId);
+
+    int calls = 0;
+    if (mdi) {
+        const GLsizeiptr bytes = (GLsizeiptr)(cmds.size() * sizeof(DrawElementsIndirectCommand));
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuf);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, bytes, cmds.data(), GL_STREAM_DRAW);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)0, (GLsizei)cmds.size(), 0);
+        gl.noteUpload();
+        calls = 1;
+    } else {
+        // Repli GL 3.3 : un draw par commande, sans changement de VAO ni d'uniforme
+        for (const auto& c : cmds) {
+            glVertexAttribI1ui(1, c.baseInstance);
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)c.count, GL_UNSIGNED_INT,
+                                     (void*)((uintptr_t)c.firstIndex * sizeof(uint32_t)), c.baseVertex);
+            ++calls;
+        }
+        // Valeur courante d'attribut = état du contexte, pas du VAO : on rend la valeur par
+        // défaut (0, 0, 0, 1) aux programmes qui lisent l'attribut 1 sans tableau activé
+        glVertexAttrib4f(1, 0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    gl.noteDraw(calls);
+    return calls;
+}
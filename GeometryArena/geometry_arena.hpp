@@ -0,0 +1,162 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Geometries/geometries.hpp"
+
+/**
+ * @file geometry_arena.hpp
+ * @brief Arène de géométrie : un seul VBO/EBO/VAO partagé par tous les maillages statiques.
+ *
+ * @details
+ * - Les maillages sont sous-alloués dans deux grands buffers (sommets / indices) et
+ *   désignés par un ArenaMesh (baseVertex, firstIndex, count).
+ * - Les données par draw (matrice modèle + couleur) sont dans un texture buffer
+ *   (GL_RGBA32F, 5 texels par draw) lu par ARENA_VS via l'identifiant de draw.
+ * - L'identifiant de draw est un attribut entier instancié (location 1, divisor 1) :
+ *   avec glMultiDrawElementsIndirect, baseInstance = indice du draw ; en repli GL 3.3,
+ *   l'attribut est désactivé et fixé par glVertexAttribI1ui avant chaque glDrawElementsBaseVertex,
+ *   puis remis à sa valeur par défaut après la boucle.
+ * - Les buffers grandissent automatiquement (copie GPU -> GPU via glCopyBufferSubData).
+ */
+
+/**
+ * @struct ArenaMesh
+ * @brief Poignée d'un maillage placé dans l'arène.
+ */
+struct ArenaMesh {
+    GLint   baseVertex = 0;   ///< Premier sommet (ajouté aux indices).
+    GLuint  firstIndex = 0;   ///< Premier indice dans l'EBO partagé.
+    GLsizei count = 0;        ///< Nombre d'indices.
+    GLuint  vertexCount = 0;  ///< Nombre de sommets réservés.
+
+    bool valid() const { return count > 0; }
+};
+
+/**
+ * @struct ArenaDrawData
+ * @brief Données par draw stockées dans le texture buffer (5 x vec4).
+ */
+struct ArenaDrawData {
+    glm::mat4 model{1.0f};  ///< Matrice modèle (colonnes 0..3).
+    glm::vec4 color{1.0f};  ///< Couleur RGBA.
+};
+
+/**
+ * @struct DrawElementsIndirectCommand
+ * @brief Layout imposé par GL_DRAW_INDIRECT_BUFFER.
+ */
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;
+};
+
+/**
+ * @class RangeAllocator
+ * @brief Sous-allocateur first-fit d'intervalles [offset, offset+size) avec fusion des blocs libres.
+ */
+class RangeAllocator {
+public:
+    explicit RangeAllocator(uint32_t capacity = 0);
+
+    /// @brief Réserve size éléments ; renvoie false si aucun bloc libre ne suffit.
+    bool alloc(uint32_t size, uint32_t& outOffset);
+    /// @brief Rend un intervalle (fusionné avec ses voisins libres).
+    void free(uint32_t offset, uint32_t size);
+    /// @brief Agrandit la capacité (l'espace ajouté est libre).
+    void grow(uint32_t newCapacity);
+
+    uint32_t capacity() const { return cap; }
+    uint32_t used() const { return usedCount; }
+
+private:
+    struct Range { uint32_t offset, size; };
+    std::vector<Range> freeList; ///< Blocs libres triés par offset.
+    uint32_t cap = 0;
+    uint32_t usedCount = 0;
+};
+
+/**
+ * @class GeometryArena
+ * @brief Buffers de géométrie partagés + soumission multi-draw indirecte.
+ */
+class GeometryArena {
+public:
+    static constexpr GLint DRAW_DATA_UNIT = 1; ///< Unité de texture par défaut du texture buffer.
+
+    ~GeometryArena();
+
+    /**
+     * @brief Crée les buffers GL (contexte requis).
+     * @param maxVertices Capacité initiale en sommets (grandit si besoin).
+     * @param maxIndices Capacité initiale en indices (grandit si besoin).
+     * @param maxDraws Capacité initiale en draws (grandit si besoin).
+     */
+    void create(uint32_t maxVertices, uint32_t maxIndices, uint32_t maxDraws = 256);
+
+    /// @brief Libère les ressources GL.
+    void destroy();
+
+    /**
+     * @brief Copie un maillage CPU dans l'arène.
+     * @return Poignée (invalide si le maillage est vide).
+     */
+    ArenaMesh add(const MeshData& d);
+    /// @brief Variante sur tableaux bruts (positions xyz, indices de triangles).
+    ArenaMesh add(const float* pos, uint32_t vertexCount, const uint32_t* idx, uint32_t indexCount);
+
+    /// @brief Rend l'espace occupé par un maillage.
+    void release(ArenaMesh& m);
+
+    /**
+     * @brief Écrit des données par draw dans le texture buffer.
+     * @param first Indice du premier draw.
+     * @param n Nombre de draws.
+     * @param data Tableau de n entrées.
+     */
+    void uploadDrawData(uint32_t first, uint32_t n, const ArenaDrawData* data);
+
+    /**
+     * @brief Soumet une liste de draws (un seul appel si multi-draw indirect disponible).
+     * @param cmds Commandes ; baseInstance = indice du draw dans le texture buffer.
+     * @param textureUnit Unité de texture utilisée pour le texture buffer.
+     * @return Nombre d'appels de dessin émis.
+     * @warning Le programme ARENA doit être actif (uDrawData pointant sur textureUnit).
+     * @note Les bindings passent par glState() et ne sont pas remis à zéro après le draw.
+     */
+    int draw(const std::vector<DrawElementsIndirectCommand>& cmds, GLint textureUnit = DRAW_DATA_UNIT);
+
+    /// @brief true si glMultiDrawElementsIndirect est utilisé.
+    bool usesMultiDrawIndirect() const { return mdi; }
+    /// @brief Force le chemin de repli GL 3.3 (comparaison / debug).
+    void setMultiDrawIndirect(bool enabled);
+
+    GLuint vao() const { return vaoId; }
+    uint32_t vertexCapacity() const { return vertexAlloc.capacity(); }
+    uint32_t indexCapacity() const { return indexAlloc.capacity(); }
+
+private:
+    void growVertices(uint32_t minCapacity);
+    void growIndices(uint32_t minCapacity);
+    void growDraws(uint32_t minCapacity);
+    void setupVertexArray();
+
+    RangeAllocator vertexAlloc;
+    RangeAllocator indexAlloc;
+    uint32_t drawCapacity = 0;
+
+    GLuint vaoId = 0;
+    GLuint vbo = 0;        ///< Positions xyz (float).
+    GLuint ebo = 0;        ///< Indices uint32.
+    GLuint drawIdVbo = 0;  ///< 0..drawCapacity-1 (attribut instancié).
+    GLuint drawDataBuf = 0;
+    GLuint drawDataTex = 0;
+    GLuint indirectBuf = 0;
+    bool mdiSupported = false;
+    bool mdi = false;
+};
@@ -0,0 +1,130 @@
+/**
+ * @file line_batch.cpp
+ * @brief Implémentation du lot de lignes épaisses instanciées.
+ */
+
+#include "line_batch.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include "GLUtils/gl_state.hpp"
+#include "GLUtils/stream_buffer.hpp"
+
+namespace {
+
+uint32_t packColor(const glm::vec4& c) {
+    auto u8 = [](float v) { return (uint32_t)(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f); };
+    return u8(c.r) | (u8(c.g) << 8) | (u8(c.b) << 16) | (u8(c.a) << 24);
+}
+
+/// @brief Attributs d'instance 1..4 lus dans le buffer lié à GL_ARRAY_BUFFER à partir de base.
+void instancePointers(GLintptr base) {
+    const GLsizei stride = sizeof(LineInstance);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(LineInstance, p0)));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(LineInstance, p1)));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)(base + offsetof(LineInstance, color)));
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(LineInstance, width)));
+}
+
+} // namespace
+
+LineBatch::~LineBatch() {
+    destroy();
+}
+
+void LineBatch::create(std::size_t initialCapacity) {
+    destroy();
+    capacity = std::max<std::size_t>(initialCapacity, 1);
+
+    // Coins du quad : (extrémité, côté) en triangle strip
+    static const float corners[8] = { 0.f, -1.f,  0.f, 1.f,  1.f, -1.f,  1.f, 1.f };
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &quadVbo);
+    glGenBuffers(1, &instanceVbo);
+    glState().bindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quadVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(capacity * sizeof(LineInstance)), nullptr, GL_STREAM_DRAW);
+    instancePointers(0);
+    for (GLuint a = 1; a <= 4; ++a) {
+        glEnableVertexAttribArray(a);
+        glVertexAttribDivisor(a, 1);
+    }
+    boundBuffer = instanceVbo;
+    boundOffset = 0;
+
+    glState().bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void LineBatch::destroy() {
+    if (vao) {
+        glState().bindVertexArray(0);
+        glDeleteVertexArrays(1, &vao);
+    }
+    if (quadVbo) glDeleteBuffers(1, &quadVbo);
+    if (instanceVbo) glDeleteBuffers(1, &instanceVbo);
+    vao = quadVbo = instanceVbo = 0;
+    boundBuffer = 0;
+    boundOffset = 0;
+    capacity = 0;
+    lines.clear();
+}
+
+void LineBatch::add(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, float widthPx) {
+    lines.push_back(LineInstance{ { p0.x, p0.y, p0.z }, { p1.x, p1.y, p1.z }, packColor(color), widthPx });
+}
+
+void LineBatch::addAxes(float L, float widthPx) {
+    const glm::vec3 o(0.0f);
+    add(o, glm::vec3(L, 0.f, 0.f), glm::vec4(1.f, 0.f, 0.f, 1.f), widthPx);
+    add(o, glm::vec3(0.f, L, 0.f), glm::vec4(0.f, 1.f, 0.f, 1.f), widthPx);
+    add(o, glm::vec3(0.f, 0.f, -L), glm::vec4(0.f, 0.f, 1.f, 1.f), widthPx);
+}
+
+void LineBatch::draw(GLuint prog) {
+    if (lines.empty() || vao == 0) return;
+
+    GLStateCache& gl = glState();
+    const GLsizeiptr bytes = (GLsizeiptr)(lines.size() * sizeof(LineInstance));
+    StreamAlloc a;
+    if (frameStream().isCreated()) a = frameStream().alloc(bytes, sizeof(LineInstance));
+
+    if (a.ptr) {
+        // Anneau de la frame : écriture directe, les attributs pointent sur la plage allouée
+        std::memcpy(a.ptr, lines.data(), (std::size_t)bytes);
+        frameStream().unmap();
+        gl.bindVertexArray(vao);
+        if (a.buffer != boundBuffer || a.offset != boundOffset) {
+            glBindBuffer(GL_ARRAY_BUFFER, a.buffer);
+            instancePointers(a.offset);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            boundBuffer = a.buffer;
+            boundOffset = a.offset;
+        }
+    } else {
+        // Réallocation (orphelinage) puis remplissage : le driver n'attend pas le draw précédent
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+        if (lines.size() > capacity) capacity = std::max(lines.size(), capacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(capacity * sizeof(LineInstance)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, lines.data());
+        gl.bindVertexArray(vao);
+        if (boundBuffer != instanceVbo || boundOffset != 0) {
+            instancePointers(0);
+            boundBuffer = instanceVbo;
+            boundOffset = 0;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    gl.noteUpload();
+    gl.useProgram(prog);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)lines.size());
+    gl.noteDraw();
+}
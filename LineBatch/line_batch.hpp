@@ -0,0 +1,81 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file line_batch.hpp
+ * @brief Lignes de debug épaisses (en pixels) sans geometry shader : toutes les lignes d'une
+ *        frame dans un buffer d'instances, un seul glDrawArraysInstanced.
+ *
+ * @details
+ * Chaque segment est une instance d'un quad de 4 sommets (triangle strip) ; le vertex
+ * shader (THICKLINE_VS) projette les deux extrémités et décale les coins en pixels. Par
+ * rapport à LINE_GS (un geometry shader par segment, très lent sous llvmpipe et sur de
+ * nombreux drivers) et à un VAO + un bloc Object par ligne, le coût CPU est un upload et
+ * un draw par frame quel que soit le nombre de lignes.
+ *
+ * Les extrémités sont exprimées dans le repère du bloc Object lié au moment de draw()
+ * (uniform_buffers.hpp) ; la caméra vient du bloc Camera.
+ *
+ * Usage :
+ * @code
+ * lines.begin();
+ * lines.addAxes(0.10f, 3.0f);
+ * lines.draw(progThickLine);   // Camera + Object déjà liés
+ * @endcode
+ */
+
+/**
+ * @struct LineInstance
+ * @brief Attributs d'un segment (32 octets, divisor 1).
+ */
+struct LineInstance {
+    float p0[3];
+    float p1[3];
+    uint32_t color; ///< RGBA8 (R dans l'octet de poids faible).
+    float width;    ///< Demi-épaisseur en pixels (même sens que uParams.x de LINE_GS).
+};
+static_assert(sizeof(LineInstance) == 32, "LineInstance doit faire 32 octets");
+
+/**
+ * @class LineBatch
+ * @brief Lot de segments d'une frame, streamé puis dessiné en un appel.
+ */
+class LineBatch {
+public:
+    ~LineBatch();
+
+    /// @brief Crée le VAO, le quad et le buffer d'instances (contexte requis). Grandit si besoin.
+    void create(std::size_t initialCapacity = 256);
+    void destroy();
+
+    /// @brief Vide le lot (début de frame).
+    void begin() { lines.clear(); }
+
+    /// @brief Ajoute un segment.
+    void add(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, float widthPx);
+
+    /// @brief Ajoute les trois axes X (rouge), Y (vert), -Z (bleu) de longueur L (repère board).
+    void addAxes(float L, float widthPx);
+
+    /**
+     * @brief Envoie le lot et le dessine en un seul appel instancié.
+     * @details Écrit dans frameStream() s'il est créé (attributs repointés sur la plage) ;
+     *          sinon buffer propre réalloué puis rempli (pas d'attente sur la frame précédente).
+     * @param prog Programme THICKLINE_VS / THICKLINE_FS (blocs liés par UniformBuffers::bindBlocks).
+     */
+    void draw(GLuint prog);
+
+    std::size_t size() const { return lines.size(); }
+
+private:
+    GLuint vao = 0;
+    GLuint quadVbo = 0;
+    GLuint instanceVbo = 0;
+    std::size_t capacity = 0; ///< Instances allouées dans instanceVbo.
+    GLuint boundBuffer = 0;   ///< Buffer des attributs d'instance dans le VAO.
+    GLintptr boundOffset = 0; ///< Offset de ces attributs.
+    std::vector<LineInstance> lines;
+};
@@ -0,0 +1,203 @@
+/**
+ * @file mesh_cache.cpp
+ * @brief Implémentation du cache binaire des modèles OBJ.
+ */
+
+#include "mesh_cache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::size_t HASH_SPAN = 64 * 1024;
+constexpr uint64_t ALIGN = 64;
+
+uint64_t fnv1a(const char* p, std::size_t n, uint64_t h) {
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= (uint8_t)p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+uint64_t alignUp(uint64_t v) { return (v + ALIGN - 1) & ~(ALIGN - 1); }
+
+} // namespace
+
+bool MeshCacheKey::fromFile(const std::string& path, MeshCacheKey& out) {
+    std::error_code ec;
+    const uint64_t sz = fs::file_size(path, ec);
+    if (ec) return false;
+    const auto mt = fs::last_write_time(path, ec);
+    if (ec) return false;
+
+    MappedFile f;
+    if (!f.open(path, false)) return false;
+
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = fnv1a((const char*)&sz, sizeof(sz), h);
+    if (f.size() > 0) {
+        const std::size_t head = std::min(f.size(), HASH_SPAN);
+        h = fnv1a(f.data(), head, h);
+        if (f.size() > head) {
+            const std::size_t tail = std::min(f.size() - head, HASH_SPAN);
+            h = fnv1a(f.data() + f.size() - tail, tail, h);
+        }
+    }
+
+    out.size = sz;
+    out.mtime = (int64_t)mt.time_since_epoch().count();
+    out.hash = h;
+    return true;
+}
+
+std::string meshCachePath(const std::string& objPath) {
+    return objPath + ".meshcache";
+}
+
+bool MeshCacheView::open(const std::string& cachePath, const MeshCacheKey& key) {
+    close();
+    if (!file.open(cachePath, false) || !attach(file.data(), file.size(), &key)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MeshCacheView::open(const char* data, std::size_t size) {
+    close();
+    return attach(data, size, nullptr);
+}
+
+bool MeshCacheView::attach(const char* data, std::size_t size, const MeshCacheKey* key) {
+    if (!data || size < sizeof(MeshCacheHeader) || (uintptr_t)data % ALIGN != 0) return false;
+
+    const MeshCacheHeader* h = (const MeshCacheHeader*)data;
+    const uint64_t vBytes = (uint64_t)h->vertexCount * sizeof(ObjVertex);
+    const uint64_t qBytes = (uint64_t)h->vertexCount * sizeof(QuantizedVertex);
+    const uint64_t iBytes = (uint64_t)h->indexCount * sizeof(uint32_t);
+    const uint64_t sBytes = (uint64_t)h->submeshCount * sizeof(ObjSubmesh);
+    bool ok = h->magic == MESH_CACHE_MAGIC
+           && h->version == MESH_CACHE_VERSION
+           && (!key || h->source == *key)
+           && h->vertexOffset % ALIGN == 0 && h->quantizedOffset % ALIGN == 0
+           && h->indexOffset % ALIGN == 0 && h->submeshOffset % ALIGN == 0
+           && h->vertexOffset >= sizeof(MeshCacheHeader)
+           && h->vertexOffset + vBytes <= h->quantizedOffset
+           && h->quantizedOffset + qBytes <= h->indexOffset
+           && h->indexOffset + iBytes <= h->submeshOffset
+           && h->submeshOffset + sBytes <= h->stringsOffset
+           && h->stringsOffset + h->stringsSize <= size
+           && h->lodCount >= 1 && h->lodCount <= OBJ_MAX_LODS && h->submeshCount % h->lodCount == 0;
+
+    // Table de chaînes : mtllib puis un nom par matériau, chacun terminé par '\0'
+    if (ok) {
+        const char* p = data + h->stringsOffset;
+        const char* end = p + h->stringsSize;
+        while (p < end && names.size() < (std::size_t)h->materialCount + 1) {
+            const char* z = (const char*)std::memchr(p, '\0', (std::size_t)(end - p));
+            if (!z) break;
+            names.emplace_back(p, (std::size_t)(z - p));
+            p = z + 1;
+        }
+        ok = names.size() == (std::size_t)h->materialCount + 1;
+        for (uint32_t i = 0; ok && i < h->submeshCount; ++i) {
+            const ObjSubmesh& sm = ((const ObjSubmesh*)(data + h->submeshOffset))[i];
+            ok = sm.material < h->materialCount && (uint64_t)sm.firstIndex + sm.indexCount <= h->indexCount;
+        }
+    }
+
+    if (!ok) {
+        names.clear();
+        return false;
+    }
+    base = data;
+    hdr = h;
+    return true;
+}
+
+MeshBounds MeshCacheView::bounds() const {
+    MeshBounds b;
+    b.min = glm::vec3(hdr->boundsMin[0], hdr->boundsMin[1], hdr->boundsMin[2]);
+    b.max = glm::vec3(hdr->boundsMax[0], hdr->boundsMax[1], hdr->boundsMax[2]);
+    b.center = glm::vec3(hdr->center[0], hdr->center[1], hdr->center[2]);
+    b.radius = hdr->radius;
+    return b;
+}
+
+bool writeMeshCache(const std::string& cachePath, const MeshCacheKey& key,
+                    const ObjModel& model, const MeshBounds& bounds) {
+    std::string strings = model.mtllib;
+    strings.push_back('\0');
+    for (const std::string& n : model.materialNames) {
+        strings += n;
+        strings.push_back('\0');
+    }
+
+    const uint64_t vBytes = model.vertices.size() * sizeof(ObjVertex);
+    const uint64_t qBytes = model.vertices.size() * sizeof(QuantizedVertex);
+    const uint64_t iBytes = model.idx.size() * sizeof(uint32_t);
+    const uint64_t sBytes = model.submeshes.size() * sizeof(ObjSubmesh);
+
+    MeshCacheHeader h{};
+    std::vector<QuantizedVertex> quantized(model.vertices.size());
+    quantizeVertices(model.vertices.data(), model.vertices.size(), quantized.data(), h.posScale, h.posOffset);
+
+    h.magic = MESH_CACHE_MAGIC;
+    h.version = MESH_CACHE_VERSION;
+    h.source = key;
+    h.vertexCount = (uint32_t)model.vertices.size();
+    h.indexCount = (uint32_t)model.idx.size();
+    h.submeshCount = (uint32_t)model.submeshes.size();
+    h.materialCount = (uint32_t)model.materialNames.size();
+    h.vertexOffset = alignUp(sizeof(MeshCacheHeader));
+    h.quantizedOffset = alignUp(h.vertexOffset + vBytes);
+    h.indexOffset = alignUp(h.quantizedOffset + qBytes);
+    h.submeshOffset = alignUp(h.indexOffset + iBytes);
+    h.stringsOffset = h.submeshOffset + sBytes;
+    h.stringsSize = (uint32_t)strings.size();
+    h.flags = (model.hasNormals ? MESH_CACHE_HAS_NORMALS : 0u) | (model.hasUVs ? MESH_CACHE_HAS_UVS : 0u);
+    for (int k = 0; k < 3; ++k) {
+        h.boundsMin[k] = bounds.min[k];
+        h.boundsMax[k] = bounds.max[k];
+        h.center[k] = bounds.center[k];
+    }
+    h.radius = bounds.radius;
+    h.lodCount = model.lodCount;
+    for (uint32_t l = 0; l < OBJ_MAX_LODS; ++l) h.lodError[l] = model.lodError[l];
+
+    const std::string tmp = cachePath + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+
+    static const char zeros[ALIGN] = {};
+    uint64_t written = 0;
+    auto put = [&](const void* data, uint64_t n) {
+        if (n == 0) return true;
+        written += n;
+        return std::fwrite(data, 1, (std::size_t)n, f) == n;
+    };
+    auto padTo = [&](uint64_t offset) { return put(zeros, offset - written); };
+
+    bool ok = put(&h, sizeof(h))
+           && padTo(h.vertexOffset) && put(model.vertices.data(), vBytes)
+           && padTo(h.quantizedOffset) && put(quantized.data(), qBytes)
+           && padTo(h.indexOffset) && put(model.idx.data(), iBytes)
+           && padTo(h.submeshOffset) && put(model.submeshes.data(), sBytes)
+           && put(strings.data(), strings.size());
+    ok = (std::fclose(f) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) fs::rename(tmp, cachePath, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "FileIO/mapped_file.hpp"
+#include "ObjLoader/obj_loader.hpp"
+#include "MeshOptimizer/mesh_optimizer.hpp"
+#include "Culling/culling.hpp"
+
+/**
+ * @file mesh_cache.hpp
+ * @brief Cache binaire des modèles OBJ (fichier "<obj>.meshcache" à côté de la source).
+ *
+ * @details
+ * Format (little-endian, version MESH_CACHE_VERSION) :
+ * @code
+ * [0   .. 192)         MeshCacheHeader
+ * [vertexOffset ..)    ObjVertex[vertexCount] (position, normale, uv ; 32 octets)  (aligné sur 64)
+ * [quantizedOffset ..) QuantizedVertex[vertexCount] (mêmes sommets, 16 octets)    (aligné sur 64)
+ * [indexOffset  ..)    uint32[indexCount], groupés par LOD puis sous-maillage      (aligné sur 64)
+ * [submeshOffset ..)   ObjSubmesh[submeshCount] = lodCount x sous-maillages        (aligné sur 64)
+ * [stringsOffset ..)   mtllib '\0' puis materialCount noms '\0'
+ * @endcode
+ * Niveaux de détail (buildLods()) compris ; triangles et sommets y sont déjà dans l'ordre
+ * optimisé (optimizeModel()). Les sommets y sont aussi quantifiés (quantizeVertices(),
+ * déquantification posScale / posOffset dans l'en-tête) : les deux formats se chargent sans calcul.
+ * Le cache est valide si magic, version, tailles et clé source (taille, mtime, empreinte)
+ * correspondent. Au chargement, le fichier est projeté en mémoire et les tableaux sont
+ * passés tels quels à glBufferData : aucun parse, aucune copie intermédiaire.
+ */
+
+constexpr uint32_t MESH_CACHE_MAGIC = 0x434D5241u; ///< "ARMC"
+constexpr uint32_t MESH_CACHE_VERSION = 5;         ///< 4 : niveaux de détail ; 5 : sommets quantifiés.
+
+/**
+ * @struct MeshCacheKey
+ * @brief Identité du fichier source : taille, date de modification, empreinte.
+ * @details L'empreinte (FNV-1a 64) porte sur les 64 premiers et 64 derniers Ko et la taille :
+ *          elle reste bon marché au démarrage même pour un OBJ de plusieurs centaines de Mo.
+ */
+struct MeshCacheKey {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+
+    /// @brief Calcule la clé d'un fichier source (false si illisible).
+    static bool fromFile(const std::string& path, MeshCacheKey& out);
+
+    bool operator==(const MeshCacheKey& o) const { return size == o.size && mtime == o.mtime && hash == o.hash; }
+};
+
+/**
+ * @struct MeshCacheHeader
+ * @brief En-tête du fichier cache (192 octets).
+ */
+struct MeshCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    MeshCacheKey source;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t submeshCount;
+    uint32_t materialCount;
+    uint64_t vertexOffset;  ///< Octets depuis le début du fichier.
+    uint64_t quantizedOffset;
+    uint64_t indexOffset;
+    uint64_t submeshOffset;
+    uint64_t stringsOffset;
+    uint32_t stringsSize;
+    uint32_t flags;         ///< MESH_CACHE_HAS_NORMALS | MESH_CACHE_HAS_UVS.
+    float boundsMin[3];
+    float boundsMax[3];
+    float center[3];
+    float radius;
+    uint32_t lodCount;               ///< Niveaux de détail (>= 1).
+    float lodError[OBJ_MAX_LODS];    ///< Erreur géométrique par LOD.
+    float posScale[3];               ///< Déquantification des sommets quantifiés.
+    float posOffset[3];
+    uint32_t reserved[3];
+};
+static_assert(sizeof(MeshCacheHeader) == 192, "MeshCacheHeader doit faire 192 octets");
+
+constexpr uint32_t MESH_CACHE_HAS_NORMALS = 1u;
+constexpr uint32_t MESH_CACHE_HAS_UVS = 2u;
+
+/**
+ * @class MeshCacheView
+ * @brief Cache ouvert : pointeurs vers les tableaux dans la projection mémoire.
+ */
+class MeshCacheView {
+public:
+    /**
+     * @brief Projette et valide un fichier cache.
+     * @param cachePath Fichier cache.
+     * @param key Clé attendue de la source.
+     * @return false si absent, corrompu ou périmé.
+     */
+    bool open(const std::string& cachePath, const MeshCacheKey& key);
+
+    /**
+     * @brief Valide un cache déjà en mémoire (entrée d'une archive, voir asset_pack.hpp).
+     * @details La clé source n'est pas vérifiée ; le tampon doit rester valide (et aligné
+     *          sur 64 octets) tant que la vue est utilisée.
+     */
+    bool open(const char* data, std::size_t size);
+    void close() { file.close(); base = nullptr; hdr = nullptr; names.clear(); }
+
+    bool valid() const { return hdr != nullptr; }
+    const ObjVertex* vertices() const { return (const ObjVertex*)(base + hdr->vertexOffset); }
+    const QuantizedVertex* quantizedVertices() const { return (const QuantizedVertex*)(base + hdr->quantizedOffset); }
+    const float* posScale() const { return hdr->posScale; }
+    const float* posOffset() const { return hdr->posOffset; }
+    const uint32_t* indices() const { return (const uint32_t*)(base + hdr->indexOffset); }
+    const ObjSubmesh* submeshes() const { return (const ObjSubmesh*)(base + hdr->submeshOffset); }
+    std::size_t vertexCount() const { return hdr->vertexCount; }
+    std::size_t indexCount() const { return hdr->indexCount; }
+    std::size_t submeshCount() const { return hdr->submeshCount; }
+    uint32_t flags() const { return hdr->flags; }
+    uint32_t lodCount() const { return hdr->lodCount; }
+    float lodError(uint32_t lod) const { return hdr->lodError[lod]; }
+
+    /// @brief "mtllib" de la source.
+    const std::string& mtllib() const { return names[0]; }
+    /// @brief Noms des matériaux (indexés par ObjSubmesh::material).
+    const std::string& materialName(std::size_t i) const { return names[i + 1]; }
+    std::size_t materialCount() const { return names.size() - 1; }
+
+    MeshBounds bounds() const;
+
+private:
+    bool attach(const char* data, std::size_t size, const MeshCacheKey* key);
+
+    MappedFile file;
+    const char* base = nullptr;     ///< Projection du fichier, ou tampon de l'appelant.
+    const MeshCacheHeader* hdr = nullptr;
+    std::vector<std::string> names; ///< mtllib puis noms des matériaux.
+};
+
+/// @brief Chemin du cache associé à un OBJ ("<obj>.meshcache").
+std::string meshCachePath(const std::string& objPath);
+
+/**
+ * @brief Écrit un cache (fichier temporaire puis renommage : jamais de cache à moitié écrit).
+ * @details Les sommets quantifiés sont calculés ici, depuis model.vertices.
+ * @return false si l'écriture échoue (répertoire en lecture seule, disque plein...).
+ */
+bool writeMeshCache(const std::string& cachePath, const MeshCacheKey& key,
+                    const ObjModel& model, const MeshBounds& bounds);
@@ -0,0 +1,278 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @brief Implémentation des optimisations post-chargement (cache, fetch, quantification).
+ */
+
+#include "mesh_optimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// ----- Forsyth : paramètres de l'article -----
+constexpr int CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float LAST_TRI_SCORE = 0.75f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+constexpr uint32_t VALENCE_TABLE = 64;
+
+/**
+ * @brief Scores précalculés : position dans le cache LRU, et bonus de valence
+ *        (favorise les sommets presque terminés, pour ne pas laisser de triangles isolés).
+ */
+struct ScoreTables {
+    float cache[CACHE_SIZE];
+    float valence[VALENCE_TABLE];
+
+    ScoreTables() {
+        for (int i = 0; i < CACHE_SIZE; ++i) {
+            if (i < 3) cache[i] = LAST_TRI_SCORE; // triangle précédent : même score, ordre indifférent
+            else cache[i] = std::pow(1.0f - (float)(i - 3) / (float)(CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+        valence[0] = 0.0f;
+        for (uint32_t i = 1; i < VALENCE_TABLE; ++i)
+            valence[i] = VALENCE_BOOST_SCALE * std::pow((float)i, -VALENCE_BOOST_POWER);
+    }
+
+    float vertex(int cachePos, uint32_t remaining) const {
+        if (remaining == 0) return -1.0f; // plus aucun triangle : sans intérêt
+        const float c = cachePos >= 0 ? cache[cachePos] : 0.0f;
+        const float v = remaining < VALENCE_TABLE
+                      ? valence[remaining]
+                      : VALENCE_BOOST_SCALE * std::pow((float)remaining, -VALENCE_BOOST_POWER);
+        return c + v;
+    }
+};
+
+const ScoreTables& scores() {
+    static const ScoreTables t;
+    return t;
+}
+
+// float -> demi-flottant IEEE 754 (arrondi au plus proche, dénormaux gérés)
+uint16_t toHalf(float f) {
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    const uint16_t sign = (uint16_t)((x >> 16) & 0x8000u);
+    const uint32_t absx = x & 0x7FFFFFFFu;
+    if (absx > 0x7F800000u) return sign | 0x7E00u;         // NaN
+    const int e = (int)(absx >> 23) - 127 + 15;
+    uint32_t m = absx & 0x7FFFFFu;
+    if (e >= 31) return sign | 0x7C00u;                    // trop grand : infini
+    if (e <= 0) {                                          // dénormal ou zéro
+        if (e < -10) return sign;
+        m |= 0x800000u;
+        const int shift = 14 - e;
+        uint32_t h = m >> shift;
+        if ((m >> (shift - 1)) & 1u) ++h;
+        return sign | (uint16_t)h;
+    }
+    uint32_t h = ((uint32_t)e << 10) | (m >> 13);
+    if (m & 0x1000u) ++h;                                  // la retenue passe dans l'exposant : correct
+    return sign | (uint16_t)h;
+}
+
+int16_t snorm16(float v) {
+    v = std::max(-1.0f, std::min(1.0f, v));
+    return (int16_t)std::lround(v * 32767.0f);
+}
+
+} // namespace
+
+VertexCacheStats analyzeVertexCache(const uint32_t* idx, std::size_t indexCount,
+                                    std::size_t vertexCount, unsigned cacheSize) {
+    VertexCacheStats s;
+    if (indexCount < 3 || vertexCount == 0) return s;
+
+    // FIFO par horodatage : v est en cache si moins de cacheSize défauts depuis son entrée
+    std::vector<uint32_t> stamp(vertexCount, 0);
+    std::vector<uint8_t> used(vertexCount, 0);
+    uint32_t clock = cacheSize + 1;
+    uint32_t unique = 0;
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        const uint32_t v = idx[i];
+        if (!used[v]) { used[v] = 1; ++unique; }
+        if (clock - stamp[v] > cacheSize) {
+            stamp[v] = clock++;
+            ++s.transformed;
+        }
+    }
+    s.acmr = (float)s.transformed / (float)(indexCount / 3);
+    s.atvr = unique ? (float)s.transformed / (float)unique : 0.0f;
+    return s;
+}
+
+void optimizeVertexCache(uint32_t* idx, std::size_t indexCount, std::size_t vertexCount) {
+    const std::size_t nTris = indexCount / 3;
+    if (nTris < 2 || vertexCount == 0) return;
+    const ScoreTables& T = scores();
+
+    // Adjacence sommet -> triangles (CSR) ; les triangles vivants sont en tête de chaque liste
+    std::vector<uint32_t> live(vertexCount, 0);
+    for (std::size_t i = 0; i < nTris * 3; ++i) live[idx[i]]++;
+    std::vector<uint32_t> first(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v) first[v + 1] = first[v] + live[v];
+    std::vector<uint32_t> adj(nTris * 3);
+    {
+        std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+        for (std::size_t t = 0; t < nTris; ++t)
+            for (int k = 0; k < 3; ++k) adj[fill[idx[3 * t + k]]++] = (uint32_t)t;
+    }
+
+    std::vector<int> cachePos(vertexCount, -1);
+    std::vector<float> vScore(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) vScore[v] = T.vertex(-1, live[v]);
+
+    std::vector<float> tScore(nTris);
+    std::vector<uint8_t> emitted(nTris, 0);
+    int best = -1;
+    float bestScore = -1.0f;
+    for (std::size_t t = 0; t < nTris; ++t) {
+        tScore[t] = vScore[idx[3 * t]] + vScore[idx[3 * t + 1]] + vScore[idx[3 * t + 2]];
+        if (tScore[t] > bestScore) { bestScore = tScore[t]; best = (int)t; }
+    }
+
+    std::vector<uint32_t> out(nTris * 3);
+    uint32_t cache[CACHE_SIZE + 3];
+    int cacheCount = 0;
+    std::size_t scan = 0; // repli quand le cache ne propose plus rien (impasse)
+
+    for (std::size_t n = 0; n < nTris; ++n) {
+        if (best < 0) {
+            while (emitted[scan]) ++scan;
+            best = (int)scan;
+        }
+        const uint32_t* tri = idx + 3 * (std::size_t)best;
+        const uint32_t a = tri[0], b = tri[1], c = tri[2];
+        out[3 * n] = a; out[3 * n + 1] = b; out[3 * n + 2] = c;
+        emitted[best] = 1;
+
+        // Retire le triangle des listes vivantes de ses sommets
+        for (uint32_t v : { a, b, c }) {
+            uint32_t* list = &adj[first[v]];
+            for (uint32_t k = 0; k < live[v]; ++k) {
+                if (list[k] == (uint32_t)best) {
+                    std::swap(list[k], list[live[v] - 1]);
+                    --live[v];
+                    break;
+                }
+            }
+        }
+
+        // Cache LRU : le triangle en tête, puis les anciennes entrées
+        uint32_t next[CACHE_SIZE + 3];
+        int nextCount = 0;
+        next[nextCount++] = a;
+        if (b != a) next[nextCount++] = b;
+        if (c != a && c != b) next[nextCount++] = c;
+        for (int i = 0; i < cacheCount; ++i) {
+            const uint32_t v = cache[i];
+            if (v != a && v != b && v != c) next[nextCount++] = v;
+        }
+
+        // Scores des sommets touchés, puis des triangles vivants qui les utilisent
+        for (int i = 0; i < nextCount; ++i) {
+            const uint32_t v = next[i];
+            cachePos[v] = i < CACHE_SIZE ? i : -1;
+            vScore[v] = T.vertex(cachePos[v], live[v]);
+        }
+        best = -1;
+        bestScore = -1.0f;
+        for (int i = 0; i < nextCount; ++i) {
+            const uint32_t v = next[i];
+            for (uint32_t k = 0; k < live[v]; ++k) {
+                const uint32_t t = adj[first[v] + k];
+                const float s = vScore[idx[3 * t]] + vScore[idx[3 * t + 1]] + vScore[idx[3 * t + 2]];
+                tScore[t] = s;
+                if (s > bestScore) { bestScore = s; best = (int)t; }
+            }
+        }
+
+        cacheCount = std::min(nextCount, CACHE_SIZE);
+        std::copy(next, next + cacheCount, cache);
+    }
+
+    std::copy(out.begin(), out.end(), idx);
+}
+
+std::size_t optimizeVertexFetch(void* vertices, std::size_t vertexCount, std::size_t vertexSize,
+                                uint32_t* idx, std::size_t indexCount) {
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    uint32_t next = 0;
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        uint32_t& r = remap[idx[i]];
+        if (r == UINT32_MAX) r = next++;
+        idx[i] = r;
+    }
+
+    uint8_t* base = (uint8_t*)vertices;
+    std::vector<uint8_t> tmp((std::size_t)next * vertexSize);
+    for (std::size_t v = 0; v < vertexCount; ++v)
+        if (remap[v] != UINT32_MAX)
+            std::memcpy(&tmp[(std::size_t)remap[v] * vertexSize], base + v * vertexSize, vertexSize);
+    std::memcpy(base, tmp.data(), tmp.size());
+    return next;
+}
+
+void optimizeMeshData(MeshData& m) {
+    const std::size_t nv = m.pos.size() / 3;
+    optimizeVertexCache(m.idx.data(), m.idx.size(), nv);
+    const std::size_t kept = optimizeVertexFetch(m.pos.data(), nv, 3 * sizeof(float), m.idx.data(), m.idx.size());
+    m.pos.resize(kept * 3);
+}
+
+void optimizeModel(ObjModel& m) {
+    for (const ObjSubmesh& sm : m.submeshes)
+        optimizeVertexCache(m.idx.data() + sm.firstIndex, sm.indexCount, m.vertices.size());
+    const std::size_t kept = optimizeVertexFetch(m.vertices.data(), m.vertices.size(), sizeof(ObjVertex),
+                                                 m.idx.data(), m.idx.size());
+    m.vertices.resize(kept);
+}
+
+void quantizeVertices(const ObjVertex* in, std::size_t vertexCount, QuantizedVertex* out,
+                      float posScale[3], float posOffset[3]) {
+    float lo[3] = { 0.0f, 0.0f, 0.0f }, hi[3] = { 0.0f, 0.0f, 0.0f };
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        for (int k = 0; k < 3; ++k) {
+            const float p = in[v].pos[k];
+            lo[k] = v == 0 ? p : std::min(lo[k], p);
+            hi[k] = v == 0 ? p : std::max(hi[k], p);
+        }
+    }
+    for (int k = 0; k < 3; ++k) {
+        posOffset[k] = lo[k];
+        posScale[k] = hi[k] - lo[k];
+    }
+
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        const ObjVertex& s = in[v];
+        QuantizedVertex& d = out[v];
+        for (int k = 0; k < 3; ++k) {
+            const float t = posScale[k] > 0.0f ? (s.pos[k] - lo[k]) / posScale[k] : 0.0f;
+            d.pos[k] = (uint16_t)std::lround(std::max(0.0f, std::min(1.0f, t)) * 65535.0f);
+        }
+        d.pos[3] = 0;
+
+        // Octaèdre : projection sur |x|+|y|+|z| = 1, hémisphère z < 0 replié sur les coins
+        float nx = s.nrm[0], ny = s.nrm[1], nz = s.nrm[2];
+        const float l1 = std::fabs(nx) + std::fabs(ny) + std::fabs(nz);
+        if (l1 > 0.0f) {
+            nx /= l1; ny /= l1; nz /= l1;
+            if (nz < 0.0f) {
+                const float ox = (1.0f - std::fabs(ny)) * (nx >= 0.0f ? 1.0f : -1.0f);
+                const float oy = (1.0f - std::fabs(nx)) * (ny >= 0.0f ? 1.0f : -1.0f);
+                nx = ox; ny = oy;
+            }
+        } else {
+            nx = ny = 0.0f; // normale nulle -> (0, 0, 1)
+        }
+        d.oct[0] = snorm16(nx);
+        d.oct[1] = snorm16(ny);
+
+        d.uv[0] = toHalf(s.uv[0]);
+        d.uv[1] = toHalf(s.uv[1]);
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Geometries/geometries.hpp"
+#include "ObjLoader/obj_loader.hpp"
+
+/**
+ * @file mesh_optimizer.hpp
+ * @brief Optimisations post-chargement des maillages : ordre des triangles (cache de sommets
+ *        post-transformation), ordre des sommets (fetch), formats de sommets quantifiés.
+ *
+ * @details
+ *  - optimizeVertexCache() : algorithme de Forsyth (« Linear-Speed Vertex Cache
+ *    Optimisation ») sur un cache LRU simulé de 32 entrées. Ne change que l'ordre des
+ *    triangles (et ne les fait jamais sortir de leur plage : appelé par sous-maillage).
+ *  - optimizeVertexFetch() : renumérote les sommets dans l'ordre de première utilisation
+ *    (lecture quasi séquentielle du VBO) et retire les sommets non référencés.
+ *  - quantizeVertices() : ObjVertex (32 octets) -> QuantizedVertex (16 octets) : position
+ *    16 bits normalisée dans l'AABB, normale octaédrique 2 x 16 bits, uv en demi-flottants.
+ *  - analyzeVertexCache() : ACMR / ATVR sur un cache FIFO simulé (mesure avant / après).
+ */
+
+/**
+ * @struct VertexCacheStats
+ * @brief Efficacité du cache de sommets pour un ordre de triangles donné.
+ */
+struct VertexCacheStats {
+    uint32_t transformed = 0; ///< Sommets (re)transformés : défauts de cache.
+    float acmr = 0.0f;        ///< Average Cache Miss Ratio : transformés / triangles (0.5 idéal, 3 pire).
+    float atvr = 0.0f;        ///< Average Transform to Vertex Ratio : transformés / sommets utilisés (1 idéal).
+};
+
+/**
+ * @brief Simule un cache de sommets FIFO et mesure ACMR / ATVR.
+ * @param cacheSize Taille du cache simulé (16 : ordre de grandeur des GPU actuels).
+ */
+VertexCacheStats analyzeVertexCache(const uint32_t* idx, std::size_t indexCount,
+                                    std::size_t vertexCount, unsigned cacheSize = 16);
+
+/**
+ * @brief Réordonne les triangles pour le cache de sommets post-transformation (Forsyth).
+ * @param idx Indices de triangles, réordonnés sur place (3 par triangle).
+ * @param vertexCount Nombre de sommets (indices < vertexCount).
+ */
+void optimizeVertexCache(uint32_t* idx, std::size_t indexCount, std::size_t vertexCount);
+
+/**
+ * @brief Renumérote les sommets dans l'ordre de première utilisation par les indices.
+ * @param vertices Sommets (vertexCount x vertexSize octets), réordonnés sur place.
+ * @param idx Indices, remappés sur place.
+ * @return Nouveau nombre de sommets (les sommets non référencés sont retirés).
+ */
+std::size_t optimizeVertexFetch(void* vertices, std::size_t vertexCount, std::size_t vertexSize,
+                                uint32_t* idx, std::size_t indexCount);
+
+/// @brief Cache de sommets puis fetch sur un maillage de positions.
+void optimizeMeshData(MeshData& m);
+
+/// @brief Cache de sommets (par sous-maillage : les plages restent valides) puis fetch sur tout le modèle.
+void optimizeModel(ObjModel& m);
+
+/**
+ * @struct QuantizedVertex
+ * @brief Sommet compact (16 octets) : attributs 0 = position, 3 = normale octaédrique, 2 = uv.
+ * @details Position : q / 65535 dans [0, 1], à remettre dans l'AABB (posScale, posOffset,
+ *          voir Mesh) ; pos[3] est un bourrage (alignement 4 octets des attributs).
+ */
+struct QuantizedVertex {
+    uint16_t pos[4];  ///< GL_UNSIGNED_SHORT normalisé.
+    int16_t oct[2];   ///< GL_SHORT normalisé, décodé par MESH_VS.
+    uint16_t uv[2];   ///< GL_HALF_FLOAT.
+};
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex doit faire 16 octets");
+
+/**
+ * @brief Quantifie des sommets entrelacés.
+ * @param out Tableau de vertexCount sommets.
+ * @param posScale,posOffset Déquantification : position = posOffset + posScale * (q / 65535).
+ */
+void quantizeVertices(const ObjVertex* in, std::size_t vertexCount, QuantizedVertex* out,
+                      float posScale[3], float posOffset[3]);
@@ -0,0 +1,249 @@
+/**
+ * @file mesh_simplify.cpp
+ * @brief Implémentation de la simplification quadrique et des niveaux de détail.
+ */
+
+#include "mesh_simplify.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct Quadric
+ * @brief Forme quadratique symétrique 4x4 (10 coefficients) : somme des carrés des distances à des plans.
+ */
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+
+    void addPlane(double a, double b, double c, double d) {
+        a2 += a * a; ab += a * b; ac += a * c; ad += a * d;
+        b2 += b * b; bc += b * c; bd += b * d;
+        c2 += c * c; cd += c * d;
+        d2 += d * d;
+    }
+    void add(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+    }
+    double eval(const float* p) const {
+        const double x = p[0], y = p[1], z = p[2];
+        return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+             + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+             + c2 * z * z + 2 * cd * z
+             + d2;
+    }
+};
+
+// Normale non normalisée (b - a) x (c - a)
+void triNormal(const float* a, const float* b, const float* c, double n[3]) {
+    const double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    const double e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+/**
+ * @class Simplifier
+ * @brief État d'une simplification progressive du LOD 0 d'un modèle (LOD après LOD).
+ */
+class Simplifier {
+public:
+    explicit Simplifier(const ObjModel& m) : model(m) {
+        const std::size_t nv = m.vertices.size();
+        const std::size_t perLod = m.submeshesPerLod();
+
+        for (std::size_t s = 0; s < perLod; ++s) {
+            const ObjSubmesh& sm = m.submeshes[s];
+            for (uint32_t i = 0; i + 2 < sm.indexCount; i += 3) {
+                for (int k = 0; k < 3; ++k) tris.push_back(m.idx[sm.firstIndex + i + k]);
+                triSub.push_back((uint32_t)s);
+            }
+        }
+        alive.assign(triSub.size(), 1);
+        aliveCount = triSub.size();
+
+        // Quadriques : plans des triangles incidents (non pondérés : le coût est une distance²)
+        quadrics.assign(nv, Quadric{});
+        for (std::size_t t = 0; t < triSub.size(); ++t) {
+            const uint32_t* v = &tris[3 * t];
+            double n[3];
+            triNormal(pos(v[0]), pos(v[1]), pos(v[2]), n);
+            const double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len <= 0.0) continue;
+            n[0] /= len; n[1] /= len; n[2] /= len;
+            const double d = -(n[0] * pos(v[0])[0] + n[1] * pos(v[0])[1] + n[2] * pos(v[0])[2]);
+            for (int k = 0; k < 3; ++k) quadrics[v[k]].addPlane(n[0], n[1], n[2], d);
+        }
+
+        // Verrous : arêtes portées par un seul triangle (bord, couture) ou plus de deux
+        std::vector<uint64_t> edges;
+        edges.reserve(tris.size());
+        for (std::size_t t = 0; t < triSub.size(); ++t)
+            for (int k = 0; k < 3; ++k) edges.push_back(edgeKey(tris[3 * t + k], tris[3 * t + (k + 1) % 3]));
+        std::sort(edges.begin(), edges.end());
+        locked.assign(nv, 0);
+        for (std::size_t i = 0; i < edges.size();) {
+            std::size_t j = i;
+            while (j < edges.size() && edges[j] == edges[i]) ++j;
+            if (j - i != 2) {
+                locked[(uint32_t)(edges[i] >> 32)] = 1;
+                locked[(uint32_t)edges[i]] = 1;
+            }
+            i = j;
+        }
+    }
+
+    std::size_t triangles() const { return aliveCount; }
+    float error() const { return (float)std::sqrt(std::max(0.0, maxCost)); }
+
+    /// @brief Contracte des arêtes jusqu'à target triangles (ou blocage).
+    void run(std::size_t target) {
+        while (aliveCount > target) {
+            if (pass(aliveCount - target) == 0) break;
+        }
+    }
+
+    /// @brief Ajoute les triangles restants au modèle : un sous-maillage par matériau.
+    void emit(ObjModel& m) const {
+        const std::size_t perLod = m.submeshesPerLod();
+        std::vector<ObjSubmesh> lod(perLod);
+        for (std::size_t s = 0; s < perLod; ++s) {
+            lod[s].material = m.submeshes[s].material;
+            lod[s].firstIndex = (uint32_t)m.idx.size();
+            for (std::size_t t = 0; t < triSub.size(); ++t) {
+                if (!alive[t] || triSub[t] != s) continue;
+                m.idx.insert(m.idx.end(), &tris[3 * t], &tris[3 * t] + 3);
+            }
+            lod[s].indexCount = (uint32_t)m.idx.size() - lod[s].firstIndex;
+        }
+        m.submeshes.insert(m.submeshes.end(), lod.begin(), lod.end());
+    }
+
+private:
+    struct Collapse { double cost; uint32_t from, to; };
+
+    static uint64_t edgeKey(uint32_t a, uint32_t b) {
+        return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+    const float* pos(uint32_t v) const { return model.vertices[v].pos; }
+
+    // Une passe : contractions indépendantes (aucune extrémité déjà déplacée), par coût croissant
+    std::size_t pass(std::size_t need) {
+        const std::size_t nv = model.vertices.size();
+
+        // Adjacence sommet -> triangles vivants
+        adjFirst.assign(nv + 1, 0);
+        for (std::size_t t = 0; t < triSub.size(); ++t)
+            if (alive[t]) for (int k = 0; k < 3; ++k) adjFirst[tris[3 * t + k] + 1]++;
+        for (std::size_t v = 0; v < nv; ++v) adjFirst[v + 1] += adjFirst[v];
+        adj.resize(adjFirst[nv]);
+        {
+            std::vector<uint32_t> fill(adjFirst.begin(), adjFirst.end() - 1);
+            for (std::size_t t = 0; t < triSub.size(); ++t)
+                if (alive[t]) for (int k = 0; k < 3; ++k) adj[fill[tris[3 * t + k]]++] = (uint32_t)t;
+        }
+
+        // Arêtes candidates, meilleur sens de contraction
+        std::vector<uint64_t> edges;
+        edges.reserve(aliveCount * 3);
+        for (std::size_t t = 0; t < triSub.size(); ++t)
+            if (alive[t]) for (int k = 0; k < 3; ++k) edges.push_back(edgeKey(tris[3 * t + k], tris[3 * t + (k + 1) % 3]));
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        std::vector<Collapse> cand;
+        cand.reserve(edges.size());
+        for (uint64_t e : edges) {
+            const uint32_t a = (uint32_t)(e >> 32), b = (uint32_t)e;
+            if (locked[a] && locked[b]) continue;
+            Quadric q = quadrics[a];
+            q.add(quadrics[b]);
+            const double toB = locked[a] ? 1e300 : q.eval(pos(b));
+            const double toA = locked[b] ? 1e300 : q.eval(pos(a));
+            if (toB <= toA) cand.push_back({ toB, a, b });
+            else cand.push_back({ toA, b, a });
+        }
+        std::sort(cand.begin(), cand.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        touched.assign(nv, 0);
+        std::size_t removed = 0;
+        for (const Collapse& c : cand) {
+            if (removed >= need) break;
+            if (touched[c.from] || touched[c.to]) continue;
+            if (flips(c.from, c.to)) continue;
+
+            for (uint32_t k = adjFirst[c.from]; k < adjFirst[c.from + 1]; ++k) {
+                const uint32_t t = adj[k];
+                if (!alive[t]) continue;
+                uint32_t* v = &tris[3 * t];
+                for (int j = 0; j < 3; ++j) if (v[j] == c.from) v[j] = c.to;
+                if (v[0] == v[1] || v[1] == v[2] || v[0] == v[2]) {
+                    alive[t] = 0;
+                    --aliveCount;
+                    ++removed;
+                }
+            }
+            quadrics[c.to].add(quadrics[c.from]);
+            maxCost = std::max(maxCost, c.cost);
+            touched[c.from] = touched[c.to] = 1;
+        }
+        return removed;
+    }
+
+    // Vrai si déplacer from sur to retourne (ou aplatit) un triangle qui reste
+    bool flips(uint32_t from, uint32_t to) const {
+        for (uint32_t k = adjFirst[from]; k < adjFirst[from + 1]; ++k) {
+            const uint32_t t = adj[k];
+            if (!alive[t]) continue;
+            const uint32_t* v = &tris[3 * t];
+            if (v[0] == to || v[1] == to || v[2] == to) continue; // disparaît
+            const float* p[3] = { pos(v[0]), pos(v[1]), pos(v[2]) };
+            double n0[3], n1[3];
+            triNormal(p[0], p[1], p[2], n0);
+            for (int j = 0; j < 3; ++j) if (v[j] == from) p[j] = pos(to);
+            triNormal(p[0], p[1], p[2], n1);
+            const double d = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+            const double l0 = n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2];
+            const double l1 = n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2];
+            if (d <= 0.0 || d * d < 0.04 * l0 * l1) return true; // plus de ~78° de rotation
+        }
+        return false;
+    }
+
+    const ObjModel& model;
+    std::vector<uint32_t> tris;     ///< Triangles du LOD 0, contractés au fil des passes.
+    std::vector<uint32_t> triSub;   ///< Sous-maillage (matériau) de chaque triangle.
+    std::vector<uint8_t> alive;
+    std::size_t aliveCount = 0;
+    std::vector<Quadric> quadrics;
+    std::vector<uint8_t> locked;
+    std::vector<uint8_t> touched;
+    std::vector<uint32_t> adjFirst, adj;
+    double maxCost = 0.0;
+};
+
+} // namespace
+
+uint32_t buildLods(ObjModel& m, uint32_t maxLods, float ratio, std::size_t minTriangles) {
+    if (m.lodCount != 1 || m.submeshes.empty() || m.vertices.empty()) return m.lodCount;
+    maxLods = std::min(maxLods, OBJ_MAX_LODS);
+
+    Simplifier s(m);
+    std::size_t prev = s.triangles();
+    for (uint32_t lod = 1; lod < maxLods; ++lod) {
+        if (prev < minTriangles) break;
+        s.run((std::size_t)((double)prev * ratio));
+        if ((double)s.triangles() > 0.9 * (double)prev) break; // coutures : plus rien à gagner
+
+        s.emit(m);
+        m.lodError[lod] = s.error();
+        m.lodCount++;
+        prev = s.triangles();
+    }
+    return m.lodCount;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "ObjLoader/obj_loader.hpp"
+
+/**
+ * @file mesh_simplify.hpp
+ * @brief Simplification par contraction d'arêtes (quadriques de Garland-Heckbert) et
+ *        génération des niveaux de détail d'un modèle.
+ *
+ * @details
+ * Les contractions se font sur les indices uniquement : un sommet est fusionné sur un de ses
+ * voisins existants (pas de nouveau sommet), si bien que tous les LOD partagent le VBO du
+ * modèle et ne coûtent que leurs indices. Par passe, les arêtes sont triées par coût
+ * quadrique et contractées tant qu'aucune de leurs extrémités n'a déjà bougé ; une
+ * contraction qui retournerait un triangle voisin est refusée.
+ *
+ * Les sommets situés sur un bord du maillage indexé (bord ouvert, couture uv / normale,
+ * où les sommets sont dupliqués) sont verrouillés : la texture ne se déchire pas, au prix
+ * d'une réduction plus faible sur les modèles très découpés.
+ */
+
+/**
+ * @brief Ajoute à un modèle jusqu'à maxLods - 1 niveaux simplifiés.
+ * @param m Modèle (LOD 0 seul) ; indices et sous-maillages des LOD ajoutés à la suite.
+ * @param maxLods Nombre de niveaux voulus, LOD 0 compris (borné par OBJ_MAX_LODS).
+ * @param ratio Fraction de triangles conservée d'un niveau au suivant.
+ * @param minTriangles En dessous, on ne simplifie plus.
+ * @return Nombre de niveaux du modèle (1 si la simplification n'apporte rien).
+ * @details Un niveau qui retire moins de 10 % des triangles du précédent n'est pas gardé
+ *          (coutures trop nombreuses) et arrête la génération.
+ */
+uint32_t buildLods(ObjModel& m, uint32_t maxLods = OBJ_MAX_LODS, float ratio = 0.5f,
+                   std::size_t minTriangles = 256);
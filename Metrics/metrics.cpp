@@ -0,0 +1,202 @@
+/**
+ * @file metrics.cpp
+ * @brief Implémentation du registre de métriques et de sa publication en mémoire partagée.
+ */
+
+#include "metrics.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+uint64_t toBits(double v) {
+    uint64_t b;
+    std::memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+double fromBits(uint64_t b) {
+    double v;
+    std::memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+double decode(MetricKind kind, uint64_t bits) {
+    return kind == MetricKind::Gauge ? fromBits(bits) : (double)bits;
+}
+
+constexpr std::size_t SHM_BYTES =
+    sizeof(MetricsShmHeader) + MetricsRegistry::MAX_METRICS * sizeof(MetricsShmEntry);
+
+} // namespace
+
+MetricsRegistry& metrics() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+int MetricsRegistry::registerMetric(const char* name, MetricKind kind) {
+    std::lock_guard<std::mutex> lock(registerMutex);
+    const int n = count.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+        if (std::strncmp(slots[i].name, name, NAME_LEN - 1) == 0) return i;
+    if (n >= MAX_METRICS) return -1;
+    std::strncpy(slots[n].name, name, NAME_LEN - 1);
+    slots[n].kind = kind;
+    slots[n].bits.store(kind == MetricKind::Gauge ? toBits(0.0) : 0, std::memory_order_relaxed);
+    count.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+void MetricsRegistry::set(int id, double v) {
+    if (id >= 0) slots[id].bits.store(toBits(v), std::memory_order_relaxed);
+}
+
+double MetricsRegistry::value(int id) const {
+    return decode(slots[id].kind, bits(id));
+}
+
+MetricsPublisher::~MetricsPublisher() {
+    stop();
+}
+
+bool MetricsPublisher::start(const std::string& shmName, int periodMs, MetricsRegistry& registry) {
+    stop();
+#ifdef _WIN32
+    (void)shmName; (void)periodMs; (void)registry;
+    return false;
+#else
+    const int fd = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) return false;
+    if (ftruncate(fd, (off_t)SHM_BYTES) != 0) {
+        close(fd);
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+    void* p = mmap(nullptr, SHM_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    reg = &registry;
+    name = shmName;
+    map = p;
+    mapBytes = SHM_BYTES;
+    period = periodMs;
+    stopping = false;
+
+    MetricsShmHeader* h = (MetricsShmHeader*)map;
+    std::memcpy(h->magic, "ARMT", 4);
+    h->version = 1;
+    h->seq.store(0, std::memory_order_relaxed);
+    h->pid = (int64_t)getpid();
+    write();
+
+    worker = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            wake.wait_for(lock, std::chrono::milliseconds(period));
+            if (!stopping) write();
+        }
+    });
+    return true;
+#endif
+}
+
+void MetricsPublisher::stop() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+#ifndef _WIN32
+    if (map) {
+        write();
+        munmap(map, mapBytes);
+        shm_unlink(name.c_str());
+    }
+#endif
+    map = nullptr;
+    mapBytes = 0;
+}
+
+void MetricsPublisher::publish() {
+    std::lock_guard<std::mutex> lock(mutex);
+    write();
+}
+
+void MetricsPublisher::write() {
+    if (!map || !reg) return;
+    MetricsShmHeader* h = (MetricsShmHeader*)map;
+    MetricsShmEntry* e = (MetricsShmEntry*)(h + 1);
+
+    const uint32_t s = h->seq.load(std::memory_order_relaxed);
+    h->seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const int n = reg->size();
+    for (int i = 0; i < n; ++i) {
+        std::memcpy(e[i].name, reg->name(i), MetricsRegistry::NAME_LEN);
+        e[i].kind = (uint32_t)reg->kind(i);
+        e[i].reserved = 0;
+        e[i].bits = reg->bits(i);
+    }
+    h->count = (uint32_t)n;
+    h->updateNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    h->publishes++;
+
+    h->seq.store(s + 2, std::memory_order_release);
+}
+
+bool readMetricsShm(const std::string& shmName, MetricsSnapshot& out) {
+#ifdef _WIN32
+    (void)shmName; (void)out;
+    return false;
+#else
+    const int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    void* p = mmap(nullptr, SHM_BYTES, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+
+    const MetricsShmHeader* h = (const MetricsShmHeader*)p;
+    const MetricsShmEntry* e = (const MetricsShmEntry*)(h + 1);
+    bool ok = false;
+    if (std::memcmp(h->magic, "ARMT", 4) == 0 && h->version == 1) {
+        MetricsShmEntry copy[MetricsRegistry::MAX_METRICS];
+        for (int attempt = 0; attempt < 100 && !ok; ++attempt) {
+            const uint32_t s1 = h->seq.load(std::memory_order_acquire);
+            if (s1 & 1u) { std::this_thread::yield(); continue; }
+            const uint32_t n = std::min<uint32_t>(h->count, MetricsRegistry::MAX_METRICS);
+            std::memcpy(copy, e, n * sizeof(MetricsShmEntry));
+            out.pid = h->pid;
+            out.updateNs = h->updateNs;
+            out.publishes = h->publishes;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (h->seq.load(std::memory_order_relaxed) != s1) continue;
+
+            out.items.clear();
+            for (uint32_t i = 0; i < n; ++i) {
+                copy[i].name[MetricsRegistry::NAME_LEN - 1] = '\0';
+                out.items.push_back({ copy[i].name, (MetricKind)copy[i].kind, decode((MetricKind)copy[i].kind, copy[i].bits) });
+            }
+            ok = true;
+        }
+    }
+    munmap(p, SHM_BYTES);
+    return ok;
+#endif
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file metrics.hpp
+ * @brief Métriques de production (compteurs et jauges) mises à jour par atomiques relâchés,
+ *        publiées périodiquement dans un segment de mémoire partagée POSIX.
+ *
+ * @details
+ * - MetricsRegistry : tableau fixe de MAX_METRICS emplacements. L'enregistrement d'un nom
+ *   prend un verrou (une fois, au démarrage) ; add() / set() ne sont qu'un fetch_add ou un
+ *   store relaxed, appelables depuis n'importe quel thread.
+ * - MetricsPublisher : thread qui recopie le registre toutes les periodMs ms dans le
+ *   segment (shm_open). Les lecteurs externes (arcube_metrics, Tools/metrics_reader.cpp)
+ *   ne touchent jamais le registre ni la boucle principale. Le segment est protégé par un
+ *   seqlock : seq impair pendant l'écriture, le lecteur recommence si seq a changé.
+ *
+ * Usage :
+ * @code
+ * const int mFrames = metrics().counter("frames");
+ * const int mFps    = metrics().gauge("fps");
+ * metrics().add(mFrames);
+ * metrics().set(mFps, 59.8);
+ * MetricsPublisher pub; pub.start();          // /arcube_metrics, 4 fois par seconde
+ * @endcode
+ */
+
+enum class MetricKind : uint32_t { Counter = 0, Gauge = 1 };
+
+/**
+ * @class MetricsRegistry
+ * @brief Emplacements nommés à valeur atomique (compteur entier ou jauge double).
+ */
+class MetricsRegistry {
+public:
+    static constexpr int MAX_METRICS = 64;
+    static constexpr int NAME_LEN = 48;    ///< Terminateur compris.
+
+    /// @brief Enregistre (ou retrouve) un compteur. @return Identifiant, -1 si le registre est plein.
+    int counter(const char* name) { return registerMetric(name, MetricKind::Counter); }
+    /// @brief Enregistre (ou retrouve) une jauge. @return Identifiant, -1 si le registre est plein.
+    int gauge(const char* name) { return registerMetric(name, MetricKind::Gauge); }
+
+    void add(int id, uint64_t n = 1) {
+        if (id >= 0) slots[id].bits.fetch_add(n, std::memory_order_relaxed);
+    }
+    void set(int id, double v);
+
+    int size() const { return count.load(std::memory_order_acquire); }
+    const char* name(int id) const { return slots[id].name; }
+    MetricKind kind(int id) const { return slots[id].kind; }
+    /// @brief Valeur brute (compteur, ou bits IEEE 754 d'une jauge).
+    uint64_t bits(int id) const { return slots[id].bits.load(std::memory_order_relaxed); }
+    /// @brief Valeur en double (compteur converti ou jauge).
+    double value(int id) const;
+
+private:
+    int registerMetric(const char* name, MetricKind kind);
+
+    struct Slot {
+        char name[NAME_LEN] = {};
+        MetricKind kind = MetricKind::Counter;
+        std::atomic<uint64_t> bits{ 0 };
+    };
+    Slot slots[MAX_METRICS];
+    std::atomic<int> count{ 0 };
+    std::mutex registerMutex;
+};
+
+/// @brief Registre partagé de l'application.
+MetricsRegistry& metrics();
+
+/// @brief En-tête du segment partagé (suivi de count MetricsShmEntry).
+struct MetricsShmHeader {
+    char magic[4];                ///< "ARMT"
+    uint32_t version;
+    std::atomic<uint32_t> seq;    ///< Seqlock : impair pendant l'écriture.
+    uint32_t count;
+    int64_t pid;
+    uint64_t updateNs;            ///< CLOCK_REALTIME de la dernière publication.
+    uint64_t publishes;
+};
+
+/// @brief Une métrique publiée (64 octets).
+struct MetricsShmEntry {
+    char name[MetricsRegistry::NAME_LEN];
+    uint32_t kind;                ///< MetricKind.
+    uint32_t reserved;
+    uint64_t bits;                ///< Comme MetricsRegistry::bits().
+};
+static_assert(sizeof(MetricsShmEntry) == 64, "MetricsShmEntry doit faire 64 octets");
+
+/**
+ * @class MetricsPublisher
+ * @brief Copie périodique du registre dans un segment POSIX (thread dédié).
+ */
+class MetricsPublisher {
+public:
+    ~MetricsPublisher();
+
+    /**
+     * @brief Crée le segment et démarre le thread de publication.
+     * @return false si le segment ne peut pas être créé (ou plateforme sans shm_open).
+     */
+    bool start(const std::string& shmName = "/arcube_metrics", int periodMs = 250,
+               MetricsRegistry& registry = metrics());
+    /// @brief Arrête le thread, publie une dernière fois et supprime le segment.
+    void stop();
+
+    /// @brief Publie immédiatement, sans attendre la période.
+    void publish();
+
+private:
+    void write(); ///< Copie registre -> segment (appelant : mutex tenu ou thread arrêté).
+
+    MetricsRegistry* reg = nullptr;
+    std::string name;
+    void* map = nullptr;
+    std::size_t mapBytes = 0;
+    int period = 250;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread worker;
+};
+
+/**
+ * @struct MetricsSnapshot
+ * @brief Lecture cohérente d'un segment publié.
+ */
+struct MetricsSnapshot {
+    struct Item {
+        std::string name;
+        MetricKind kind;
+        double value;
+    };
+    int64_t pid = 0;
+    uint64_t updateNs = 0;
+    uint64_t publishes = 0;
+    std::vector<Item> items;
+};
+
+/**
+ * @brief Lit le segment shmName (seqlock, quelques essais).
+ * @return false si le segment n'existe pas, est invalide, ou n'a pas pu être lu de façon cohérente.
+ */
+bool readMetricsShm(const std::string& shmName, MetricsSnapshot& out);
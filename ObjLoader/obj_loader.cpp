@@ -0,0 +1,534 @@
+/**
+ * @file obj_loader.cpp
+ * @brief Implémentation du parseur OBJ parallèle (scanner from_chars + VKeyMap).
+ */
+
+#include "obj_loader.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+// VKeyMap
+// ---------------------------------------------------------------------------
+
+VKeyMap::VKeyMap(std::size_t expected) {
+    std::size_t cap = 16;
+    while (cap < expected * 2) cap <<= 1;
+    rehash(cap);
+}
+
+std::size_t VKeyMap::hash(const VKey& k) {
+    uint64_t h = (uint64_t)(uint32_t)k.vi * 0x9E3779B97F4A7C15ull;
+    h ^= (uint64_t)(uint32_t)k.ti * 0xC2B2AE3D27D4EB4Full;
+    h ^= (uint64_t)(uint32_t)k.ni * 0x165667B19E3779F9ull;
+    return (std::size_t)(h ^ (h >> 29));
+}
+
+void VKeyMap::clear() {
+    for (Slot& s : slots) s.key.vi = -1;
+    count = 0;
+}
+
+void VKeyMap::rehash(std::size_t newCapacity) {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(newCapacity, Slot{ VKey{ -1, -1, -1 }, 0u });
+    mask = newCapacity - 1;
+    count = 0;
+
+    bool dummy;
+    for (const Slot& s : old)
+        if (s.key.vi >= 0) findOrInsert(s.key, s.value, dummy);
+}
+
+uint32_t VKeyMap::findOrInsert(const VKey& k, uint32_t value, bool& inserted) {
+    if ((count + 1) * 2 > slots.size()) rehash(slots.size() * 2);
+
+    std::size_t h = hash(k) & mask;
+    for (;;) {
+        Slot& s = slots[h];
+        if (s.key.vi < 0) {
+            s.key = k;
+            s.value = value;
+            ++count;
+            inserted = true;
+            return value;
+        }
+        if (s.key == k) {
+            inserted = false;
+            return s.value;
+        }
+        h = (h + 1) & mask;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Scanner
+// ---------------------------------------------------------------------------
+
+namespace {
+
+/// @brief Coin de face : indices bruts (1-based / négatifs / 0 = absent), puis résolus (< 0 : absent).
+struct Corner {
+    int32_t v;
+    int32_t t;
+    int32_t n;
+};
+
+/// @brief Face : plage de coins, nombre de v / vt / vn du bloc vus avant elle, matériau courant.
+struct FaceRec {
+    uint32_t firstCorner;
+    uint32_t nCorners;
+    uint32_t vBefore;
+    uint32_t tBefore;
+    uint32_t nBefore;
+    int32_t mtl;       ///< Dernier "usemtl" du bloc avant la face (-1 : hérité du bloc précédent).
+};
+
+/// @brief Résultat du scan d'un bloc de lignes.
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::vector<float> pos;
+    std::vector<float> uv;
+    std::vector<float> nrm;
+    std::vector<Corner> corners;
+    std::vector<FaceRec> faces;
+    std::vector<std::string> mtlNames; ///< Arguments des "usemtl" du bloc, dans l'ordre.
+    std::string mtllib;                ///< Premier "mtllib" du bloc.
+    std::size_t vBase = 0, tBase = 0, nBase = 0; ///< Sommes préfixes des blocs précédents.
+    std::size_t triCount = 0;
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) ++p;
+    return p;
+}
+
+inline const char* nextLine(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', (std::size_t)(end - p));
+    return nl ? (const char*)nl + 1 : end;
+}
+
+/// @brief Reste de la ligne après le mot-clé, sans blancs de début et de fin.
+inline std::string_view lineArg(const char* p, const char* end) {
+    p = skipBlanks(p, end);
+    const char* e = p;
+    while (e < end && *e != '\n') ++e;
+    while (e > p && isBlank(e[-1])) --e;
+    return std::string_view(p, (std::size_t)(e - p));
+}
+
+/// @brief true si la ligne commence par le mot-clé kw suivi d'un blanc.
+inline bool isKeyword(const char* p, const char* end, std::string_view kw) {
+    return (std::size_t)(end - p) > kw.size() && std::memcmp(p, kw.data(), kw.size()) == 0 && isBlank(p[kw.size()]);
+}
+
+inline const char* parseFloat(const char* p, const char* end, float& v) {
+    if (p < end && *p == '+') ++p;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto r = std::from_chars(p, end, v);
+    return r.ec == std::errc() ? r.ptr : nullptr;
+#else
+    // Repli (bibliothèque sans from_chars flottant) : copie du jeton pour strtof
+    char buf[64];
+    std::size_t n = 0;
+    while (p + n < end && n < sizeof(buf) - 1 && !isBlank(p[n]) && p[n] != '\n') { buf[n] = p[n]; ++n; }
+    buf[n] = '\0';
+    char* e = nullptr;
+    v = std::strtof(buf, &e);
+    return e == buf ? nullptr : p + (e - buf);
+#endif
+}
+
+inline const char* parseInt(const char* p, const char* end, int32_t& v) {
+    if (p < end && *p == '+') ++p;
+    auto r = std::from_chars(p, end, v);
+    return r.ec == std::errc() ? r.ptr : nullptr;
+}
+
+/// @brief Lit jusqu'à n flottants séparés par des blancs (les manquants restent à 0).
+inline void parseFloats(const char* q, const char* end, float* out, int n, std::vector<float>& dst) {
+    for (int k = 0; k < n; ++k) out[k] = 0.0f;
+    for (int k = 0; k < n && q; ++k)
+        q = parseFloat(skipBlanks(q, end), end, out[k]);
+    dst.insert(dst.end(), out, out + n);
+}
+
+/**
+ * @brief Passe 1 : scanne les lignes d'un bloc.
+ * @param attribs Lit aussi vt / vn / usemtl / mtllib (sinon positions et faces seulement).
+ */
+void scanChunk(Chunk& c, bool attribs) {
+    const char* p = c.begin;
+    const char* end = c.end;
+    const std::size_t bytes = (std::size_t)(end - p);
+    c.pos.reserve(bytes / 16);
+    c.corners.reserve(bytes / 8);
+    c.faces.reserve(bytes / 32);
+
+    float tmp3[3];
+    int32_t curMtl = -1;
+
+    while (p < end) {
+        p = skipBlanks(p, end);
+        if (p + 1 >= end) break;
+
+        const char tag = p[0];
+        if (tag == 'v') {
+            if (isBlank(p[1])) parseFloats(p + 2, end, tmp3, 3, c.pos);
+            else if (attribs && p[1] == 't' && p + 2 < end && isBlank(p[2])) parseFloats(p + 3, end, tmp3, 2, c.uv);
+            else if (attribs && p[1] == 'n' && p + 2 < end && isBlank(p[2])) parseFloats(p + 3, end, tmp3, 3, c.nrm);
+        }
+        else if (tag == 'f' && isBlank(p[1])) {
+            FaceRec f{ (uint32_t)c.corners.size(), 0u, (uint32_t)(c.pos.size() / 3),
+                       (uint32_t)(c.uv.size() / 2), (uint32_t)(c.nrm.size() / 3), curMtl };
+            const char* q = p + 2;
+            for (;;) {
+                q = skipBlanks(q, end);
+                if (q >= end || *q == '\n') break;
+
+                Corner cr{ 0, 0, 0 };
+                const char* r = parseInt(q, end, cr.v);
+                if (r && r < end && *r == '/') {
+                    ++r;
+                    if (r < end && *r != '/') {
+                        const char* t = parseInt(r, end, cr.t);
+                        if (t) r = t;
+                    }
+                    if (r < end && *r == '/') {
+                        const char* t = parseInt(r + 1, end, cr.n);
+                        r = t ? t : r + 1;
+                    }
+                }
+                if (r) {
+                    c.corners.push_back(cr);
+                    ++f.nCorners;
+                    q = r;
+                }
+                // jeton restant (ou invalide) : avance jusqu'au prochain blanc
+                while (q < end && !isBlank(*q) && *q != '\n') ++q;
+            }
+            if (f.nCorners > 0) c.faces.push_back(f);
+            else c.corners.resize(f.firstCorner);
+        }
+        else if (attribs && tag == 'u' && isKeyword(p, end, "usemtl")) {
+            c.mtlNames.emplace_back(lineArg(p + 6, end));
+            curMtl = (int32_t)c.mtlNames.size() - 1;
+        }
+        else if (attribs && tag == 'm' && c.mtllib.empty() && isKeyword(p, end, "mtllib")) {
+            c.mtllib = std::string(lineArg(p + 6, end));
+        }
+        p = nextLine(p, end);
+    }
+}
+
+/// @brief Indice OBJ (1-based ou négatif) -> 0-based parmi les avail déjà lus (-1 : absent / invalide).
+inline int32_t resolveIndex(int32_t raw, int64_t avail) {
+    const int64_t idx = raw > 0 ? (int64_t)raw - 1 : (raw < 0 ? avail + raw : -1);
+    return (idx < 0 || idx >= avail) ? -1 : (int32_t)idx;
+}
+
+/**
+ * @brief Passe 2 : copie les attributs à leur place et résout les indices en indices globaux.
+ * @details Comme un parse séquentiel, un indice ne peut viser que les éléments déjà lus.
+ */
+void resolveChunk(Chunk& c, float* V, float* T, float* N) {
+    if (!c.pos.empty()) std::memcpy(V + c.vBase * 3, c.pos.data(), c.pos.size() * sizeof(float));
+    if (!c.uv.empty())  std::memcpy(T + c.tBase * 2, c.uv.data(), c.uv.size() * sizeof(float));
+    if (!c.nrm.empty()) std::memcpy(N + c.nBase * 3, c.nrm.data(), c.nrm.size() * sizeof(float));
+
+    std::size_t tris = 0;
+    for (const FaceRec& f : c.faces) {
+        const int64_t vAvail = (int64_t)c.vBase + f.vBefore;
+        const int64_t tAvail = (int64_t)c.tBase + f.tBefore;
+        const int64_t nAvail = (int64_t)c.nBase + f.nBefore;
+        uint32_t valid = 0;
+        for (uint32_t i = 0; i < f.nCorners; ++i) {
+            Corner& cr = c.corners[f.firstCorner + i];
+            cr.v = resolveIndex(cr.v, vAvail);
+            cr.t = resolveIndex(cr.t, tAvail);
+            cr.n = resolveIndex(cr.n, nAvail);
+            if (cr.v >= 0) ++valid;
+        }
+        if (valid >= 3) tris += valid - 2;
+    }
+    c.triCount = tris;
+}
+
+/**
+ * @brief Exécute fn(i) pour i dans [0, n) sur n threads (le thread appelant prend le dernier).
+ */
+template <class Fn>
+void parallelFor(std::size_t n, Fn fn) {
+    if (n <= 1) { if (n == 1) fn(0); return; }
+    std::vector<std::thread> pool;
+    pool.reserve(n - 1);
+    for (std::size_t i = 0; i + 1 < n; ++i) pool.emplace_back(fn, i);
+    fn(n - 1);
+    for (std::thread& t : pool) t.join();
+}
+
+/**
+ * @struct Scanned
+ * @brief Résultat des passes 1 et 2 : blocs résolus + attributs globaux contigus.
+ */
+struct Scanned {
+    std::vector<Chunk> chunks;
+    std::vector<float> V, T, N;
+    std::size_t totalTris = 0;
+};
+
+/**
+ * @brief Passes 1 et 2 (parallèles).
+ * @return false si aucun triangle valide.
+ */
+bool scanAndResolve(const char* data, std::size_t size, int threads, bool attribs, Scanned& s) {
+    if (!data || size == 0) return false;
+
+    // Découpage en blocs alignés sur les fins de ligne
+    const std::size_t minChunkBytes = 1u << 20;
+    std::size_t nChunks = threads > 0 ? (std::size_t)threads
+                                      : std::max(1u, std::thread::hardware_concurrency());
+    nChunks = std::max<std::size_t>(1, std::min(nChunks, size / minChunkBytes));
+
+    s.chunks.resize(nChunks);
+    const char* end = data + size;
+    const char* p = data;
+    for (std::size_t i = 0; i < nChunks; ++i) {
+        s.chunks[i].begin = p;
+        if (i + 1 == nChunks) p = end;
+        else p = std::max(p, nextLine(data + size / nChunks * (i + 1), end));
+        s.chunks[i].end = p;
+    }
+
+    parallelFor(nChunks, [&](std::size_t i) { scanChunk(s.chunks[i], attribs); });
+
+    std::size_t totalV = 0, totalT = 0, totalN = 0;
+    for (Chunk& c : s.chunks) {
+        c.vBase = totalV; totalV += c.pos.size() / 3;
+        c.tBase = totalT; totalT += c.uv.size() / 2;
+        c.nBase = totalN; totalN += c.nrm.size() / 3;
+    }
+    if (totalV == 0) return false;
+
+    s.V.resize(totalV * 3);
+    s.T.resize(totalT * 2);
+    s.N.resize(totalN * 3);
+    parallelFor(nChunks, [&](std::size_t i) {
+        resolveChunk(s.chunks[i], s.V.data(), s.T.data(), s.N.data());
+        std::vector<float>().swap(s.chunks[i].pos);
+        std::vector<float>().swap(s.chunks[i].uv);
+        std::vector<float>().swap(s.chunks[i].nrm);
+    });
+
+    for (const Chunk& c : s.chunks) s.totalTris += c.triCount;
+    return s.totalTris > 0;
+}
+
+/**
+ * @brief Parcourt les faces dans l'ordre du fichier : fn(chunk, face, coins valides, n).
+ * @details Les faces de moins de 3 coins valides sont ignorées (aucun sommet créé).
+ *          Les coins de chaque bloc sont libérés dès qu'il a été parcouru.
+ */
+template <class Fn>
+void forEachFace(Scanned& s, Fn fn) {
+    std::vector<Corner> valid;
+    for (Chunk& c : s.chunks) {
+        for (const FaceRec& f : c.faces) {
+            valid.clear();
+            for (uint32_t i = 0; i < f.nCorners; ++i) {
+                const Corner& cr = c.corners[f.firstCorner + i];
+                if (cr.v >= 0) valid.push_back(cr);
+            }
+            if (valid.size() >= 3) fn(c, f, valid.data(), valid.size());
+        }
+        std::vector<Corner>().swap(c.corners);
+        std::vector<FaceRec>().swap(c.faces);
+    }
+}
+
+/// @brief Ajoute les triangles en éventail d'une face (indices de sommets déjà dédupliqués).
+inline void emitFan(const uint32_t* face, std::size_t n, std::vector<uint32_t>& idx) {
+    for (std::size_t i = 1; i + 1 < n; ++i) {
+        idx.push_back(face[0]);
+        idx.push_back(face[i]);
+        idx.push_back(face[i + 1]);
+    }
+}
+
+/// @brief Normales lissées (somme des normales de faces pondérées par l'aire).
+void computeNormals(ObjModel& m) {
+    for (ObjVertex& v : m.vertices) v.nrm[0] = v.nrm[1] = v.nrm[2] = 0.0f;
+    for (std::size_t i = 0; i + 2 < m.idx.size(); i += 3) {
+        ObjVertex& a = m.vertices[m.idx[i]];
+        ObjVertex& b = m.vertices[m.idx[i + 1]];
+        ObjVertex& c = m.vertices[m.idx[i + 2]];
+        const float e1[3] = { b.pos[0] - a.pos[0], b.pos[1] - a.pos[1], b.pos[2] - a.pos[2] };
+        const float e2[3] = { c.pos[0] - a.pos[0], c.pos[1] - a.pos[1], c.pos[2] - a.pos[2] };
+        const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        for (ObjVertex* v : { &a, &b, &c })
+            for (int k = 0; k < 3; ++k) v->nrm[k] += n[k];
+    }
+    for (ObjVertex& v : m.vertices) {
+        const float l = std::sqrt(v.nrm[0] * v.nrm[0] + v.nrm[1] * v.nrm[1] + v.nrm[2] * v.nrm[2]);
+        if (l > 0.0f) for (int k = 0; k < 3; ++k) v.nrm[k] /= l;
+        else { v.nrm[0] = v.nrm[1] = 0.0f; v.nrm[2] = 1.0f; }
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// parseOBJ / parseOBJModel
+// ---------------------------------------------------------------------------
+
+bool parseOBJ(const char* data, std::size_t size, MeshData& out, int threads) {
+    out.pos.clear();
+    out.idx.clear();
+
+    Scanned s;
+    if (!scanAndResolve(data, size, threads, false, s)) return false;
+
+    // Passe 3 : déduplication par position + éventail, dans l'ordre du fichier
+    out.pos.reserve(s.V.size());
+    out.idx.reserve(s.totalTris * 3);
+
+    VKeyMap dedup(s.V.size() / 3);
+    std::vector<uint32_t> face;
+    forEachFace(s, [&](const Chunk&, const FaceRec&, const Corner* cr, std::size_t n) {
+        face.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            bool inserted;
+            const uint32_t id = dedup.findOrInsert(VKey{ cr[i].v, -1, -1 }, (uint32_t)(out.pos.size() / 3), inserted);
+            if (inserted) {
+                const float* p = &s.V[(std::size_t)cr[i].v * 3];
+                out.pos.insert(out.pos.end(), p, p + 3);
+            }
+            face.push_back(id);
+        }
+        emitFan(face.data(), face.size(), out.idx);
+    });
+
+    return !out.idx.empty();
+}
+
+bool parseOBJModel(const char* data, std::size_t size, ObjModel& out, int threads) {
+    out = ObjModel{};
+
+    Scanned s;
+    if (!scanAndResolve(data, size, threads, true, s)) return false;
+
+    for (const Chunk& c : s.chunks)
+        if (!c.mtllib.empty()) { out.mtllib = c.mtllib; break; }
+
+    // Passe 3 : déduplication (v, vt, vn) + éventail, triangles regroupés par matériau
+    out.vertices.reserve(s.V.size() / 3);
+    std::vector<std::vector<uint32_t>> perMaterial;
+
+    auto slotFor = [&](const std::string& name) -> int32_t {
+        for (std::size_t i = 0; i < out.materialNames.size(); ++i)
+            if (out.materialNames[i] == name) return (int32_t)i;
+        out.materialNames.push_back(name);
+        perMaterial.emplace_back();
+        return (int32_t)out.materialNames.size() - 1;
+    };
+
+    VKeyMap dedup(s.V.size() / 3);
+    std::vector<uint32_t> face;
+    std::vector<int32_t> chunkSlots;
+    const Chunk* slotsOf = nullptr;
+    int32_t current = -1;
+    forEachFace(s, [&](const Chunk& c, const FaceRec& f, const Corner* cr, std::size_t n) {
+        if (slotsOf != &c) {
+            slotsOf = &c;
+            chunkSlots.assign(c.mtlNames.size(), -1);
+        }
+        if (f.mtl >= 0) {
+            int32_t& slot = chunkSlots[f.mtl];
+            if (slot < 0) slot = slotFor(c.mtlNames[f.mtl]);
+            current = slot;
+        }
+        if (current < 0) current = slotFor(std::string()); // faces avant tout usemtl
+
+        face.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            const VKey k{ cr[i].v, cr[i].t, cr[i].n };
+            bool inserted;
+            const uint32_t id = dedup.findOrInsert(k, (uint32_t)out.vertices.size(), inserted);
+            if (inserted) {
+                ObjVertex v{};
+                std::memcpy(v.pos, &s.V[(std::size_t)k.vi * 3], sizeof(v.pos));
+                if (k.ni >= 0) { std::memcpy(v.nrm, &s.N[(std::size_t)k.ni * 3], sizeof(v.nrm)); out.hasNormals = true; }
+                if (k.ti >= 0) { std::memcpy(v.uv, &s.T[(std::size_t)k.ti * 2], sizeof(v.uv)); out.hasUVs = true; }
+                out.vertices.push_back(v);
+            }
+            face.push_back(id);
+        }
+        emitFan(face.data(), face.size(), perMaterial[current]);
+    });
+
+    // Un sous-maillage contigu par matériau
+    out.idx.reserve(s.totalTris * 3);
+    for (std::size_t m = 0; m < perMaterial.size(); ++m) {
+        if (perMaterial[m].empty()) continue;
+        out.submeshes.push_back({ (uint32_t)out.idx.size(), (uint32_t)perMaterial[m].size(), (uint32_t)m });
+        out.idx.insert(out.idx.end(), perMaterial[m].begin(), perMaterial[m].end());
+    }
+
+    if (!out.hasNormals) computeNormals(out);
+    return !out.idx.empty();
+}
+
+// ---------------------------------------------------------------------------
+// parseMTL
+// ---------------------------------------------------------------------------
+
+bool parseMTL(const char* data, std::size_t size, std::vector<ObjMaterial>& out) {
+    out.clear();
+    if (!data) return false;
+
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end) {
+        p = skipBlanks(p, end);
+        if (p >= end) break;
+
+        if (isKeyword(p, end, "newmtl")) {
+            out.emplace_back();
+            out.back().name = std::string(lineArg(p + 6, end));
+        }
+        else if (!out.empty()) {
+            ObjMaterial& m = out.back();
+            float tmp[3];
+            std::vector<float> vals;
+            if (isKeyword(p, end, "Kd")) {
+                parseFloats(p + 2, end, tmp, 3, vals);
+                m.diffuse = glm::vec4(vals[0], vals[1], vals[2], m.diffuse.a);
+            }
+            else if (isKeyword(p, end, "d")) {
+                parseFloats(p + 1, end, tmp, 1, vals);
+                m.diffuse.a = vals[0];
+            }
+            else if (isKeyword(p, end, "Tr")) {
+                parseFloats(p + 2, end, tmp, 1, vals);
+                m.diffuse.a = 1.0f - vals[0];
+            }
+            else if (isKeyword(p, end, "map_Kd")) {
+                // options éventuelles (-s, -o, ...) : le fichier est le dernier jeton
+                std::string_view arg = lineArg(p + 6, end);
+                const std::size_t sp = arg.find_last_of(" \t");
+                m.diffuseMap = std::string(sp == std::string_view::npos ? arg : arg.substr(sp + 1));
+            }
+        }
+        p = nextLine(p, end);
+    }
+    return !out.empty();
+}
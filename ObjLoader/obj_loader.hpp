@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Geometries/geometries.hpp"
+
+/**
+ * @file obj_loader.hpp
+ * @brief Parseur OBJ rapide : scanner std::from_chars sur un buffer (fichier projeté),
+ *        découpage en blocs parsés en parallèle puis fusion ordonnée.
+ *
+ * @details
+ * Trois passes :
+ *  1. (parallèle) chaque bloc de lignes est scanné : attributs "v"/"vt"/"vn" et coins des
+ *     faces "f" (indices bruts + nombre d'attributs locaux vus avant la face, pour les
+ *     indices négatifs) ;
+ *  2. (parallèle) une fois le nombre d'attributs par bloc connu (somme préfixe), ils sont
+ *     copiés à leur place et les indices résolus en indices globaux ;
+ *  3. (séquentiel) déduplication des sommets (table à adressage ouvert) et triangulation
+ *     en éventail, dans l'ordre du fichier : le résultat est identique à un parse séquentiel.
+ *
+ * Deux sorties :
+ *  - parseOBJ() : positions seules (MeshData), sommets dédupliqués par position ;
+ *  - parseOBJModel() : sommets entrelacés position/normale/uv dédupliqués sur (v, vt, vn),
+ *    triangles regroupés en un sous-maillage par matériau ("usemtl").
+ */
+
+/**
+ * @struct VKey
+ * @brief Clé identifiant un sommet OBJ (indices de position, texture et normale, 0-based).
+ */
+struct VKey {
+    int32_t vi; ///< Indice de position.
+    int32_t ti; ///< Indice de texture (-1 : absent).
+    int32_t ni; ///< Indice de normale (-1 : absent).
+
+    bool operator==(const VKey& o) const { return vi == o.vi && ti == o.ti && ni == o.ni; }
+};
+
+/**
+ * @class VKeyMap
+ * @brief Table de hachage VKey -> indice de sommet, adressage ouvert (sondage linéaire).
+ *
+ * @details
+ * Entrées contiguës (clé + valeur, 16 octets) : une recherche touche le plus souvent
+ * une seule ligne de cache, sans allocation par insertion. Facteur de charge <= 1/2.
+ */
+class VKeyMap {
+public:
+    explicit VKeyMap(std::size_t expected = 0);
+
+    /**
+     * @brief Retourne la valeur associée à k, ou insère value si k est absente.
+     * @param inserted true si k vient d'être insérée.
+     */
+    uint32_t findOrInsert(const VKey& k, uint32_t value, bool& inserted);
+
+    std::size_t size() const { return count; }
+    void clear();
+
+private:
+    struct Slot { VKey key; uint32_t value; };
+
+    static std::size_t hash(const VKey& k);
+    void rehash(std::size_t newCapacity);
+
+    std::vector<Slot> slots; ///< vi < 0 : case vide.
+    std::size_t mask = 0;
+    std::size_t count = 0;
+};
+
+/**
+ * @brief Parse un OBJ en mémoire (positions dédupliquées + indices de triangles).
+ * @param data Contenu du fichier (pas besoin de terminateur nul).
+ * @param size Taille en octets.
+ * @param out Maillage CPU (vidé puis rempli).
+ * @param threads Nombre de threads (0 : std::thread::hardware_concurrency()).
+ *                Les petits fichiers (< 1 Mo par bloc) utilisent moins de threads.
+ * @return true si de la géométrie a été lue.
+ * @note Les sommets sont dédupliqués par position seule (uv/normales ignorées).
+ */
+bool parseOBJ(const char* data, std::size_t size, MeshData& out, int threads = 0);
+
+/**
+ * @struct ObjVertex
+ * @brief Sommet entrelacé (32 octets) : attributs 0 = position, 1 = normale, 2 = uv.
+ */
+struct ObjVertex {
+    float pos[3];
+    float nrm[3];
+    float uv[2];
+};
+static_assert(sizeof(ObjVertex) == 32, "ObjVertex doit rester compact (32 octets)");
+
+/**
+ * @struct ObjSubmesh
+ * @brief Plage d'indices dessinée avec un même matériau.
+ */
+struct ObjSubmesh {
+    uint32_t firstIndex;  ///< Premier indice dans ObjModel::idx.
+    uint32_t indexCount;  ///< Nombre d'indices (3 par triangle).
+    uint32_t material;    ///< Indice dans ObjModel::materialNames.
+};
+
+/// @brief Nombre maximal de niveaux de détail d'un modèle (LOD 0 compris).
+constexpr uint32_t OBJ_MAX_LODS = 4;
+
+/**
+ * @struct ObjModel
+ * @brief Modèle OBJ complet : sommets entrelacés, indices groupés par matériau.
+ * @details Les niveaux de détail (voir buildLods()) partagent les sommets : chaque LOD ajoute
+ *          ses indices à la suite et un sous-maillage par matériau. submeshes est rangé par
+ *          LOD : submeshes[lod * submeshesPerLod() + s].
+ */
+struct ObjModel {
+    std::vector<ObjVertex> vertices;
+    std::vector<uint32_t> idx;
+    std::vector<ObjSubmesh> submeshes;        ///< Un par matériau utilisé (ordre d'apparition), par LOD.
+    std::vector<std::string> materialNames;   ///< Arguments de "usemtl" ("" : faces sans matériau).
+    std::string mtllib;                       ///< Premier "mtllib" (relatif au fichier OBJ).
+    bool hasNormals = false;                  ///< false : normales lissées calculées.
+    bool hasUVs = false;
+    uint32_t lodCount = 1;                    ///< Niveaux de détail (1 : modèle source seul).
+    float lodError[OBJ_MAX_LODS] = {};        ///< Erreur géométrique de chaque LOD (unités du modèle).
+
+    std::size_t submeshesPerLod() const { return submeshes.size() / lodCount; }
+};
+
+/**
+ * @struct ObjMaterial
+ * @brief Matériau lu dans un .mtl (sous-ensemble utile au rendu : diffus + texture).
+ */
+struct ObjMaterial {
+    std::string name;
+    glm::vec4 diffuse{1.0f};  ///< Kd (rgb) et d / 1 - Tr (alpha).
+    std::string diffuseMap;   ///< map_Kd, relatif au fichier .mtl ("" : aucune).
+};
+
+/**
+ * @brief Parse un OBJ en mémoire vers un modèle complet (normales, uv, matériaux).
+ * @param data Contenu du fichier.
+ * @param size Taille en octets.
+ * @param out Modèle (vidé puis rempli).
+ * @param threads Nombre de threads (0 : automatique).
+ * @return true si de la géométrie a été lue.
+ */
+bool parseOBJModel(const char* data, std::size_t size, ObjModel& out, int threads = 0);
+
+/**
+ * @brief Parse un fichier .mtl (newmtl, Kd, d, Tr, map_Kd).
+ * @return true si au moins un matériau a été lu.
+ */
+bool parseMTL(const char* data, std::size_t size, std::vector<ObjMaterial>& out);
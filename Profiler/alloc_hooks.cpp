@@ -0,0 +1,117 @@
+/**
+ * @file alloc_hooks.cpp
+ * @brief Remplacements globaux de operator new / delete qui alimentent alloc_tracker.
+ *
+ * @details
+ * Volontairement hors d'arcore : une bibliothèque statique n'est liée que si l'un de ses
+ * symboles est référencé, et un remplacement de operator new doit s'appliquer à tout
+ * l'exécutable ou pas du tout. Chaque cible instrumentée ajoute ce fichier à ses sources
+ * (voir l'option ARCUBE_ALLOC_TRACKER dans CMakeLists.txt).
+ *
+ * Les blocs viennent de malloc / free, comme l'implémentation par défaut ; la version
+ * alignée (C++17) passe par posix_memalign (_aligned_malloc sous Windows).
+ */
+
+#include "alloc_tracker.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+const bool linked = (allocMarkHooksLinked(), true);
+
+void* allocate(std::size_t n) {
+    if (n == 0) n = 1;
+    for (;;) {
+        if (void* p = std::malloc(n)) {
+            allocNoteNew(n);
+            return p;
+        }
+        std::new_handler h = std::get_new_handler();
+        if (!h) return nullptr;
+        h();
+    }
+}
+
+void* allocateAligned(std::size_t n, std::size_t align) {
+    if (n == 0) n = 1;
+    if (align < sizeof(void*)) align = sizeof(void*);
+    for (;;) {
+#ifdef _WIN32
+        void* p = _aligned_malloc(n, align);
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, align, n) != 0) p = nullptr;
+#endif
+        if (p) {
+            allocNoteNew(n);
+            return p;
+        }
+        std::new_handler h = std::get_new_handler();
+        if (!h) return nullptr;
+        h();
+    }
+}
+
+void release(void* p) {
+    if (!p) return;
+    allocNoteDelete();
+    std::free(p);
+}
+
+void releaseAligned(void* p) {
+    if (!p) return;
+    allocNoteDelete();
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t n) {
+    if (void* p = allocate(n)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t n) {
+    if (void* p = allocate(n)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return allocate(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return allocate(n); }
+
+void* operator new(std::size_t n, std::align_val_t a) {
+    if (void* p = allocateAligned(n, (std::size_t)a)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t n, std::align_val_t a) {
+    if (void* p = allocateAligned(n, (std::size_t)a)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return allocateAligned(n, (std::size_t)a);
+}
+
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return allocateAligned(n, (std::size_t)a);
+}
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { releaseAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(p); }
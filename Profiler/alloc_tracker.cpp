@@ -0,0 +1,96 @@
+/**
+ * @file alloc_tracker.cpp
+ * @brief Compteurs d'allocations par thread et allocateur cv::Mat compteur.
+ */
+
+#include "alloc_tracker.hpp"
+#include <opencv2/core.hpp>
+
+namespace {
+
+// Type trivial : pas d'initialisation dynamique, accessible depuis operator new
+// dès le premier appel du thread (y compris pendant les constructeurs statiques)
+thread_local AllocCounts tls;
+
+bool hooksLinked = false;
+
+/// @brief Délègue à l'allocateur standard d'OpenCV et compte les tampons qu'il crée.
+class CountingMatAllocator : public cv::MatAllocator {
+public:
+    explicit CountingMatAllocator(cv::MatAllocator* base) : base(base) {}
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usage) const override {
+        cv::UMatData* u = base->allocate(dims, sizes, type, data, step, flags, usage);
+        if (!u) return u;
+        // Libération (unmap -> deallocate) par cet allocateur, pour la compter aussi
+        u->currAllocator = u->prevAllocator = this;
+        if (!data) {
+            ++tls.cvAllocs;
+            tls.cvBytes += u->size;
+        }
+        return u;
+    }
+
+    bool allocate(cv::UMatData* u, cv::AccessFlag flags, cv::UMatUsageFlags usage) const override {
+        return base->allocate(u, flags, usage);
+    }
+
+    void deallocate(cv::UMatData* u) const override {
+        if (!u) return;
+        if (!(u->flags & cv::UMatData::USER_ALLOCATED)) ++tls.cvFrees;
+        base->deallocate(u);
+    }
+
+private:
+    cv::MatAllocator* base;
+};
+
+} // namespace
+
+AllocCounts& AllocCounts::operator+=(const AllocCounts& o) {
+    allocs += o.allocs;
+    frees += o.frees;
+    bytes += o.bytes;
+    cvAllocs += o.cvAllocs;
+    cvFrees += o.cvFrees;
+    cvBytes += o.cvBytes;
+    return *this;
+}
+
+AllocCounts& AllocCounts::operator-=(const AllocCounts& o) {
+    allocs -= o.allocs;
+    frees -= o.frees;
+    bytes -= o.bytes;
+    cvAllocs -= o.cvAllocs;
+    cvFrees -= o.cvFrees;
+    cvBytes -= o.cvBytes;
+    return *this;
+}
+
+bool allocTrackingActive() {
+    return hooksLinked;
+}
+
+AllocCounts allocCounts() {
+    return tls;
+}
+
+void installCvAllocTracker() {
+    // Jamais détruit : des cv::Mat statiques peuvent être libérées après main()
+    static CountingMatAllocator* counting = new CountingMatAllocator(cv::Mat::getStdAllocator());
+    cv::Mat::setDefaultAllocator(counting);
+}
+
+void allocNoteNew(std::size_t bytes) {
+    ++tls.allocs;
+    tls.bytes += bytes;
+}
+
+void allocNoteDelete() {
+    ++tls.frees;
+}
+
+void allocMarkHooksLinked() {
+    hooksLinked = true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file alloc_tracker.hpp
+ * @brief Comptage des allocations du tas par thread : operator new / delete globaux et
+ *        tampons cv::Mat (allocateur OpenCV), pour suivre les allocations par frame et par étape.
+ *
+ * @details
+ * - Les remplacements de operator new / delete sont dans Profiler/alloc_hooks.cpp, qui
+ *   n'appartient PAS à arcore : seules les cibles qui l'ajoutent à leurs sources sont
+ *   instrumentées (arcube avec l'option CMake ARCUBE_ALLOC_TRACKER, bench_alloc toujours).
+ *   Sans ce fichier, allocTrackingActive() vaut false et les compteurs restent à zéro.
+ * - Les données des cv::Mat passent par cv::fastMalloc, pas par operator new :
+ *   installCvAllocTracker() remplace l'allocateur par défaut d'OpenCV par un allocateur
+ *   qui délègue à l'allocateur standard et compte les tampons créés / libérés.
+ * - Les compteurs sont thread_local (un incrément, pas d'atomique) : allocCounts() ne
+ *   voit que le thread appelant. Le travail des threads d'OpenCV (parallel_for_) ou de
+ *   l'AssetLoader n'apparaît pas dans les étapes du thread principal.
+ *
+ * Usage :
+ * @code
+ * if (allocTrackingActive()) installCvAllocTracker();
+ * const AllocCounts a0 = allocCounts();
+ * cv::aruco::detectMarkers(...);
+ * const AllocCounts d = allocCounts() - a0;   // d.allocs, d.bytes, d.cvAllocs, d.cvBytes
+ * @endcode
+ */
+
+/// @brief Compteurs cumulés du thread (operator new / delete, puis tampons cv::Mat).
+struct AllocCounts {
+    uint64_t allocs = 0;   ///< Appels à operator new (toutes variantes).
+    uint64_t frees = 0;    ///< Appels à operator delete sur un pointeur non nul.
+    uint64_t bytes = 0;    ///< Octets demandés à operator new.
+    uint64_t cvAllocs = 0; ///< Tampons cv::Mat alloués par OpenCV.
+    uint64_t cvFrees = 0;
+    uint64_t cvBytes = 0;
+
+    AllocCounts& operator+=(const AllocCounts& o);
+    AllocCounts& operator-=(const AllocCounts& o);
+};
+
+inline AllocCounts operator+(AllocCounts a, const AllocCounts& b) { return a += b; }
+inline AllocCounts operator-(AllocCounts a, const AllocCounts& b) { return a -= b; }
+
+/// @brief true si alloc_hooks.cpp est lié à l'exécutable (operator new compté).
+bool allocTrackingActive();
+
+/// @brief Compteurs cumulés du thread appelant depuis son démarrage.
+AllocCounts allocCounts();
+
+/**
+ * @brief Installe l'allocateur cv::Mat compteur comme allocateur par défaut d'OpenCV.
+ * @details Idempotent. À appeler avant de créer les matrices à suivre : un tampon alloué
+ *          avant l'installation est libéré par l'allocateur standard et n'est pas compté.
+ */
+void installCvAllocTracker();
+
+/// @name Points d'entrée des hooks (alloc_hooks.cpp)
+/// @{
+void allocNoteNew(std::size_t bytes);
+void allocNoteDelete();
+void allocMarkHooksLinked();
+/// @}
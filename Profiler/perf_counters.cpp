@@ -0,0 +1,197 @@
+/**
+ * @file perf_counters.cpp
+ * @brief Implémentation des compteurs matériels par thread (perf_event_open).
+ */
+
+#include "perf_counters.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+int openEvent(uint64_t config, int groupFd) {
+    perf_event_attr pe;
+    std::memset(&pe, 0, sizeof(pe));
+    pe.type = PERF_TYPE_HARDWARE;
+    pe.size = sizeof(pe);
+    pe.config = config;
+    pe.disabled = groupFd < 0 ? 1 : 0; // le leader démarre le groupe entier
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &pe, 0 /* ce thread */, -1 /* tout CPU */, groupFd, 0);
+}
+
+const uint64_t configs[PERF_EVENT_COUNT] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                             PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+#endif
+
+const char* const eventNames[PERF_EVENT_COUNT] = { "cycles", "instructions", "cache-misses", "branch-misses" };
+
+} // namespace
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+bool PerfCounters::open() {
+    close();
+#ifdef __linux__
+    // Le leader doit s'ouvrir : cycles, sinon instructions
+    int firstError = 0;
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        const int fd = openEvent(configs[e], leader);
+        if (fd < 0) {
+            if (!firstError) firstError = errno;
+            if (leader < 0 && e == PERF_INSTRUCTIONS) break; // ni cycles ni instructions : abandon
+            continue;
+        }
+        if (leader < 0) leader = fd;
+        fds[e] = fd;
+        slot[e] = opened++;
+    }
+    if (leader < 0) {
+        int paranoid = -99;
+        if (FILE* f = std::fopen("/proc/sys/kernel/perf_event_paranoid", "r")) {
+            if (std::fscanf(f, "%d", &paranoid) != 1) paranoid = -99;
+            std::fclose(f);
+        }
+        char msg[160];
+        std::snprintf(msg, sizeof(msg), "perf_event_open : %s (perf_event_paranoid = %d)", std::strerror(firstError),
+                      paranoid);
+        err = msg;
+        close();
+        return false;
+    }
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    err.clear();
+    return true;
+#else
+    err = "perf_event_open : Linux seulement";
+    return false;
+#endif
+}
+
+void PerfCounters::close() {
+#ifdef __linux__
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+        if (fds[e] >= 0) ::close(fds[e]);
+#endif
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) fds[e] = slot[e] = -1;
+    leader = -1;
+    opened = 0;
+}
+
+bool PerfCounters::read(PerfSample& out) const {
+#ifdef __linux__
+    if (leader < 0) return false;
+    uint64_t buf[3 + PERF_EVENT_COUNT];
+    if (::read(leader, buf, sizeof(buf)) < (ssize_t)((3 + opened) * sizeof(uint64_t))) return false;
+    const uint64_t enabled = buf[1], running = buf[2];
+    const double scale = (running > 0 && running < enabled) ? (double)enabled / running : 1.0;
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+        out.v[e] = slot[e] >= 0 ? (uint64_t)(buf[3 + slot[e]] * scale) : 0;
+    return true;
+#else
+    (void)out;
+    return false;
+#endif
+}
+
+int PerfStages::add(const std::string& name) {
+    stages.push_back(Stage{ name, PerfSample(), PerfSample(), 0, AllocCounts(), AllocCounts() });
+    return (int)stages.size() - 1;
+}
+
+void PerfStages::begin(int stage) {
+    if (!active() || stage < 0) return;
+    Stage& s = stages[stage];
+    if (enabled()) counters.read(s.start);
+    if (allocOn) s.allocStart = allocCounts(); // en dernier : la lecture perf n'alloue pas
+}
+
+void PerfStages::end(int stage) {
+    if (!active() || stage < 0) return;
+    Stage& s = stages[stage];
+    if (allocOn) s.allocTotal += allocCounts() - s.allocStart;
+    PerfSample now;
+    if (enabled() && counters.read(now)) {
+        for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+            if (now.v[e] >= s.start.v[e]) s.total.v[e] += now.v[e] - s.start.v[e];
+    }
+    ++s.calls;
+}
+
+void PerfStages::reset() {
+    for (Stage& s : stages) {
+        s.total = PerfSample();
+        s.allocTotal = AllocCounts();
+        s.calls = 0;
+    }
+    frames = 0;
+}
+
+void PerfStages::report(std::ostream& os, const char* title) const {
+    if (allocOn) reportAllocations(os, title);
+    if (!enabled()) {
+        // Allocations seules : compteurs matériels non demandés, rien à signaler
+        if (!allocOn || !error().empty())
+            os << "[" << title << "] compteurs materiels indisponibles : " << error() << "\n";
+        return;
+    }
+    const bool perFrame = frames > 0;
+    char line[256];
+    std::snprintf(line, sizeof(line), "[%s] compteurs materiels par %s%s\n", title, perFrame ? "frame" : "appel",
+                  perFrame ? (" (" + std::to_string(frames) + " frames)").c_str() : "");
+    os << line;
+    std::snprintf(line, sizeof(line), "  %-28s %8s %12s %12s %6s %12s %12s\n", "etape", "appels", eventNames[0],
+                  eventNames[1], "IPC", eventNames[2], eventNames[3]);
+    os << line;
+    auto col = [&](const Stage& s, PerfEvent e, double div) -> std::string {
+        if (!counters.has(e)) return "-";
+        char b[32];
+        std::snprintf(b, sizeof(b), "%.0f", s.total.v[e] / div);
+        return b;
+    };
+    for (const Stage& s : stages) {
+        if (s.calls == 0) continue;
+        const double div = perFrame ? (double)frames : (double)s.calls;
+        const double ipc = s.total.v[PERF_CYCLES] > 0 && counters.has(PERF_INSTRUCTIONS)
+            ? (double)s.total.v[PERF_INSTRUCTIONS] / s.total.v[PERF_CYCLES] : 0.0;
+        std::snprintf(line, sizeof(line), "  %-28s %8llu %12s %12s %6.2f %12s %12s\n", s.name.c_str(),
+                      (unsigned long long)s.calls, col(s, PERF_CYCLES, div).c_str(),
+                      col(s, PERF_INSTRUCTIONS, div).c_str(), ipc, col(s, PERF_CACHE_MISSES, div).c_str(),
+                      col(s, PERF_BRANCH_MISSES, div).c_str());
+        os << line;
+    }
+}
+
+void PerfStages::reportAllocations(std::ostream& os, const char* title) const {
+    const bool perFrame = frames > 0;
+    char line[256];
+    std::snprintf(line, sizeof(line), "[%s] allocations par %s%s\n", title, perFrame ? "frame" : "appel",
+                  perFrame ? (" (" + std::to_string(frames) + " frames)").c_str() : "");
+    os << line;
+    std::snprintf(line, sizeof(line), "  %-28s %8s %10s %12s %10s %12s\n", "etape", "appels", "new", "octets",
+                  "cv::Mat", "octets Mat");
+    os << line;
+    for (const Stage& s : stages) {
+        if (s.calls == 0) continue;
+        const double div = perFrame ? (double)frames : (double)s.calls;
+        const AllocCounts& a = s.allocTotal;
+        std::snprintf(line, sizeof(line), "  %-28s %8llu %10.1f %12.0f %10.1f %12.0f\n", s.name.c_str(),
+                      (unsigned long long)s.calls, a.allocs / div, a.bytes / div, a.cvAllocs / div,
+                      a.cvBytes / div);
+        os << line;
+    }
+}
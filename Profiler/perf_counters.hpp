@@ -0,0 +1,141 @@
+#pragma once
+#include "alloc_tracker.hpp"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file perf_counters.hpp
+ * @brief Compteurs matériels du thread courant (perf_event_open, Linux) lus aux frontières
+ *        des étapes : cycles, instructions (IPC), défauts de cache, mauvaises prédictions.
+ *
+ * @details
+ * Les quatre compteurs forment un groupe (lus ensemble par un seul read()) limité à
+ * l'espace utilisateur et au thread qui les a ouverts : PerfStages doit être utilisé
+ * depuis ce thread ; le travail délégué à d'autres threads n'est pas compté.
+ * Si le noyau multiplexe le groupe, les deltas sont remis à l'échelle (temps activé /
+ * temps d'exécution).
+ *
+ * Dégradation : hors Linux, dans un conteneur sans accès (seccomp, perf_event_paranoid
+ * élevé) ou sur une machine virtuelle sans PMU, open() renvoie false avec error() renseigné
+ * et begin() / end() ne font plus rien. Un compteur refusé isolément (défauts de cache sur
+ * certaines VM) est simplement absent du rapport.
+ *
+ * Allocations : avec trackAllocations(true), les mêmes étapes cumulent aussi les deltas de
+ * allocCounts() (alloc_tracker.hpp) et report() ajoute un tableau allocations / octets par
+ * frame. Indépendant des compteurs matériels : fonctionne aussi quand open() échoue.
+ *
+ * Usage :
+ * @code
+ * PerfStages perf;
+ * const int sDetect = perf.add("detectMarkers");
+ * if (!perf.open()) std::cerr << perf.error();
+ * { PerfScope s(perf, sDetect); cv::aruco::detectMarkers(...); }
+ * perf.endFrame();
+ * perf.report(std::cerr);
+ * @endcode
+ */
+
+enum PerfEvent { PERF_CYCLES = 0, PERF_INSTRUCTIONS, PERF_CACHE_MISSES, PERF_BRANCH_MISSES, PERF_EVENT_COUNT };
+
+/// @brief Valeurs cumulées des compteurs.
+struct PerfSample {
+    uint64_t v[PERF_EVENT_COUNT] = {};
+};
+
+/**
+ * @class PerfCounters
+ * @brief Groupe perf_event_open du thread appelant.
+ */
+class PerfCounters {
+public:
+    ~PerfCounters();
+
+    /// @brief Ouvre et démarre le groupe sur le thread appelant. @return false si indisponible.
+    bool open();
+    void close();
+
+    bool available() const { return leader >= 0; }
+    bool has(PerfEvent e) const { return slot[e] >= 0; }
+    const std::string& error() const { return err; }
+
+    /// @brief Valeurs courantes, remises à l'échelle si le groupe est multiplexé.
+    bool read(PerfSample& out) const;
+
+private:
+    int leader = -1;
+    int fds[PERF_EVENT_COUNT] = { -1, -1, -1, -1 };
+    int slot[PERF_EVENT_COUNT] = { -1, -1, -1, -1 }; ///< Position dans la lecture groupée.
+    int opened = 0;
+    std::string err;
+};
+
+/**
+ * @class PerfStages
+ * @brief Deltas de compteurs cumulés par étape nommée, rapportés par frame (ou par appel).
+ */
+class PerfStages {
+public:
+    /// @brief Déclare une étape. @return Indice.
+    int add(const std::string& name);
+
+    /// @brief Ouvre les compteurs sur le thread appelant (celui des begin / end).
+    bool open() { return counters.open(); }
+    bool enabled() const { return counters.available(); }
+    const std::string& error() const { return counters.error(); }
+
+    /// @brief Cumule aussi les allocations du thread par étape (utile si allocTrackingActive()).
+    void trackAllocations(bool on) { allocOn = on; }
+    bool tracksAllocations() const { return allocOn; }
+    /// @brief Compteurs matériels ouverts ou allocations suivies.
+    bool active() const { return enabled() || allocOn; }
+
+    void begin(int stage);
+    void end(int stage);
+    /// @brief Compte une frame (dénominateur du rapport ; sans frame : moyennes par appel).
+    void endFrame() { if (active()) ++frames; }
+    void reset();
+
+    uint64_t frameCount() const { return frames; }
+    /// @brief Allocations cumulées d'une étape depuis le dernier reset().
+    const AllocCounts& allocTotal(int stage) const { return stages[stage].allocTotal; }
+
+    /**
+     * @brief Tableaux par frame : cycles, instructions, IPC, défauts de cache, mauvaises
+     *        prédictions ; puis allocations et octets (operator new, tampons cv::Mat) si suivies.
+     */
+    void report(std::ostream& os, const char* title = "perf") const;
+
+private:
+    struct Stage {
+        std::string name;
+        PerfSample start;
+        PerfSample total;
+        uint64_t calls = 0;
+        AllocCounts allocStart;
+        AllocCounts allocTotal;
+    };
+    void reportAllocations(std::ostream& os, const char* title) const;
+
+    PerfCounters counters;
+    std::vector<Stage> stages;
+    uint64_t frames = 0;
+    bool allocOn = false;
+};
+
+/**
+ * @class PerfScope
+ * @brief begin() / end() d'une étape sur la durée de vie de l'objet.
+ */
+class PerfScope {
+public:
+    PerfScope(PerfStages& p, int stage) : p(p), stage(stage) { p.begin(stage); }
+    ~PerfScope() { p.end(stage); }
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfStages& p;
+    int stage;
+};
@@ -0,0 +1,188 @@
+/**
+ * @file profiler.cpp
+ * @brief Implémentation du traceur de zones (tampons par thread, export Chrome Trace).
+ */
+
+#include "profiler.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ARCUBE_PROF_RDTSC 1
+#elif defined(_M_X64)
+#include <intrin.h>
+#define ARCUBE_PROF_RDTSC 1
+#endif
+
+namespace prof {
+namespace {
+
+constexpr uint64_t CHUNK = 4096;       ///< Événements par bloc.
+constexpr uint64_t MAX_CHUNKS = 1024;  ///< MAX_EVENTS = 4M par thread.
+
+struct Event {
+    const char* name;
+    uint64_t t0, t1;
+};
+
+struct ThreadBuffer {
+    std::atomic<Event*> chunks[MAX_CHUNKS] = {};
+    std::atomic<uint64_t> count{ 0 };    ///< Événements publiés (écrit par le seul thread propriétaire).
+    std::atomic<uint64_t> dropped{ 0 };
+    std::string name;                    ///< Protégé par Registry::mutex.
+    int tid = 0;
+
+    ~ThreadBuffer() {
+        for (auto& c : chunks) delete[] c.load();
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+uint64_t steadyNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief Origine de la trace : paire (ticks, ns) prise au chargement, sert aussi à l'étalonnage.
+struct Origin {
+    uint64_t ticks = now();
+    uint64_t ns = steadyNs();
+};
+
+const Origin& origin() {
+    static const Origin o;
+    return o;
+}
+
+[[maybe_unused]] const Origin& originAtLoad = origin(); // fixée avant main()
+
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+ThreadBuffer* local() {
+    if (localBuffer) return localBuffer;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threads.push_back(std::make_unique<ThreadBuffer>());
+    localBuffer = r.threads.back().get();
+    localBuffer->tid = (int)r.threads.size();
+    return localBuffer;
+}
+
+/// @brief Ticks par microseconde (RDTSC étalonné sur steady_clock depuis l'origine).
+double ticksPerUs() {
+#ifdef ARCUBE_PROF_RDTSC
+    const Origin& o = origin();
+    uint64_t ns = steadyNs();
+    if (ns - o.ns < 20000000) { // au moins 20 ms d'écart pour un étalonnage stable
+        std::this_thread::sleep_for(std::chrono::nanoseconds(20000000 - (ns - o.ns)));
+        ns = steadyNs();
+    }
+    return (double)(now() - o.ticks) / ((double)(ns - o.ns) / 1000.0);
+#else
+    return 1000.0;
+#endif
+}
+
+void writeEscaped(FILE* f, const char* s) {
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) std::fputc(*s, f);
+    }
+}
+
+} // namespace
+
+uint64_t now() {
+#ifdef ARCUBE_PROF_RDTSC
+    return __rdtsc();
+#else
+    return steadyNs();
+#endif
+}
+
+void record(const char* name, uint64_t t0, uint64_t t1) {
+    ThreadBuffer* tb = local();
+    const uint64_t n = tb->count.load(std::memory_order_relaxed);
+    const uint64_t c = n / CHUNK;
+    if (c >= MAX_CHUNKS) {
+        tb->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Event* chunk = tb->chunks[c].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Event[CHUNK];
+        tb->chunks[c].store(chunk, std::memory_order_release);
+    }
+    chunk[n % CHUNK] = Event{ name, t0, t1 };
+    tb->count.store(n + 1, std::memory_order_release);
+}
+
+void setThreadName(const char* name) {
+    ThreadBuffer* tb = local();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    tb->name = name;
+}
+
+bool writeTrace(const std::string& path) {
+    const double tpu = ticksPerUs();
+    const uint64_t base = origin().ticks;
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    bool first = true;
+    for (const auto& tb : r.threads) {
+        std::fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"",
+                     first ? "" : ",\n", tb->tid);
+        writeEscaped(f, tb->name.empty() ? "thread" : tb->name.c_str());
+        std::fputs("\"}}", f);
+        first = false;
+
+        const uint64_t n = tb->count.load(std::memory_order_acquire);
+        for (uint64_t i = 0; i < n; ++i) {
+            const Event& e = tb->chunks[i / CHUNK].load(std::memory_order_acquire)[i % CHUNK];
+            std::fputs(",\n{\"ph\":\"X\",\"name\":\"", f);
+            writeEscaped(f, e.name);
+            std::fprintf(f, "\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", tb->tid,
+                         (double)(e.t0 > base ? e.t0 - base : 0) / tpu, (double)(e.t1 - e.t0) / tpu);
+        }
+    }
+    std::fputs("\n]}\n", f);
+    return std::fclose(f) == 0;
+}
+
+uint64_t eventCount() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    uint64_t n = 0;
+    for (const auto& tb : r.threads) n += tb->count.load(std::memory_order_acquire);
+    return n;
+}
+
+uint64_t droppedCount() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    uint64_t n = 0;
+    for (const auto& tb : r.threads) n += tb->dropped.load(std::memory_order_relaxed);
+    return n;
+}
+
+} // namespace prof
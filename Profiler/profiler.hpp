@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * @file profiler.hpp
+ * @brief Traceur de zones (début / durée par thread) exporté au format Chrome Trace
+ *        (chrome://tracing, https://ui.perfetto.dev).
+ *
+ * @details
+ * Les macros ARCUBE_ZONE / ARCUBE_THREAD_NAME ne produisent du code que si ARCUBE_PROFILER
+ * est défini (option CMake du même nom) : désactivé, aucun coût.
+ *
+ * Activé, chaque thread écrit dans son propre tampon (blocs de 4096 événements, jamais
+ * déplacés) sans verrou : une zone coûte deux lectures d'horloge (RDTSC sur x86, sinon
+ * steady_clock) et une écriture de 24 octets. Le nombre d'événements publiés est atomique
+ * (release), ce qui permet à writeTrace() de lire les tampons pendant que les threads
+ * continuent d'écrire. Les tampons survivent à leur thread (threads de l'AssetLoader).
+ * Au-delà de MAX_EVENTS par thread, les événements sont comptés comme perdus.
+ *
+ * Usage :
+ * @code
+ * ARCUBE_THREAD_NAME("main");
+ * { ARCUBE_ZONE("detectMarkers"); cv::aruco::detectMarkers(...); }
+ * ...
+ * ARCUBE_TRACE_WRITE("arcube_trace.json");
+ * @endcode
+ */
+
+namespace prof {
+
+/// @brief Horodatage brut (ticks RDTSC ou nanosecondes steady_clock).
+uint64_t now();
+
+/// @brief Enregistre une zone [t0, t1] du thread courant. name doit rester valide (littéral).
+void record(const char* name, uint64_t t0, uint64_t t1);
+
+/// @brief Nomme le thread courant dans la trace.
+void setThreadName(const char* name);
+
+/**
+ * @brief Écrit tous les événements enregistrés jusqu'ici (tous threads) en JSON Chrome Trace.
+ * @return false si le fichier ne peut pas être écrit.
+ */
+bool writeTrace(const std::string& path);
+
+/// @brief Nombre d'événements enregistrés / perdus (tampon plein), tous threads.
+uint64_t eventCount();
+uint64_t droppedCount();
+
+/**
+ * @class Zone
+ * @brief Zone RAII : mesure la durée de vie de l'objet.
+ */
+class Zone {
+public:
+    explicit Zone(const char* name) : name(name), t0(now()) {}
+    ~Zone() { record(name, t0, now()); }
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* name;
+    uint64_t t0;
+};
+
+} // namespace prof
+
+#define ARCUBE_PROF_CAT2(a, b) a##b
+#define ARCUBE_PROF_CAT(a, b) ARCUBE_PROF_CAT2(a, b)
+
+#ifdef ARCUBE_PROFILER
+#define ARCUBE_ZONE(name) ::prof::Zone ARCUBE_PROF_CAT(profZone_, __LINE__)(name)
+#define ARCUBE_THREAD_NAME(name) ::prof::setThreadName(name)
+#define ARCUBE_TRACE_WRITE(path) ::prof::writeTrace(path)
+#else
+#define ARCUBE_ZONE(name) ((void)0)
+#define ARCUBE_THREAD_NAME(name) ((void)0)
+#define ARCUBE_TRACE_WRITE(path) false
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @file program_cache.cpp
+ * @brief Implémentation du cache de binaires de programmes et de la compilation groupée.
+ */
+
+#include "program_cache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include "FileIO/mapped_file.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+uint64_t fnv1a(const void* data, std::size_t n, uint64_t h) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+std::string glString(GLenum name) {
+    const GLubyte* s = glGetString(name);
+    return s ? std::string((const char*)s) : std::string();
+}
+
+/// @brief Écrit le log d'un shader ou d'un programme sur stderr.
+void printLog(GLuint obj, bool program, const char* what) {
+    GLint logLen = 0;
+    if (program) glGetProgramiv(obj, GL_INFO_LOG_LENGTH, &logLen);
+    else glGetShaderiv(obj, GL_INFO_LOG_LENGTH, &logLen);
+    std::vector<GLchar> log(std::max(1, logLen));
+    if (program) glGetProgramInfoLog(obj, logLen, nullptr, log.data());
+    else glGetShaderInfoLog(obj, logLen, nullptr, log.data());
+    std::cerr << what << ":\n" << log.data() << std::endl;
+}
+
+} // namespace
+
+ProgramCache::ProgramCache(std::string cacheDir) : dir(std::move(cacheDir)) {}
+
+ProgramCache::~ProgramCache() {
+    // Lot abandonné (exception) : shaders en attente libérés, programmes non terminés aussi
+    for (Entry& e : entries) {
+        if (e.done) continue;
+        for (GLuint s : e.shaders) glDeleteShader(s);
+        if (e.program) glDeleteProgram(e.program);
+    }
+}
+
+void ProgramCache::init() {
+    if (ready) return;
+    ready = true;
+    driver = glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+
+    GLint formats = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    binaryOk = formats > 0 && !dir.empty();
+
+    // 0xFFFFFFFF : autant de threads que le driver le juge utile
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+        parallel = true;
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+        parallel = true;
+    }
+}
+
+std::string ProgramCache::binaryPath(const Entry& e) const {
+    return (fs::path(dir) / (e.name + ".progbin")).string();
+}
+
+bool ProgramCache::loadBinary(Entry& e) const {
+    MappedFile file;
+    if (!file.open(binaryPath(e), false) || file.size() < sizeof(ProgramBinaryHeader)) return false;
+    const ProgramBinaryHeader* h = (const ProgramBinaryHeader*)file.data();
+    if (h->magic != PROGRAM_CACHE_MAGIC || h->version != PROGRAM_CACHE_VERSION || h->key != e.key
+        || h->size == 0 || sizeof(ProgramBinaryHeader) + h->size > file.size())
+        return false;
+
+    const GLuint p = glCreateProgram();
+    glProgramParameteri(p, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glProgramBinary(p, (GLenum)h->binaryFormat, file.data() + sizeof(ProgramBinaryHeader), (GLsizei)h->size);
+    GLint ok = GL_FALSE;
+    glGetProgramiv(p, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        // Refusé par le driver (mise à jour) : recompilé puis réécrit
+        glDeleteProgram(p);
+        return false;
+    }
+    e.program = p;
+    return true;
+}
+
+void ProgramCache::storeBinary(const Entry& e) const {
+    GLint len = 0;
+    glGetProgramiv(e.program, GL_PROGRAM_BINARY_LENGTH, &len);
+    if (len <= 0) return;
+    std::vector<char> bin((std::size_t)len);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(e.program, len, &written, &format, bin.data());
+    if (written <= 0) return;
+
+    ProgramBinaryHeader h{};
+    h.magic = PROGRAM_CACHE_MAGIC;
+    h.version = PROGRAM_CACHE_VERSION;
+    h.key = e.key;
+    h.binaryFormat = (uint32_t)format;
+    h.size = (uint64_t)written;
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    const std::string path = binaryPath(e);
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return;
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1
+           && std::fwrite(bin.data(), 1, (std::size_t)written, f) == (std::size_t)written;
+    ok = (std::fclose(f) == 0) && ok;
+    if (ok) fs::rename(tmp, path, ec);
+    if (!ok || ec) fs::remove(tmp, ec);
+}
+
+std::size_t ProgramCache::add(const std::string& name, const std::vector<ShaderStage>& stages) {
+    init();
+    if (std::none_of(entries.begin(), entries.end(), [](const Entry& e) { return !e.done; }))
+        t0 = std::chrono::steady_clock::now();
+
+    Entry e;
+    e.name = name;
+    e.key = fnv1a(driver.data(), driver.size(), 0xCBF29CE484222325ull);
+    for (const ShaderStage& s : stages) {
+        e.key = fnv1a(&s.type, sizeof(s.type), e.key);
+        e.key = fnv1a(s.src, std::char_traits<char>::length(s.src), e.key);
+    }
+
+    if (binaryOk && loadBinary(e)) {
+        e.cached = true;
+        hits++;
+    } else {
+        // Aucune requête de statut ici : le driver peut compiler pendant les add() suivants
+        e.program = glCreateProgram();
+        if (binaryOk) glProgramParameteri(e.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        for (const ShaderStage& s : stages) {
+            const GLuint sh = glCreateShader(s.type);
+            glShaderSource(sh, 1, &s.src, nullptr);
+            glCompileShader(sh);
+            glAttachShader(e.program, sh);
+            e.shaders.push_back(sh);
+        }
+        glLinkProgram(e.program);
+    }
+    entries.push_back(std::move(e));
+    return entries.size() - 1;
+}
+
+void ProgramCache::finish() {
+    for (Entry& e : entries) {
+        if (e.done || e.cached) {
+            e.done = true;
+            continue;
+        }
+        GLint ok = GL_FALSE;
+        glGetProgramiv(e.program, GL_LINK_STATUS, &ok); // attend ce programme (les autres continuent)
+        if (!ok) {
+            for (GLuint sh : e.shaders) {
+                GLint compiled = GL_FALSE;
+                glGetShaderiv(sh, GL_COMPILE_STATUS, &compiled);
+                if (!compiled) printLog(sh, false, "Shader compile error");
+            }
+            printLog(e.program, true, ("Program link error (" + e.name + ")").c_str());
+            throw std::runtime_error("Program link failed: " + e.name);
+        }
+        for (GLuint sh : e.shaders) {
+            glDetachShader(e.program, sh);
+            glDeleteShader(sh);
+        }
+        e.shaders.clear();
+        e.done = true;
+        if (binaryOk) storeBinary(e);
+    }
+    ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <GL/glew.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file program_cache.hpp
+ * @brief Programmes GLSL du démarrage : binaires des drivers en cache disque, compilations
+ *        lancées ensemble et attendues une seule fois.
+ *
+ * @details
+ * Chaque programme est déclaré par add() puis tous sont attendus par finish() :
+ *  - cache à jour : glProgramBinary() depuis "<dir>/<nom>.progbin" (projeté en mémoire),
+ *    ni compilation ni édition de liens ;
+ *  - sinon : glCompileShader / glLinkProgram sont émis sans interroger leur statut, pour
+ *    que le driver les traite en parallèle (GL_KHR/ARB_parallel_shader_compile : threads
+ *    de compilation demandés à glMaxShaderCompilerThreadsKHR) ; finish() relève les statuts
+ *    puis écrit le binaire (glGetProgramBinary) pour le lancement suivant.
+ *
+ * La clé d'un binaire est une empreinte FNV-1a des étages (type + source) et du driver
+ * (GL_VENDOR, GL_RENDERER, GL_VERSION) : changer de shader, de driver ou de GPU invalide le
+ * cache. Un binaire refusé par glProgramBinary() (mise à jour du driver) est recompilé.
+ * Sans GL_ARB_get_program_binary (ou sans format binaire), seule la compilation groupée
+ * est faite.
+ *
+ * Fichier (little-endian) : ProgramBinaryHeader (32 octets) puis le binaire du driver.
+ */
+
+constexpr uint32_t PROGRAM_CACHE_MAGIC = 0x42505241u; ///< "ARPB"
+constexpr uint32_t PROGRAM_CACHE_VERSION = 1;
+
+/**
+ * @struct ProgramBinaryHeader
+ * @brief En-tête d'un binaire en cache (32 octets).
+ */
+struct ProgramBinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;          ///< Empreinte des sources et du driver.
+    uint32_t binaryFormat; ///< Valeur rendue par glGetProgramBinary().
+    uint32_t reserved;
+    uint64_t size;         ///< Octets du binaire.
+};
+static_assert(sizeof(ProgramBinaryHeader) == 32, "ProgramBinaryHeader doit faire 32 octets");
+
+/**
+ * @struct ShaderStage
+ * @brief Un étage d'un programme : type (GL_VERTEX_SHADER...) et source GLSL.
+ */
+struct ShaderStage {
+    GLenum type;
+    const char* src;
+};
+
+/**
+ * @class ProgramCache
+ * @brief Construit un lot de programmes (cache binaire, compilation parallèle).
+ * @warning Contexte OpenGL actif requis (add() et finish()).
+ */
+class ProgramCache {
+public:
+    /// @param dir Répertoire des binaires (créé au premier enregistrement ; vide : pas de cache disque).
+    explicit ProgramCache(std::string dir = ".programcache");
+    ~ProgramCache();
+
+    ProgramCache(const ProgramCache&) = delete;
+    ProgramCache& operator=(const ProgramCache&) = delete;
+
+    /**
+     * @brief Déclare un programme et lance sa construction sans attendre.
+     * @param name Nom du fichier binaire (unique dans le lot).
+     * @return Indice à passer à program() après finish().
+     */
+    std::size_t add(const std::string& name, const std::vector<ShaderStage>& stages);
+
+    /**
+     * @brief Attend tous les programmes du lot et enregistre les binaires nouveaux.
+     * @throws std::runtime_error si une compilation ou une édition de liens échoue (log sur
+     *         stderr, comme compileShader() / linkProgram()).
+     */
+    void finish();
+
+    /// @brief Programme lié (après finish()). Il appartient à l'appelant (glDeleteProgram).
+    GLuint program(std::size_t i) const { return entries[i].program; }
+
+    std::size_t size() const { return entries.size(); }
+    std::size_t cacheHits() const { return hits; }
+    bool binarySupported() const { return binaryOk; }
+    bool parallelCompile() const { return parallel; }
+    /// @brief Durée du premier add() au retour de finish() (ms).
+    double elapsedMs() const { return ms; }
+
+private:
+    struct Entry {
+        std::string name;
+        uint64_t key = 0;
+        GLuint program = 0;
+        std::vector<GLuint> shaders; ///< Compilés (vide si chargé depuis le cache).
+        bool cached = false;
+        bool done = false;           ///< Statut relevé par finish().
+    };
+
+    void init();
+    bool loadBinary(Entry& e) const;
+    void storeBinary(const Entry& e) const;
+    std::string binaryPath(const Entry& e) const;
+
+    std::string dir;
+    std::vector<Entry> entries;
+    std::string driver;  ///< GL_VENDOR / GL_RENDERER / GL_VERSION.
+    bool ready = false;
+    bool binaryOk = false;
+    bool parallel = false;
+    std::size_t hits = 0;
+    double ms = 0.0;
+    std::chrono::steady_clock::time_point t0; ///< Premier add() du lot.
+};
@@ -0,0 +1,160 @@
+/**
+ * @file resource_cache.cpp
+ * @brief Implémentation du cache de ressources GPU compté par références.
+ */
+
+#include "resource_cache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include "TextureCache/texture_cache.hpp"
+
+ResourceCache& resources() {
+    static ResourceCache cache;
+    return cache;
+}
+
+/// @brief Taille d'un buffer d'après le driver (0 si absent).
+static std::size_t bufferBytes(GLenum target, GLuint buf) {
+    if (buf == 0) return 0;
+    GLint size = 0;
+    glBindBuffer(target, buf);
+    glGetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+    glBindBuffer(target, 0);
+    return (std::size_t)size;
+}
+
+/// @brief VBO + EBO (l'EBO est lu hors VAO pour ne pas modifier son état).
+static std::size_t meshBytes(const Mesh& m) {
+    return bufferBytes(GL_ARRAY_BUFFER, m.vbo) + bufferBytes(GL_ARRAY_BUFFER, m.ebo);
+}
+
+/// @brief Tous les niveaux d'une texture 2D : taille compressée, sinon 4 octets par texel
+///        (RGB8 est stocké en RGBX par les drivers).
+static std::size_t textureBytes(GLuint tex) {
+    GLint maxLevel = 0;
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+    std::size_t bytes = 0;
+    for (GLint l = 0; l <= std::min(maxLevel, 15); ++l) {
+        GLint w = 0, h = 0, compressed = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, l, GL_TEXTURE_WIDTH, &w);
+        if (w == 0) break; // niveau non alloué
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, l, GL_TEXTURE_HEIGHT, &h);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, l, GL_TEXTURE_COMPRESSED, &compressed);
+        if (compressed) {
+            GLint size = 0;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, l, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+            bytes += (std::size_t)size;
+        } else {
+            bytes += (std::size_t)w * (std::size_t)h * 4;
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return bytes;
+}
+
+ResourceCache::Entry* ResourceCache::find(const std::string& key) {
+    for (Entry& e : list)
+        if (e.key == key) return &e;
+    return nullptr;
+}
+
+const ResourceCache::Entry* ResourceCache::find(const std::string& key) const {
+    for (const Entry& e : list)
+        if (e.key == key) return &e;
+    return nullptr;
+}
+
+Mesh ResourceCache::acquireMesh(const std::string& key, const std::function<Mesh()>& create) {
+    if (Entry* e = find(key)) {
+        e->refs++;
+        return e->mesh;
+    }
+    Entry e;
+    e.key = key;
+    e.mesh = create();
+    if (e.mesh.vao == 0) return e.mesh;
+    e.bytes = meshBytes(e.mesh);
+    e.refs = 1;
+    totalBytes += e.bytes;
+    list.push_back(e);
+    return list.back().mesh;
+}
+
+Mesh ResourceCache::acquireSphere(float radius, int stacks, int slices) {
+    char key[96];
+    std::snprintf(key, sizeof(key), "sphere:%g:%d:%d", radius, stacks, slices);
+    return acquireMesh(key, [=] { return createSphere(radius, stacks, slices); });
+}
+
+std::string ResourceCache::textureKey(const std::string& path, bool flipY) {
+    return (flipY ? "tex:" : "tex-noflip:") + path;
+}
+
+GLuint ResourceCache::acquireTexture(const std::string& path, bool flipY) {
+    return acquireTextureWith(textureKey(path, flipY), [&] { return loadTextureCached(path, flipY); });
+}
+
+GLuint ResourceCache::acquireTextureWith(const std::string& key, const std::function<GLuint()>& create) {
+    if (Entry* e = find(key)) {
+        e->refs++;
+        return e->texture;
+    }
+    Entry e;
+    e.key = key;
+    e.texture = create();
+    if (e.texture == 0) return 0;
+    e.bytes = textureBytes(e.texture);
+    e.refs = 1;
+    totalBytes += e.bytes;
+    list.push_back(e);
+    return e.texture;
+}
+
+void ResourceCache::erase(std::size_t i) {
+    Entry& e = list[i];
+    if (e.texture) glDeleteTextures(1, &e.texture);
+    if (e.mesh.vao) destroyMesh(e.mesh);
+    totalBytes -= e.bytes;
+    list[i] = std::move(list.back());
+    list.pop_back();
+}
+
+bool ResourceCache::addRef(const Mesh& mesh) {
+    if (mesh.vao == 0) return false;
+    for (Entry& e : list) {
+        if (e.mesh.vao != mesh.vao) continue;
+        e.refs++;
+        return true;
+    }
+    return false;
+}
+
+void ResourceCache::release(const Mesh& mesh) {
+    if (mesh.vao == 0) return;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        if (list[i].mesh.vao != mesh.vao) continue;
+        if (--list[i].refs == 0) erase(i);
+        return;
+    }
+}
+
+void ResourceCache::releaseTexture(GLuint texture) {
+    if (texture == 0) return;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        if (list[i].texture != texture) continue;
+        if (--list[i].refs == 0) erase(i);
+        return;
+    }
+}
+
+void ResourceCache::report(std::ostream& os) const {
+    for (const Entry& e : list)
+        os << "  " << e.key << " : " << e.refs << " ref(s), " << e.bytes / 1024.0 << " Ko\n";
+    os << "  total : " << list.size() << " ressource(s), " << totalBytes / 1024.0 << " Ko\n";
+}
+
+void ResourceCache::destroyAll() {
+    while (!list.empty()) erase(list.size() - 1);
+    totalBytes = 0;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Geometries/geometries.hpp"
+
+/**
+ * @file resource_cache.hpp
+ * @brief Cache des ressources GPU partagées (maillages, textures), compté par références.
+ *
+ * @details
+ * Une ressource est identifiée par une clé décrivant sa source : chemin de fichier
+ * ("tex:<chemin>", "obj:<chemin>") ou générateur + paramètres ("sphere:<r>:<st>:<sl>").
+ * Deux demandes de même clé renvoient les mêmes handles GL : 100 copies d'un modèle ne
+ * coûtent qu'une fois la mémoire GPU. Chaque acquire*() doit être suivi d'un release() ;
+ * la ressource est détruite au dernier release().
+ *
+ * La taille GPU de chaque ressource est lue sur le driver à l'enregistrement
+ * (GL_BUFFER_SIZE des VBO / EBO, tous les niveaux des textures) et cumulée dans gpuBytes().
+ * Un handle inconnu passé à release() est ignoré (ressource non partagée).
+ */
+class ResourceCache {
+public:
+    /**
+     * @struct Entry
+     * @brief Ressource enregistrée (maillage ou texture).
+     */
+    struct Entry {
+        std::string key;
+        Mesh mesh;            ///< Maillage (vao == 0 pour une texture).
+        GLuint texture = 0;   ///< Texture (0 pour un maillage).
+        std::size_t bytes = 0; ///< Mémoire GPU estimée (octets).
+        uint32_t refs = 0;
+    };
+
+    /**
+     * @brief Maillage partagé : créé par create() au premier appel pour cette clé.
+     * @return Le maillage (vao == 0 si create() a échoué ; rien n'est alors enregistré).
+     */
+    Mesh acquireMesh(const std::string& key, const std::function<Mesh()>& create);
+
+    /// @brief Sphère partagée (createSphere()), clé "sphere:<radius>:<stacks>:<slices>".
+    Mesh acquireSphere(float radius, int stacks, int slices);
+
+    /**
+     * @brief Texture partagée chargée depuis un fichier via son cache mipmappé (loadTextureCached()).
+     * @return Handle (0 si illisible ; rien n'est alors enregistré).
+     */
+    GLuint acquireTexture(const std::string& path, bool flipY = true);
+
+    /**
+     * @brief Texture partagée : créée par create() au premier appel pour cette clé.
+     * @details Pour les textures décodées hors du thread GL (voir AssetLoader).
+     */
+    GLuint acquireTextureWith(const std::string& key, const std::function<GLuint()>& create);
+
+    /// @brief Clé d'une texture chargée depuis un fichier (celle d'acquireTexture(path, flipY)).
+    static std::string textureKey(const std::string& path, bool flipY = true);
+
+    /**
+     * @brief Prend une référence de plus sur un maillage déjà enregistré (copie d'un handle).
+     * @return false si le maillage n'est pas dans le cache.
+     */
+    bool addRef(const Mesh& mesh);
+
+    /// @brief Rend une référence sur un maillage ; détruit au dernier release().
+    void release(const Mesh& mesh);
+
+    /// @brief Rend une référence sur une texture ; détruite au dernier release().
+    void releaseTexture(GLuint texture);
+
+    /// @brief Vrai si la clé est enregistrée.
+    bool contains(const std::string& key) const { return find(key) != nullptr; }
+
+    /// @brief Mémoire GPU totale des ressources vivantes (octets).
+    std::size_t gpuBytes() const { return totalBytes; }
+
+    /// @brief Ressources vivantes.
+    const std::vector<Entry>& entries() const { return list; }
+
+    /// @brief Écrit une ligne par ressource (clé, références, Ko) puis le total.
+    void report(std::ostream& os) const;
+
+    /// @brief Détruit toutes les ressources, quelles que soient leurs références.
+    void destroyAll();
+
+private:
+    Entry* find(const std::string& key);
+    const Entry* find(const std::string& key) const;
+    void erase(std::size_t i);
+
+    std::vector<Entry> list; ///< Peu d'entrées : recherche linéaire (comme la palette de SceneObjects).
+    std::size_t totalBytes = 0;
+};
+
+/// @brief Cache de ressources du contexte principal (thread de rendu).
+ResourceCache& resources();
@@ -7,214 +7,245 @@
  */
 
 #include "SceneObjects.hpp"
-#include <fstream>
-#include <sstream>
-#include <unordered_map>
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include "ARMatrices/mat4_batch.hpp"
+#include "GLUtils/gl_state.hpp"
+#include "FileIO/mapped_file.hpp"
+#include "ObjLoader/obj_loader.hpp"
+#include "MeshCache/mesh_cache.hpp"
+#include "MeshOptimizer/mesh_optimizer.hpp"
+#include "MeshOptimizer/mesh_simplify.hpp"
+#include "AssetLoader/asset_loader.hpp"
+#include "ResourceCache/resource_cache.hpp"
+#include "TextureCache/texture_cache.hpp"
+#include "AssetPack/asset_pack.hpp"
+#include "Texture/texture.hpp"
+
+static_assert(SceneObjects::MAX_LODS == OBJ_MAX_LODS, "SceneObjects::MAX_LODS != OBJ_MAX_LODS");
 
  
- /**
-  * @struct VKey
-  * @brief Clé personnalisée pour identifier un sommet dans un fichier OBJ.
-  * @details Utilisée pour dédupliquer les sommets en tenant compte des indices de position, texture et normale.
-  */
- struct VKey {
-     int vi; ///< Indice de position (vertex index).
-     int ti; ///< Indice de texture (texture index).
-     int ni; ///< Indice de normale (normal index).
- 
-     /**
-      * @brief Opérateur de comparaison pour VKey.
-      * @param o Autre clé à comparer.
-      * @return true si les clés sont identiques, false sinon.
-      */
-     bool operator==(const VKey& o) const {
-         return vi == o.vi && ti == o.ti && ni == o.ni;
-     }
- };
- 
- /**
-  * @struct VKeyHash
-  * @brief Fonction de hachage pour VKey, utilisée dans std::unordered_map.
-  */
- struct VKeyHash {
-     /**
-      * @brief Calcule le hash d'une clé VKey.
-      * @param k Clé à hacher.
-      * @return size_t Valeur de hachage.
-      */
-     size_t operator()(const VKey& k) const noexcept {
-         return (size_t)(k.vi * 73856093) ^ (size_t)(k.ti * 19349663) ^ (size_t)(k.ni * 83492791);
-     }
- };
- 
- /**
-  * @brief Parse un triplet d'indices OBJ (ex: "1/2/3" ou "1//3").
-  * @param token Chaîne à parser (ex: "1/2/3").
-  * @param vi Indice de position (output).
-  * @param ti Indice de texture (output).
-  * @param ni Indice de normale (output).
-  * @return true si le parsing a réussi, false sinon.
-  */
- static bool parseTriplet(const std::string& token, int& vi, int& ti, int& ni) {
-     vi = ti = ni = 0;
-     int slashCount = 0;
-     for (char c : token) if (c == '/') slashCount++;
- 
-     if (slashCount == 0) {
-         vi = std::stoi(token);
-         return true;
-     }
- 
-     if (slashCount == 1) {
-         size_t p = token.find('/');
-         auto s0 = token.substr(0, p);
-         auto s1 = token.substr(p + 1);
-         vi = s0.empty() ? 0 : std::stoi(s0);
-         ti = s1.empty() ? 0 : std::stoi(s1);
-         return true;
-     }
- 
-     size_t p1 = token.find('/');
-     size_t p2 = token.find('/', p1 + 1);
-     auto s0 = token.substr(0, p1);
-     auto s1 = token.substr(p1 + 1, p2 - (p1 + 1));
-     auto s2 = token.substr(p2 + 1);
-     vi = s0.empty() ? 0 : std::stoi(s0);
-     if (!s1.empty()) ti = std::stoi(s1);
-     if (!s2.empty()) ni = std::stoi(s2);
-     return true;
- }
- 
- /**
-  * @brief Corrige un indice OBJ pour le convertir en indice 0-based.
-  * @param idx Indice à corriger.
-  * @param n Taille du tableau de référence.
-  * @return int Indice corrigé.
-  */
- static int fixIndex(int idx, int n) {
-     if (idx > 0) return idx - 1;
-     if (idx < 0) return n + idx;
-     return -1;
- }
- 
- /**
-  * @brief Charge les données de position et d'indices dans un VAO OpenGL.
-  * @param pos Tableau de positions (float[3] par sommet).
-  * @param idx Tableau d'indices (uint32_t).
-  * @return Mesh Maillage prêt à être rendu.
-  */
- static Mesh upload_PosOnly(const std::vector<float>& pos, const std::vector<uint32_t>& idx) {
-     Mesh m{};
-     m.count = (GLsizei)idx.size();
- 
-     glGenVertexArrays(1, &m.vao);
-     glGenBuffers(1, &m.vbo);
-     glGenBuffers(1, &m.ebo);
- 
-     glBindVertexArray(m.vao);
- 
-     glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-     glBufferData(GL_ARRAY_BUFFER, pos.size() * sizeof(float), pos.data(), GL_STATIC_DRAW);
- 
-     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
-     glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx.size() * sizeof(uint32_t), idx.data(), GL_STATIC_DRAW);
- 
-     glEnableVertexAttribArray(0);
-     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
- 
-     glBindVertexArray(0);
-     return m;
- }
- 
+/**
+ * @brief Parse un fichier OBJ vers un maillage CPU (positions dédupliquées + indices).
+ * @param path Chemin vers le fichier OBJ.
+ * @param out Maillage CPU (vidé puis rempli).
+ * @return true si de la géométrie a été lue.
+ *
+ * @details Fichier projeté en mémoire puis parsé en parallèle (voir obj_loader.hpp).
+ */
+bool loadOBJData(const std::string& path, MeshData& out) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "[OBJ] Cannot open: " << path << "\n";
+        return false;
+    }
+
+    if (!parseOBJ(file.data(), file.size(), out)) {
+        std::cerr << "[OBJ] No geometry parsed from: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @struct OBJGeometry
+ * @brief Modèle d'un OBJ : pages du cache binaire projeté, ou modèle parsé.
+ */
+struct OBJGeometry {
+    MeshCacheView cache;        ///< Valide si le cache était à jour.
+    ObjModel parsed;            ///< Sinon : résultat du parse.
+    MeshBounds bounds;
+    const ObjVertex* vertices = nullptr;
+    const QuantizedVertex* quantized = nullptr; ///< Sommets quantifiés du cache (nullptr après un parse).
+    float posScale[3] = {}, posOffset[3] = {};
+    size_t vertexCount = 0;
+    const uint32_t* idx = nullptr;
+    size_t indexCount = 0;
+    const ObjSubmesh* submeshes = nullptr;
+    size_t submeshCount = 0;
+    std::string mtllib;
+    std::vector<std::string> materialNames;
+    uint32_t lodCount = 1;                ///< Sous-maillages rangés par LOD (submeshCount / lodCount par niveau).
+    float lodError[OBJ_MAX_LODS] = {};
+    size_t lod0IndexCount = 0;            ///< Indices du modèle source (les LOD suivent dans idx).
+};
+
+/// @brief Nombre d'indices du LOD 0 (ses sous-maillages sont en tête de idx).
+static size_t lod0Indices(const OBJGeometry& g) {
+    const size_t perLod = g.submeshCount / g.lodCount;
+    if (perLod == 0) return g.indexCount;
+    const ObjSubmesh& last = g.submeshes[perLod - 1];
+    return (size_t)last.firstIndex + last.indexCount;
+}
+
+/**
+ * @brief Obtient le modèle d'un OBJ via son cache binaire ("<obj>.meshcache").
+ * @details Cache à jour : projection mémoire, aucun parse. Sinon parse de l'OBJ,
+ *          optimisation (ordre des triangles et des sommets, voir mesh_optimizer.hpp) puis
+ *          (ré)écriture du cache pour le prochain démarrage. Le temps est affiché sur stderr.
+ * @return false si aucune géométrie n'a pu être lue.
+ */
+static bool loadOBJGeometry(const std::string& path, OBJGeometry& g) {
+    const auto t0 = std::chrono::steady_clock::now();
+    auto elapsedMs = [&] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    const std::string cachePath = meshCachePath(path);
+    auto fromCache = [&](const char* origin) {
+        g.bounds = g.cache.bounds();
+        g.vertices = g.cache.vertices();
+        g.quantized = g.cache.quantizedVertices();
+        std::copy(g.cache.posScale(), g.cache.posScale() + 3, g.posScale);
+        std::copy(g.cache.posOffset(), g.cache.posOffset() + 3, g.posOffset);
+        g.vertexCount = g.cache.vertexCount();
+        g.idx = g.cache.indices();
+        g.indexCount = g.cache.indexCount();
+        g.submeshes = g.cache.submeshes();
+        g.submeshCount = g.cache.submeshCount();
+        g.mtllib = g.cache.mtllib();
+        for (size_t i = 0; i < g.cache.materialCount(); ++i) g.materialNames.push_back(g.cache.materialName(i));
+        g.lodCount = g.cache.lodCount();
+        for (uint32_t l = 0; l < g.lodCount; ++l) g.lodError[l] = g.cache.lodError(l);
+        g.lod0IndexCount = lod0Indices(g);
+        std::cerr << "[OBJ] " << path << " : " << origin << " (" << elapsedMs() << " ms)\n";
+        return true;
+    };
+
+    // Archive montée : le cache y est lu en place, sans toucher à l'OBJ source
+    AssetSpan packed;
+    if (assetFS().find(cachePath, packed)) {
+        if (g.cache.open(packed.data, packed.size)) return fromCache("cache binaire (archive)");
+        std::cerr << "[OBJ] entree de l'archive invalide : " << cachePath << "\n";
+    }
+
+    MeshCacheKey key;
+    const bool hasKey = MeshCacheKey::fromFile(path, key);
+    if (hasKey && g.cache.open(cachePath, key)) return fromCache("cache binaire");
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "[OBJ] Cannot open: " << path << "\n";
+        return false;
+    }
+    if (!parseOBJModel(file.data(), file.size(), g.parsed)) {
+        std::cerr << "[OBJ] No geometry parsed from: " << path << "\n";
+        return false;
+    }
+    buildLods(g.parsed);
+    optimizeModel(g.parsed);
+
+    const ObjModel& m = g.parsed;
+    g.bounds = computeBounds(m.vertices[0].pos, m.vertices.size(), sizeof(ObjVertex) / sizeof(float));
+    g.vertices = m.vertices.data();
+    g.vertexCount = m.vertices.size();
+    g.idx = m.idx.data();
+    g.indexCount = m.idx.size();
+    g.submeshes = m.submeshes.data();
+    g.submeshCount = m.submeshes.size();
+    g.mtllib = m.mtllib;
+    g.materialNames = m.materialNames;
+    g.lodCount = m.lodCount;
+    for (uint32_t l = 0; l < g.lodCount; ++l) g.lodError[l] = m.lodError[l];
+    g.lod0IndexCount = lod0Indices(g);
+
+    const bool written = hasKey && writeMeshCache(cachePath, key, m, g.bounds);
+    std::cerr << "[OBJ] " << path << " : parse texte + " << g.lodCount << " LOD (" << elapsedMs() << " ms)"
+              << (written ? ", cache ecrit" : ", cache non ecrit") << "\n";
+    return true;
+}
+
+/**
+ * @brief Crée le VAO d'un modèle : sommets flottants (32 octets) ou quantifiés (16 octets).
+ * @details L'EBO contient tous les LOD ; Mesh::count ne couvre que le LOD 0. Les sommets
+ *          quantifiés viennent du cache ; ils ne sont calculés ici qu'après un parse.
+ */
+static Mesh uploadOBJGeometry(const OBJGeometry& g, bool quantized) {
+    Mesh mesh;
+    if (!quantized) {
+        mesh = uploadMeshPNT(g.vertices[0].pos, g.vertexCount, g.idx, g.indexCount);
+    } else if (g.quantized) {
+        mesh = uploadMeshQuantized(g.quantized, g.vertexCount, g.idx, g.indexCount, g.posScale, g.posOffset);
+    } else {
+        std::vector<QuantizedVertex> q(g.vertexCount);
+        float scale[3], offset[3];
+        quantizeVertices(g.vertices, g.vertexCount, q.data(), scale, offset);
+        mesh = uploadMeshQuantized(q.data(), g.vertexCount, g.idx, g.indexCount, scale, offset);
+    }
+    mesh.count = (GLsizei)g.lod0IndexCount;
+    return mesh;
+}
+
+/**
+ * @brief Lit le .mtl d'un OBJ ; les chemins de textures deviennent relatifs au répertoire courant.
+ */
+static std::vector<ObjMaterial> loadOBJMaterials(const std::string& objPath, const std::string& mtllib) {
+    std::vector<ObjMaterial> mats;
+    if (mtllib.empty()) return mats;
+
+    const std::filesystem::path mtlPath = std::filesystem::path(objPath).parent_path() / mtllib;
+    AssetFile file;
+    if (!assetFS().open(mtlPath.string(), file) || !parseMTL(file.data(), file.size(), mats)) {
+        std::cerr << "[OBJ] Cannot read materials: " << mtlPath.string() << "\n";
+        return mats;
+    }
+    for (ObjMaterial& m : mats)
+        if (!m.diffuseMap.empty())
+            m.diffuseMap = (mtlPath.parent_path() / m.diffuseMap).string();
+    return mats;
+}
+
  /**
   * @brief Charge un maillage depuis un fichier OBJ.
   * @param path Chemin vers le fichier OBJ.
+  * @param outBounds (opt) Bornes locales calculées sur les sommets retenus.
+  * @param quantized Sommets quantifiés (voir uploadMeshQuantized() ; posScale / posOffset à appliquer).
   * @return Mesh Maillage chargé (ou vide en cas d'erreur).
+  *
+  * @details Sommets entrelacés position / normale / uv (attributs 0, 1, 2), ou quantifiés,
+  *          tous les sous-maillages d'un seul tenant. Passe par le cache binaire : au démarrage
+  *          suivant, les pages projetées (dans l'un ou l'autre format) sont transmises
+  *          directement à glBufferData.
   */
- Mesh loadOBJMesh(const std::string& path) {
-     std::ifstream f(path);
-     if (!f.is_open()) {
-         std::cerr << "[OBJ] Cannot open: " << path << "\n";
-         return Mesh{};
-     }
- 
-     std::vector<glm::vec3> V;
-     V.reserve(10000);
- 
-     std::vector<float> outPos;
-     outPos.reserve(30000);
-     std::vector<uint32_t> outIdx;
-     outIdx.reserve(60000);
- 
-     std::unordered_map<VKey, uint32_t, VKeyHash> dedup;
-     dedup.reserve(60000);
- 
-     std::string line;
-     while (std::getline(f, line)) {
-         if (line.empty() || line[0] == '#') continue;
- 
-         std::istringstream iss(line);
-         std::string tag;
-         iss >> tag;
- 
-         if (tag == "v") {
-             glm::vec3 p;
-             iss >> p.x >> p.y >> p.z;
-             V.push_back(p);
-         }
-         else if (tag == "f") {
-             std::vector<VKey> face;
-             std::string tok;
-             while (iss >> tok) {
-                 int vi, ti, ni;
-                 if (!parseTriplet(tok, vi, ti, ni)) continue;
- 
-                 VKey k;
-                 k.vi = fixIndex(vi, (int)V.size());
-                 k.ti = (ti == 0) ? -1 : 0;
-                 k.ni = (ni == 0) ? -1 : 0;
- 
-                 if (k.vi < 0 || k.vi >= (int)V.size()) continue;
-                 face.push_back(k);
-             }
+ Mesh loadOBJMesh(const std::string& path, MeshBounds* outBounds, bool quantized) {
+     OBJGeometry g;
+     if (!loadOBJGeometry(path, g)) return Mesh{};
  
-             if (face.size() < 3) continue;
- 
-             auto getOrCreate = [&](const VKey& k) -> uint32_t {
-                 auto it = dedup.find(k);
-                 if (it != dedup.end()) return it->second;
- 
-                 const glm::vec3& p = V[k.vi];
-                 uint32_t id = (uint32_t)(outPos.size() / 3);
-                 outPos.push_back(p.x);
-                 outPos.push_back(p.y);
-                 outPos.push_back(p.z);
- 
-                 dedup.emplace(k, id);
-                 return id;
-             };
- 
-             uint32_t i0 = getOrCreate(face[0]);
-             for (size_t i = 1; i + 1 < face.size(); ++i) {
-                 uint32_t i1 = getOrCreate(face[i]);
-                 uint32_t i2 = getOrCreate(face[i + 1]);
-                 outIdx.push_back(i0);
-                 outIdx.push_back(i1);
-                 outIdx.push_back(i2);
-             }
-         }
-     }
- 
-     if (outIdx.empty() || outPos.empty()) {
-         std::cerr << "[OBJ] No geometry parsed from: " << path << "\n";
-         return Mesh{};
-     }
- 
-     return upload_PosOnly(outPos, outIdx);
+     if (outBounds) *outBounds = g.bounds;
+     return uploadOBJGeometry(g, quantized);
  }
  
- /**
+/**
+ * @brief Prépare un OBJ pour l'archive d'assets : (re)construit son cache binaire et liste
+ *        les fichiers dont le chargement a besoin.
+ * @param files Complété par le cache ("<obj>.meshcache") et le .mtl.
+ * @param images Complété par les textures diffuses (images sources, sans doublon).
+ * @return false si l'OBJ est illisible ou si le cache n'a pas pu être écrit.
+ */
+bool collectOBJFiles(const std::string& path, std::vector<std::string>& files, std::vector<std::string>& images) {
+    OBJGeometry g;
+    if (!loadOBJGeometry(path, g)) return false;
+    const std::string cachePath = meshCachePath(path);
+    MeshCacheKey key;
+    MeshCacheView check;
+    if (!MeshCacheKey::fromFile(path, key) || !check.open(cachePath, key)) {
+        std::cerr << "[OBJ] cache absent ou perime : " << cachePath << "\n";
+        return false;
+    }
+    files.push_back(cachePath);
+    if (!g.mtllib.empty())
+        files.push_back((std::filesystem::path(path).parent_path() / g.mtllib).string());
+    for (const ObjMaterial& m : loadOBJMaterials(path, g.mtllib))
+        if (!m.diffuseMap.empty() && std::find(images.begin(), images.end(), m.diffuseMap) == images.end())
+            images.push_back(m.diffuseMap);
+    return true;
+}
+
+/**
  * @brief Destructeur de SceneObjects.
  * Libère les ressources OpenGL des maillages.
  */
@@ -222,6 +253,105 @@ SceneObjects::~SceneObjects() {
     destroy();
 }
 
+/**
+ * @brief Calcule la matrice modèle d'un objet (T * Rx * Ry * Rz * S).
+ */
+static glm::mat4 modelMatrix(const SceneObjects::Item& it) {
+    glm::mat4 M(1.0f);
+    M = glm::translate(M, it.pos);
+    M = glm::rotate(M, glm::radians(it.rotDeg.x), glm::vec3(1,0,0));
+    M = glm::rotate(M, glm::radians(it.rotDeg.y), glm::vec3(0,1,0));
+    M = glm::rotate(M, glm::radians(it.rotDeg.z), glm::vec3(0,0,1));
+    M = glm::scale(M, it.scale);
+    return M;
+}
+
+/**
+ * @brief Remet les positions quantifiées dans le repère du maillage (q in [0,1] -> AABB).
+ * @details Composée à droite de la matrice modèle pour le dessin uniquement : bornes et
+ *          culling restent dans le repère d'origine.
+ */
+static glm::mat4 dequantMatrix(const Mesh& m) {
+    glm::mat4 D(1.0f);
+    D[0][0] = m.posScale[0];
+    D[1][1] = m.posScale[1];
+    D[2][2] = m.posScale[2];
+    D[3] = glm::vec4(m.posOffset[0], m.posOffset[1], m.posOffset[2], 1.0f);
+    return D;
+}
+
+/**
+ * @brief Clé de tri d'un draw : texture, puis matériau, puis VAO.
+ * @details Le programme est fixe pour un appel à drawAll(), il n'entre donc pas dans la clé.
+ *          Regrouper par texture d'abord minimise les glBindTexture (les plus coûteux),
+ *          puis les glUniform4f de couleur, puis les glBindVertexArray.
+ */
+static uint64_t makeSortKey(GLuint texture, uint32_t materialId, GLuint vao) {
+    return ((uint64_t)(texture & 0xFFFFu) << 48) | ((uint64_t)(materialId & 0xFFFFu) << 32) | (uint64_t)vao;
+}
+
+/**
+ * @brief Retourne l'indice de la couleur dans la palette (l'ajoute si absente).
+ */
+uint32_t SceneObjects::materialFor(const glm::vec4& color, GLuint texture) {
+    for (size_t i = 0; i < materials.size(); ++i)
+        if (materials[i].color == color && materials[i].texture == texture) return (uint32_t)i;
+    materials.push_back(Material{ color, texture });
+    return (uint32_t)materials.size() - 1;
+}
+
+/**
+ * @brief Texture diffuse partagée (resources()) : la scène en garde une référence par chemin.
+ */
+GLuint SceneObjects::textureFor(const std::string& path) {
+    for (const auto& t : textures)
+        if (t.first == path) return t.second;
+    const GLuint tex = resources().acquireTexture(path, true);
+    textures.emplace_back(path, tex);
+    return tex;
+}
+
+/**
+ * @brief Recalcule les matériaux (couleur x couleur de l'objet, texture) des sous-maillages.
+ */
+void SceneObjects::updateSubmeshMaterials(Item& it) {
+    for (Submesh& sm : it.submeshes)
+        sm.materialId = materialFor(sm.baseColor * it.color, sm.texture);
+}
+
+/**
+ * @struct OBJAsset
+ * @brief Résultat CPU du chargement d'un OBJ : modèle, matériaux et textures décodées.
+ */
+struct OBJAsset {
+    OBJGeometry geom;
+    std::vector<ObjMaterial> mtl;
+    std::vector<std::pair<std::string, std::unique_ptr<TextureCacheView>>> images; ///< Caches de textures diffuses ouverts, par chemin.
+    bool ok = false;
+};
+
+/**
+ * @brief Charge un OBJ et son .mtl sans aucun appel GL (utilisable sur un thread de travail).
+ * @param decodeImages Ouvre aussi les caches des textures diffuses, construits au besoin
+ *        (sinon : chargées à l'upload).
+ */
+static bool decodeOBJAsset(const std::string& path, OBJAsset& a, bool decodeImages) {
+    if (!loadOBJGeometry(path, a.geom)) return false;
+    a.mtl = loadOBJMaterials(path, a.geom.mtllib);
+    if (decodeImages) {
+        for (const ObjMaterial& m : a.mtl) {
+            if (m.diffuseMap.empty()) continue;
+            const bool seen = std::any_of(a.images.begin(), a.images.end(),
+                                          [&](const auto& im) { return im.first == m.diffuseMap; });
+            if (seen) continue;
+            auto view = std::make_unique<TextureCacheView>();
+            if (!openTextureCache(m.diffuseMap, preferredTexCacheFormat(true), true, *view)) view.reset();
+            a.images.emplace_back(m.diffuseMap, std::move(view));
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Ajoute un objet OBJ à la scène.
  * @param path Chemin vers le fichier OBJ.
@@ -237,18 +367,366 @@ int SceneObjects::addOBJ(
     glm::vec3 rotDeg,
     glm::vec3 scale,
     glm::vec4 color)
+{
+    const int src = findLoadedOBJ(path);
+    const int idx = addMesh(Mesh{}, pos, rotDeg, scale, color);
+    items[idx].path = path;
+    if (src >= 0) {
+        shareOBJ(idx, src); // déjà chargé : ni lecture disque, ni upload
+        return idx;
+    }
+
+    OBJAsset a;
+    if (decodeOBJAsset(path, a, false)) attachOBJ(idx, a);
+    return idx;
+}
+
+/**
+ * @brief Ajoute un objet OBJ chargé en arrière-plan (voir AssetLoader).
+ * @details L'objet est créé vide (Item::loading) ; son maillage et ses textures sont
+ *          uploadés par loader.pump(), après quoi il est dessiné normalement. Un upload
+ *          arrivant après destroy() ou la destruction de la scène est ignoré (jeton alive). Un chemin déjà chargé est partagé tout de
+ *          suite ; un chemin en cours de chargement n'est lu qu'une fois, les objets suivants
+ *          le partagent à l'upload.
+ */
+int SceneObjects::addOBJAsync(
+    AssetLoader& loader,
+    const std::string& path,
+    glm::vec3 pos,
+    glm::vec3 rotDeg,
+    glm::vec3 scale,
+    glm::vec4 color)
+{
+    const int src = findLoadedOBJ(path);
+    const int idx = addMesh(Mesh{}, pos, rotDeg, scale, color);
+    items[idx].path = path;
+    if (src >= 0) {
+        shareOBJ(idx, src);
+        return idx;
+    }
+
+    items[idx].loading = true;
+    for (auto& p : pendingOBJ) {
+        if (p.first != path) continue;
+        p.second.push_back(idx); // partagera le maillage du premier objet
+        return idx;
+    }
+    pendingOBJ.push_back({ path, { idx } });
+
+    auto asset = std::make_shared<OBJAsset>();
+    const std::weak_ptr<bool> token = alive;
+    loader.submit(
+        [asset, path] { asset->ok = decodeOBJAsset(path, *asset, true); },
+        [this, asset, path, token] {
+            if (token.expired()) return; // scène détruite ou vidée depuis l'envoi : this n'est plus lu
+            std::vector<int> waiting;
+            for (size_t i = 0; i < pendingOBJ.size(); ++i) {
+                if (pendingOBJ[i].first != path) continue;
+                waiting = std::move(pendingOBJ[i].second);
+                pendingOBJ.erase(pendingOBJ.begin() + i);
+                break;
+            }
+            for (int w : waiting) items[w].loading = false;
+            if (!asset->ok || waiting.empty()) return;
+            attachOBJ(waiting[0], *asset);
+            for (size_t k = 1; k < waiting.size(); ++k) shareOBJ(waiting[k], waiting[0]);
+        });
+    return idx;
+}
+
+/**
+ * @brief Objet résident déjà chargé depuis ce chemin (-1 si aucun).
+ */
+int SceneObjects::findLoadedOBJ(const std::string& path) const {
+    for (size_t i = 0; i < items.size(); ++i) {
+        const Item& it = items[i];
+        if (it.path == path && !it.loading && (it.mesh.vao != 0 || it.arenaMesh.valid())) return (int)i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Donne à l'objet idx le modèle de l'objet src (même OBJ) sans nouvelle copie GPU.
+ * @details VAO propre : une référence de plus dans resources(). Arène : même plage
+ *          d'indices, détenue par src (ownsMesh = false). Sous-maillages, LOD et bornes sont
+ *          copiés ; les matériaux sont recalculés avec la couleur de idx.
+ */
+void SceneObjects::shareOBJ(int idx, int src) {
+    Item& it = items[idx];
+    const Item& from = items[src];
+    it.bounds = from.bounds;
+    it.submeshes = from.submeshes;
+    it.lodCount = from.lodCount;
+    std::copy(from.lodError, from.lodError + MAX_LODS, it.lodError);
+
+    if (from.arenaMesh.valid()) {
+        it.arenaMesh = from.arenaMesh;
+        it.ownsMesh = false;
+        if (!it.submeshes.empty()) {
+            it.color = it.submeshes[0].baseColor * it.color;
+            it.materialId = materialFor(it.color);
+            drawData[idx].color = it.color;
+            markDrawData(idx);
+        }
+    } else {
+        it.mesh = from.mesh;
+        it.sharedMesh = resources().addRef(it.mesh);
+        it.ownsMesh = it.sharedMesh;
+        it.sortKey = makeSortKey(0, it.materialId, it.mesh.vao);
+        updateSubmeshMaterials(it);
+    }
+    it.dirty = true;
+    anyDirty = true;
+    orderDirty = true;
+}
+
+/**
+ * @brief Upload d'un OBJ chargé dans l'objet idx (créé vide) : textures, puis arène ou VAO propre.
+ */
+void SceneObjects::attachOBJ(int idx, OBJAsset& a) {
+    const OBJGeometry& g = a.geom;
+
+    // Textures préparées hors du thread GL (0 si illisibles : pas de nouvel essai)
+    for (const auto& im : a.images) {
+        const bool known = std::any_of(textures.begin(), textures.end(),
+                                       [&](const auto& t) { return t.first == im.first; });
+        if (known) continue;
+        const GLuint tex = resources().acquireTextureWith(ResourceCache::textureKey(im.first, true),
+                                                          [&] { return im.second ? uploadTextureCache(*im.second) : 0u; });
+        textures.emplace_back(im.first, tex);
+    }
+
+    // Matériaux des sous-maillages (.mtl) : couleur diffuse + texture
+    std::vector<Submesh> subs;
+    bool textured = false;
+    for (size_t s = 0; s < g.submeshCount; ++s) {
+        const ObjSubmesh& os = g.submeshes[s];
+        Submesh sm;
+        sm.firstIndex = os.firstIndex;
+        sm.count = (GLsizei)os.indexCount;
+        for (const ObjMaterial& m : a.mtl) {
+            if (m.name != g.materialNames[os.material]) continue;
+            sm.baseColor = m.diffuse;
+            if (!m.diffuseMap.empty()) sm.texture = textureFor(m.diffuseMap);
+            break;
+        }
+        textured = textured || sm.texture != 0;
+        subs.push_back(sm);
+    }
+
+    Item& it = items[idx];
+    it.bounds = g.bounds;
+    if (arena && !textured && g.submeshCount <= g.lodCount) {
+        // Couleur unie : l'arène (positions seules) suffit ; un sous-maillage par LOD
+        // (gardés aussi sans LOD : couleur de base pour shareOBJ())
+        std::vector<float> pos3(g.vertexCount * 3);
+        for (size_t v = 0; v < g.vertexCount; ++v)
+            std::memcpy(&pos3[v * 3], g.vertices[v].pos, 3 * sizeof(float));
+        if (!subs.empty()) {
+            it.color = subs[0].baseColor * it.color;
+            it.materialId = materialFor(it.color);
+            drawData[idx].color = it.color;
+            markDrawData(idx);
+        }
+        it.arenaMesh = arena->add(pos3.data(), (uint32_t)g.vertexCount, g.idx, (uint32_t)g.indexCount);
+        it.submeshes = std::move(subs);
+    } else {
+        // Texturé ou multi-matériaux : VAO propre partagé par chemin (voir resources()),
+        // dessiné par drawAll() trié par matériau
+        const std::string key = std::string(quantizeOBJ ? "obj-q:" : "obj:") + it.path;
+        it.mesh = resources().acquireMesh(key, [&] { return uploadOBJGeometry(g, quantizeOBJ); });
+        it.sharedMesh = it.mesh.vao != 0;
+        it.sortKey = makeSortKey(0, it.materialId, it.mesh.vao);
+        it.submeshes = std::move(subs);
+        updateSubmeshMaterials(it);
+    }
+    it.lodCount = g.lodCount;
+    std::copy(g.lodError, g.lodError + g.lodCount, it.lodError);
+    it.ownsMesh = true;
+    it.dirty = true;
+    anyDirty = true;
+    orderDirty = true;
+}
+
+/**
+ * @brief Ajoute un maillage CPU : dans l'arène si active, sinon dans un VAO propre.
+ * @return Index de l'objet ajouté.
+ */
+int SceneObjects::addMeshData(
+    const MeshData& data,
+    glm::vec3 pos,
+    glm::vec3 rotDeg,
+    glm::vec3 scale,
+    glm::vec4 color)
+{
+    const MeshBounds bounds = computeBounds(data.pos.data(), data.pos.size() / 3);
+
+    int idx;
+    if (arena) {
+        idx = addMesh(Mesh{}, pos, rotDeg, scale, color, bounds);
+        items[idx].arenaMesh = arena->add(data);
+    } else {
+        idx = addMesh(uploadMeshData(data), pos, rotDeg, scale, color, bounds);
+    }
+    items[idx].ownsMesh = true;
+    return idx;
+}
+
+/**
+ * @brief Ajoute un maillage existant à la scène, sans en prendre la propriété.
+ * @return Index de l'objet ajouté.
+ */
+int SceneObjects::addMesh(
+    const Mesh& mesh,
+    glm::vec3 pos,
+    glm::vec3 rotDeg,
+    glm::vec3 scale,
+    glm::vec4 color,
+    const MeshBounds& bounds)
 {
     Item it;
-    it.path = path;
-    it.mesh = loadOBJMesh(path);
+    it.mesh = mesh;
+    it.bounds = bounds;
+    it.ownsMesh = false;
     it.pos = pos;
     it.rotDeg = rotDeg;
     it.scale = scale;
     it.color = color;
+    it.materialId = materialFor(color);
+    it.sortKey = makeSortKey(0, it.materialId, it.mesh.vao);
     items.push_back(it);
+    models.push_back(glm::mat4(1.0f));
+    worldSpheres.push_back(glm::vec4(0.0f, 0.0f, 0.0f, -1.0f));
+    worldMin.push_back(glm::vec3(0.0f));
+    worldMax.push_back(glm::vec3(0.0f));
+    drawData.push_back(ArenaDrawData{glm::mat4(1.0f), color});
+    markDrawData(items.size() - 1);
+
+    anyDirty = true;
+    orderDirty = true;
     return (int)items.size() - 1;
 }
 
+void SceneObjects::setTransform(int idx, glm::vec3 pos, glm::vec3 rotDeg, glm::vec3 scale) {
+    Item& it = items[idx];
+    it.pos = pos;
+    it.rotDeg = rotDeg;
+    it.scale = scale;
+    it.dirty = true;
+    anyDirty = true;
+}
+
+void SceneObjects::setColor(int idx, glm::vec4 color) {
+    Item& it = items[idx];
+    it.color = color;
+    it.materialId = materialFor(color);
+    it.sortKey = makeSortKey(0, it.materialId, it.mesh.vao);
+    updateSubmeshMaterials(it);
+    orderDirty = true;
+
+    drawData[idx].color = color;
+    markDrawData(idx);
+}
+
+/**
+ * @brief Étend l'intervalle des données par draw à renvoyer au GPU.
+ */
+void SceneObjects::markDrawData(size_t i) {
+    drawDataLo = std::min(drawDataLo, i);
+    drawDataHi = std::max(drawDataHi, i + 1);
+}
+
+/**
+ * @brief Niveau de détail d'un objet : le plus grossier dont l'erreur projetée reste
+ *        sous lodPixelError pixels.
+ * @details Taille projetée de la sphère englobante monde : rayon x échelle verticale de
+ *          MVP_maze (norme de sa 2e ligne) / w du centre, convertie en pixels par lodViewportH.
+ */
+uint32_t SceneObjects::selectLod(size_t i, const glm::mat4& MVP_maze) const {
+    const Item& it = items[i];
+    const glm::vec4& sph = worldSpheres[i];
+    if (it.lodCount <= 1 || lodPixelError <= 0.0f || sph.w <= 0.0f || it.bounds.radius <= 0.0f) return 0;
+
+    const glm::vec4 clip = MVP_maze * glm::vec4(glm::vec3(sph), 1.0f);
+    if (clip.w <= sph.w) return 0; // caméra dans (ou derrière) la sphère
+    const float sy = glm::length(glm::vec3(MVP_maze[0][1], MVP_maze[1][1], MVP_maze[2][1]));
+    // pixels par unité du modèle au centre de l'objet
+    const float pxPerUnit = (sph.w / it.bounds.radius) * sy / clip.w * 0.5f * lodViewportH;
+
+    uint32_t lod = 0;
+    while (lod + 1 < it.lodCount && it.lodError[lod + 1] * pxPerUnit <= lodPixelError) ++lod;
+    return lod;
+}
+
+/**
+ * @brief Test de visibilité d'un objet (sphère puis AABB monde).
+ */
+bool SceneObjects::isCulled(size_t i, const Frustum& frustum) const {
+    const glm::vec4& sph = worldSpheres[i];
+    if (sph.w < 0.0f) return false; // bornes inconnues
+    const int c = frustum.classifySphere(glm::vec3(sph), sph.w);
+    return c < 0 || (c == 0 && !frustum.intersectsAABB(worldMin[i], worldMax[i]));
+}
+
+void SceneObjects::setVisible(int idx, bool visible) {
+    items[idx].visible = visible;
+}
+
+/**
+ * @brief Recalcule uniquement les matrices (et bornes monde) marquées invalides, puis retrie si besoin.
+ */
+void SceneObjects::updateCache() {
+    if (anyDirty) {
+        for (size_t i = 0; i < items.size(); ++i) {
+            Item& it = items[i];
+            if (!it.dirty) continue;
+            it.model = modelMatrix(it);
+            models[i] = isQuantized(it.mesh) ? it.model * dequantMatrix(it.mesh) : it.model;
+            worldSpheres[i] = transformBounds(it.bounds, it.model, worldMin[i], worldMax[i]);
+            drawData[i].model = it.model;
+            markDrawData(i);
+            it.dirty = false;
+        }
+        anyDirty = false;
+    }
+
+    if (orderDirty) {
+        // Un draw par objet, ou par sous-maillage pour les modèles multi-matériaux
+        packets.clear();
+        for (size_t i = 0; i < items.size(); ++i) {
+            const Item& it = items[i];
+            if (it.mesh.vao == 0 || it.mesh.count == 0) continue;
+            if (it.submeshes.empty()) {
+                packets.push_back({ (uint32_t)i, 0, it.mesh.count, it.materialId, it.sortKey, 0 });
+                continue;
+            }
+            // Tous les LOD : drawAll() ne garde que ceux du LOD choisi pour la frame
+            const size_t perLod = it.submeshes.size() / it.lodCount;
+            for (size_t s = 0; s < it.submeshes.size(); ++s) {
+                const Submesh& sm = it.submeshes[s];
+                if (sm.count == 0) continue;
+                packets.push_back({ (uint32_t)i, sm.firstIndex, sm.count, sm.materialId,
+                                    makeSortKey(sm.texture, sm.materialId, it.mesh.vao), (uint8_t)(s / perLod) });
+            }
+        }
+        // stable : à clé égale, l'ordre d'insertion est conservé
+        std::stable_sort(packets.begin(), packets.end(), [](const DrawPacket& a, const DrawPacket& b) {
+            return a.key < b.key;
+        });
+        orderDirty = false;
+    }
+}
+
+/**
+ * @brief MVP de tous les objets en un lot : mvps[i] = MVP_maze * models[i].
+ */
+const std::vector<glm::mat4>& SceneObjects::computeMVPs(const glm::mat4& MVP_maze) {
+    updateCache();
+    mvps.resize(models.size());
+    mat4MulBatch(MVP_maze, models.data(), mvps.data(), models.size());
+    return mvps;
+}
+
 /**
  * @brief Dessine tous les objets de la scène.
  * @param progFace Programme OpenGL pour le rendu.
@@ -260,27 +738,140 @@ void SceneObjects::drawAll(
     GLuint progFace,
     GLint uMVP,
     GLint uColor,
-    const glm::mat4& MVP_maze) const
+    const glm::mat4& MVP_maze)
 {
-    glUseProgram(progFace);
-    for (const auto& it : items) {
+    computeMVPs(MVP_maze);
+
+    // Les bornes monde sont dans le repère du labyrinthe : plans extraits de MVP_maze
+    const Frustum frustum = Frustum::fromMatrix(MVP_maze);
+
+    stats = DrawStats{};
+    visibleNow.assign(items.size(), 0);
+    lodNow.assign(items.size(), 0);
+    for (size_t i = 0; i < items.size(); ++i) {
+        const Item& it = items[i];
         if (!it.visible || it.mesh.vao == 0 || it.mesh.count == 0) continue;
+        if (isCulled(i, frustum)) {
+            stats.culled++;
+            continue;
+        }
+        visibleNow[i] = 1;
+        lodNow[i] = (uint8_t)selectLod(i, MVP_maze);
+        stats.lodItems[lodNow[i]]++;
+    }
+
+    glUseProgram(progFace);
+
+    // Uniformes de texture (absents de FACE_FS : les textures sont alors ignorées)
+    if (progFace != texProgram) {
+        texProgram = progFace;
+        uHasTex = glGetUniformLocation(progFace, "uHasTex");
+        const GLint uTex = glGetUniformLocation(progFace, "uTex");
+        if (uTex >= 0) glUniform1i(uTex, 0);
+    }
 
-        glm::mat4 M(1.0f);
-        M = glm::translate(M, it.pos);
-        M = glm::rotate(M, glm::radians(it.rotDeg.x), glm::vec3(1,0,0));
-        M = glm::rotate(M, glm::radians(it.rotDeg.y), glm::vec3(0,1,0));
-        M = glm::rotate(M, glm::radians(it.rotDeg.z), glm::vec3(0,0,1));
-        M = glm::scale(M, it.scale);
+    GLuint boundVao = 0;
+    uint32_t boundMaterial = UINT32_MAX;
+    GLuint boundTexture = UINT32_MAX;
+    int hasTexState = -1;
+    uint32_t lastItem = UINT32_MAX;
+    if (uHasTex >= 0) glActiveTexture(GL_TEXTURE0);
 
-        glm::mat4 MVP = MVP_maze * M;
-        glUniformMatrix4fv(uMVP, 1, GL_FALSE, &MVP[0][0]);
-        glUniform4f(uColor, it.color.r, it.color.g, it.color.b, it.color.a);
+    for (const DrawPacket& pk : packets) {
+        if (!visibleNow[pk.item] || pk.lod != lodNow[pk.item]) continue;
+        const Item& it = items[pk.item];
 
-        glBindVertexArray(it.mesh.vao);
-        glDrawElements(GL_TRIANGLES, it.mesh.count, GL_UNSIGNED_INT, 0);
+        if (pk.item != lastItem) {
+            glUniformMatrix4fv(uMVP, 1, GL_FALSE, &mvps[pk.item][0][0]);
+            if (visibleNow[pk.item] == 1) { stats.drawn++; visibleNow[pk.item] = 2; }
+            lastItem = pk.item;
+        }
+
+        if (pk.materialId != boundMaterial) {
+            const Material& m = materials[pk.materialId];
+            glUniform4f(uColor, m.color.r, m.color.g, m.color.b, m.color.a);
+            boundMaterial = pk.materialId;
+            stats.colorUploads++;
+
+            if (uHasTex >= 0) {
+                const int want = m.texture != 0 ? 1 : 0;
+                if (want != hasTexState) {
+                    glUniform1i(uHasTex, want);
+                    hasTexState = want;
+                }
+                if (m.texture != 0 && m.texture != boundTexture) {
+                    glBindTexture(GL_TEXTURE_2D, m.texture);
+                    boundTexture = m.texture;
+                    stats.textureBinds++;
+                }
+            }
+        }
+        if (it.mesh.vao != boundVao) {
+            glBindVertexArray(it.mesh.vao);
+            boundVao = it.mesh.vao;
+            stats.vaoBinds++;
+        }
+        glDrawElements(GL_TRIANGLES, pk.count, it.mesh.indexType,
+                       (void*)(uintptr_t)(pk.firstIndex * indexSize(it.mesh.indexType)));
+        stats.drawCalls++;
+        stats.triangles += pk.count / 3;
     }
     glBindVertexArray(0);
+    if (boundTexture != UINT32_MAX) glBindTexture(GL_TEXTURE_2D, 0);
+    glState().invalidate(); // binds directs (chemin de référence, hors cache)
+}
+
+/**
+ * @brief Dessine les objets de l'arène : upload des draws modifiés, culling, puis une soumission.
+ * @param progArena Programme ARENA.
+ * @param MVP_maze Matrice MVP globale (culling).
+ * @param firstItem Premier objet considéré.
+ * @param endItem Fin (exclue), -1 = tous les objets suivants.
+ */
+void SceneObjects::drawArena(
+    GLuint progArena,
+    const glm::mat4& MVP_maze,
+    int firstItem,
+    int endItem)
+{
+    stats = DrawStats{};
+    if (!arena) return;
+
+    updateCache();
+
+    if (drawDataLo < drawDataHi) {
+        arena->uploadDrawData((uint32_t)drawDataLo, (uint32_t)(drawDataHi - drawDataLo),
+                              drawData.data() + drawDataLo);
+        drawDataLo = SIZE_MAX;
+        drawDataHi = 0;
+    }
+
+    const Frustum frustum = Frustum::fromMatrix(MVP_maze);
+
+    cmds.clear();
+    const size_t end = endItem < 0 ? items.size() : std::min(items.size(), (size_t)endItem);
+    for (size_t i = (size_t)std::max(firstItem, 0); i < end; ++i) {
+        const Item& it = items[i];
+        if (!it.visible || !it.arenaMesh.valid()) continue;
+        if (isCulled(i, frustum)) {
+            stats.culled++;
+            continue;
+        }
+        GLuint first = it.arenaMesh.firstIndex, count = (GLuint)it.arenaMesh.count;
+        if (it.lodCount > 1) {
+            // Modèle OBJ à LOD : un sous-maillage par niveau, relatif au début du maillage
+            const uint32_t lod = selectLod(i, MVP_maze);
+            stats.lodItems[lod]++;
+            first += it.submeshes[lod].firstIndex;
+            count = (GLuint)it.submeshes[lod].count;
+        }
+        cmds.push_back({ count, 1u, first, it.arenaMesh.baseVertex, (GLuint)i });
+        stats.triangles += (int)count / 3;
+    }
+
+    glState().useProgram(progArena);
+    stats.drawCalls = arena->draw(cmds);
+    stats.drawn = (int)cmds.size();
 }
 
 /**
@@ -288,9 +879,34 @@ void SceneObjects::drawAll(
  */
 void SceneObjects::destroy() {
     for (auto& it : items) {
+        if (!it.ownsMesh) continue;
+        if (arena && it.arenaMesh.valid()) arena->release(it.arenaMesh);
+        if (it.sharedMesh) {
+            resources().release(it.mesh);
+            continue;
+        }
         if (it.mesh.vao != 0) glDeleteVertexArrays(1, &it.mesh.vao);
         if (it.mesh.vbo != 0) glDeleteBuffers(1, &it.mesh.vbo);
         if (it.mesh.ebo != 0) glDeleteBuffers(1, &it.mesh.ebo);
     }
+    for (auto& t : textures) resources().releaseTexture(t.second);
+    textures.clear();
+    pendingOBJ.clear();
+    texProgram = 0;
+    uHasTex = -1;
     items.clear();
+    materials.clear();
+    models.clear();
+    mvps.clear();
+    worldSpheres.clear();
+    worldMin.clear();
+    worldMax.clear();
+    packets.clear();
+    visibleNow.clear();
+    lodNow.clear();
+    drawData.clear();
+    drawDataLo = SIZE_MAX;
+    drawDataHi = 0;
+    anyDirty = orderDirty = false;
+    alive = std::make_shared<bool>(true); // uploads asynchrones encore en attente : ignorés
 }
@@ -2,16 +2,42 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "Geometries/geometries.hpp"
+#include "Culling/culling.hpp"
+#include "GeometryArena/geometry_arena.hpp"
+
+class AssetLoader;
+struct OBJAsset;
+
+/**
+ * @brief Parse un fichier OBJ vers un maillage CPU (sans upload GL).
+ * @param path Chemin vers le fichier OBJ.
+ * @param out Maillage CPU résultant.
+ * @return true si de la géométrie a été lue.
+ */
+bool loadOBJData(const std::string& path, MeshData& out);
 
 /**
  * @brief Charge un maillage OBJ depuis un fichier.
  * @param path Chemin vers le fichier OBJ.
+ * @param outBounds (opt) Bornes locales du maillage (AABB + sphère).
+ * @param quantized Sommets quantifiés 16 octets (Mesh::posScale / posOffset à composer avec le modèle).
  * @return Mesh Structure contenant les données du maillage.
  */
-Mesh loadOBJMesh(const std::string& path);
+Mesh loadOBJMesh(const std::string& path, MeshBounds* outBounds = nullptr, bool quantized = false);
+
+/**
+ * @brief Prépare un OBJ pour l'archive d'assets (voir asset_pack.hpp) : écrit son cache
+ *        binaire, ajoute à files le cache et le .mtl, à images les textures diffuses (sources :
+ *        leurs caches sont construits par l'appelant, format par format).
+ * @return false si l'OBJ est illisible ou si le cache n'a pas pu être écrit.
+ */
+bool collectOBJFiles(const std::string& path, std::vector<std::string>& files, std::vector<std::string>& images);
 
 /**
  * @class SceneObjects
@@ -20,6 +46,21 @@ Mesh loadOBJMesh(const std::string& path);
 class SceneObjects
 {
 public:
+    static constexpr uint32_t MAX_LODS = 4; ///< Niveaux de détail maximum (LOD 0 compris).
+
+    /**
+     * @struct Submesh
+     * @brief Plage d'indices d'un modèle OBJ dessinée avec un même matériau.
+     */
+    struct Submesh
+    {
+        GLuint firstIndex = 0;       ///< Premier indice dans l'EBO du maillage.
+        GLsizei count = 0;           ///< Nombre d'indices.
+        glm::vec4 baseColor{1.0f};   ///< Couleur du matériau OBJ (Kd, d), multipliée par Item::color.
+        GLuint texture = 0;          ///< Texture diffuse (0 : aucune), partagée via resources().
+        uint32_t materialId = 0;     ///< Indice dans la palette (couleur finale + texture).
+    };
+
     /**
      * @struct Item
      * @brief Structure représentant un objet 3D dans la scène.
@@ -33,6 +74,49 @@ public:
         glm::vec3 scale{1,1,1};      ///< Échelle de l'objet.
         glm::vec4 color{0.8f,0.8f,0.8f,1.0f}; ///< Couleur de l'objet (RGBA).
         bool visible = true;  ///< Visibilité de l'objet.
+        bool ownsMesh = true; ///< Le maillage est détruit par destroy() (false si partagé).
+        bool loading = false; ///< Chargement asynchrone en cours (rien à dessiner d'ici là).
+        bool sharedMesh = false; ///< mesh appartient à resources() (une référence, rendue par destroy()).
+
+        glm::mat4 model{1.0f};     ///< Matrice modèle en cache (T * Rx * Ry * Rz * S).
+        bool dirty = true;         ///< La matrice modèle doit être recalculée.
+        uint32_t materialId = 0;   ///< Indice de la couleur dans la palette de la scène.
+        uint64_t sortKey = 0;      ///< Clé de tri (texture, matériau, VAO) pour limiter les changements d'état.
+        std::vector<Submesh> submeshes; ///< Sous-maillages par matériau, rangés par LOD (vide : tout le maillage).
+        uint32_t lodCount = 1;          ///< Niveaux de détail (submeshes.size() / lodCount sous-maillages par niveau).
+        float lodError[MAX_LODS] = {};  ///< Erreur géométrique de chaque LOD (unités du modèle).
+        MeshBounds bounds;         ///< Bornes locales du maillage (invalides : jamais rejeté).
+        ArenaMesh arenaMesh;       ///< Maillage dans l'arène (si ajouté en mode arène).
+    };
+
+    /**
+     * @struct DrawStats
+     * @brief Compteurs du dernier appel à drawAll() ou drawArena().
+     */
+    struct DrawStats
+    {
+        int drawn = 0;         ///< Objets dessinés.
+        int vaoBinds = 0;      ///< Nombre de glBindVertexArray émis.
+        int colorUploads = 0;  ///< Nombre de glUniform4f (couleur) émis.
+        int textureBinds = 0;  ///< Nombre de glBindTexture émis.
+        int culled = 0;        ///< Objets visibles rejetés par le frustum culling.
+        int drawCalls = 0;     ///< Appels de dessin émis (1 avec multi-draw indirect, 1 par sous-maillage sinon).
+        int triangles = 0;     ///< Triangles soumis.
+        int lodItems[MAX_LODS] = {}; ///< Objets visibles par LOD choisi.
+
+        /// @brief Cumule les compteurs d'une autre passe (ex. arène découpée en plusieurs soumissions).
+        DrawStats& operator+=(const DrawStats& o)
+        {
+            drawn += o.drawn;
+            vaoBinds += o.vaoBinds;
+            colorUploads += o.colorUploads;
+            textureBinds += o.textureBinds;
+            culled += o.culled;
+            drawCalls += o.drawCalls;
+            triangles += o.triangles;
+            for (uint32_t l = 0; l < MAX_LODS; ++l) lodItems[l] += o.lodItems[l];
+            return *this;
+        }
     };
 
     /**
@@ -42,11 +126,17 @@ public:
 
     /**
      * @brief Ajoute un objet 3D à la scène à partir d'un fichier OBJ.
+     * @details Normales, uv et matériaux (.mtl : Kd, d, map_Kd) sont conservés ; 3 LOD simplifiés
+     *          sont générés au premier chargement et stockés dans le cache binaire. Un modèle
+     *          texturé ou multi-matériaux a son propre VAO (dessiné par drawAll(), un draw par
+     *          sous-maillage) ; sinon, en mode arène, il rejoint l'arène (positions seules).
+     *          Un chemin déjà chargé n'est ni relu ni réuploadé : les objets partagent le
+     *          même maillage (VAO via resources(), ou même plage de l'arène).
      * @param path Chemin vers le fichier OBJ.
      * @param pos Position de l'objet.
      * @param rotDeg Rotation de l'objet en degrés.
      * @param scale Échelle de l'objet.
-     * @param color Couleur de l'objet (par défaut : gris clair).
+     * @param color Couleur de l'objet, multipliée par celle des matériaux (par défaut : gris clair).
      * @return int Index de l'objet ajouté.
      */
     int addOBJ(
@@ -58,18 +148,167 @@ public:
     );
 
     /**
-     * @brief Dessine tous les objets visibles de la scène.
-     * @param progFace Identifiant du programme de shader.
+     * @brief Ajoute un objet OBJ chargé en arrière-plan : lecture, parse et décodage des
+     *        textures sur les threads de loader, upload GL dans loader.pump().
+     * @details L'objet existe tout de suite (index stable, transformable) mais n'est dessiné
+     *          qu'une fois son maillage résident (Item::loading repasse à false). Mêmes
+     *          paramètres que addOBJ().
+     *
+     *          Durée de vie : la scène peut être détruite ou vidée (destroy()) avec des
+     *          chargements en file ; leurs uploads sont alors ignorés par loader.pump(). Elle ne
+     *          doit pas être déplacée ni copiée tant que des chargements sont en cours (l'upload
+     *          s'applique à l'objet d'origine).
+     * @return int Index de l'objet ajouté.
+     */
+    int addOBJAsync(
+        AssetLoader& loader,
+        const std::string& path,
+        glm::vec3 pos,
+        glm::vec3 rotDeg,
+        glm::vec3 scale,
+        glm::vec4 color = glm::vec4(0.8f,0.8f,0.8f,1.0f)
+    );
+
+    /**
+     * @brief Place les maillages ajoutés ensuite dans une arène de géométrie partagée.
+     * @param arena Arène (doit survivre à la scène ou à destroy()) ; nullptr = VAO individuels.
+     */
+    void useArena(GeometryArena* arena) { this->arena = arena; }
+
+    /**
+     * @brief Quantifie les sommets des modèles OBJ ajoutés ensuite (hors arène).
+     * @details Position 16 bits dans l'AABB, normale octaédrique, uv demi-flottants : 16 octets
+     *          par sommet au lieu de 32, lus tels quels dans le cache binaire (rien à calculer au chargement).
+     *          La déquantification est composée à la matrice modèle.
+     */
+    void useQuantizedVertices(bool on) { quantizeOBJ = on; }
+
+    /**
+     * @brief Paramètres du choix de LOD (par objet, à chaque frame, depuis MVP_maze).
+     * @param viewportHeightPx Hauteur du framebuffer en pixels.
+     * @param maxPixelError Erreur géométrique projetée tolérée (pixels) ; <= 0 : toujours le LOD 0.
+     */
+    void setLodSelection(float viewportHeightPx, float maxPixelError = 1.0f) {
+        lodViewportH = viewportHeightPx;
+        lodPixelError = maxPixelError;
+    }
+
+    /**
+     * @brief Ajoute un maillage CPU (possédé par la scène : arène si active, sinon VAO propre).
+     * @param data Maillage CPU (positions + indices).
+     * @param pos Position de l'objet.
+     * @param rotDeg Rotation de l'objet en degrés.
+     * @param scale Échelle de l'objet.
+     * @param color Couleur de l'objet.
+     * @return int Index de l'objet ajouté.
+     */
+    int addMeshData(
+        const MeshData& data,
+        glm::vec3 pos,
+        glm::vec3 rotDeg,
+        glm::vec3 scale,
+        glm::vec4 color = glm::vec4(0.8f,0.8f,0.8f,1.0f)
+    );
+
+    /**
+     * @brief Ajoute un maillage déjà chargé (non possédé par la scène).
+     * @param mesh Maillage à dessiner (reste à la charge de l'appelant).
+     * @param pos Position de l'objet.
+     * @param rotDeg Rotation de l'objet en degrés.
+     * @param scale Échelle de l'objet.
+     * @param color Couleur de l'objet.
+     * @param bounds Bornes locales du maillage (par défaut : inconnues, pas de culling).
+     * @return int Index de l'objet ajouté.
+     */
+    int addMesh(
+        const Mesh& mesh,
+        glm::vec3 pos,
+        glm::vec3 rotDeg,
+        glm::vec3 scale,
+        glm::vec4 color = glm::vec4(0.8f,0.8f,0.8f,1.0f),
+        const MeshBounds& bounds = MeshBounds{}
+    );
+
+    /**
+     * @brief Modifie la transformation d'un objet (marque sa matrice en cache comme invalide).
+     */
+    void setTransform(int idx, glm::vec3 pos, glm::vec3 rotDeg, glm::vec3 scale);
+
+    /**
+     * @brief Modifie la couleur d'un objet (recalcule son matériau et l'ordre de tri).
+     */
+    void setColor(int idx, glm::vec4 color);
+
+    /**
+     * @brief Affiche ou masque un objet.
+     */
+    void setVisible(int idx, bool visible);
+
+    /// @brief Accès en lecture à un objet.
+    const Item& item(int idx) const { return items[idx]; }
+
+    /// @brief Nombre d'objets dans la scène.
+    int size() const { return (int)items.size(); }
+
+    /**
+     * @brief Recalcule les matrices modèle invalides et l'ordre de soumission si nécessaire.
+     * @details Appelé par drawAll(), exposé pour mesurer la préparation CPU sans contexte GL.
+     */
+    void updateCache();
+
+    /**
+     * @brief Calcule MVP_maze * model pour tous les objets en un seul lot SIMD.
+     * @param MVP_maze Matrice MVP de la scène.
+     * @return Tableau des MVP, indexé comme les objets.
+     */
+    const std::vector<glm::mat4>& computeMVPs(const glm::mat4& MVP_maze);
+
+    /**
+     * @brief Dessine tous les objets visibles de la scène (hors arène).
+     * @param progFace Identifiant du programme de shader (FACE_* ou MESH_*).
      * @param uMVP Localisation de l'uniforme MVP dans le shader.
      * @param uColor Localisation de l'uniforme de couleur dans le shader.
      * @param MVP_maze Matrice MVP de la scène.
+     *
+     * @details
+     * Un draw par objet, ou par sous-maillage pour les modèles OBJ multi-matériaux, soumis
+     * triés par clé (texture, matériau, VAO) : texture, couleur et VAO ne sont renvoyés au
+     * driver que lorsqu'ils changent. Si le programme déclare uHasTex / uTex (MESH_FS), les
+     * textures diffuses sont liées sur l'unité 0. Les objets dont les bornes monde sont hors
+     * du frustum de MVP_maze ne sont pas soumis (voir lastStats().culled). Pour les modèles
+     * à LOD, seul le niveau choisi (voir setLodSelection()) est soumis.
      */
     void drawAll(
         GLuint progFace,
         GLint uMVP,
         GLint uColor,
         const glm::mat4& MVP_maze
-    ) const;
+    );
+
+    /**
+     * @brief Dessine tous les objets de l'arène en une soumission (multi-draw indirect).
+     * @param progArena Programme ARENA_VS/ARENA_FS (uDrawData sur GeometryArena::DRAW_DATA_UNIT).
+     * @param MVP_maze Matrice MVP de la scène (sert au culling).
+     * @param firstItem Premier objet considéré.
+     * @param endItem Fin (exclue) des objets considérés, -1 = jusqu'au dernier.
+     *
+     * @details
+     * Les blocs Camera/Object (P, M_board, modelMaze) doivent être liés par l'appelant,
+     * de sorte que uP * uV * uModel == MVP_maze.
+     * Les matrices modèle et couleurs ne sont renvoyées au GPU que pour les objets modifiés.
+     * Le culling est identique à drawAll() ; seuls les objets placés dans l'arène sont dessinés.
+     * Une plage d'objets permet de découper la soumission (mesure par passe) ; par défaut,
+     * toute l'arène part en une soumission.
+     */
+    void drawArena(
+        GLuint progArena,
+        const glm::mat4& MVP_maze,
+        int firstItem = 0,
+        int endItem = -1
+    );
+
+    /// @brief Compteurs du dernier drawAll() / drawArena().
+    const DrawStats& lastStats() const { return stats; }
 
     /**
      * @brief Libère les ressources OpenGL de tous les objets de la scène.
@@ -77,5 +316,48 @@ public:
     void destroy();
 
 private:
+    /// @brief Matériau de la palette : couleur finale + texture diffuse.
+    struct Material { glm::vec4 color; GLuint texture; };
+
+    /// @brief Draw préparé (objet entier ou sous-maillage), trié par clé.
+    struct DrawPacket { uint32_t item; GLuint firstIndex; GLsizei count; uint32_t materialId; uint64_t key; uint8_t lod; };
+
+    uint32_t materialFor(const glm::vec4& color, GLuint texture = 0);
+    GLuint textureFor(const std::string& path);
+    void updateSubmeshMaterials(Item& it);
+    void attachOBJ(int idx, OBJAsset& a);
+    int findLoadedOBJ(const std::string& path) const;
+    void shareOBJ(int idx, int src);
+    bool isCulled(size_t i, const Frustum& frustum) const;
+    uint32_t selectLod(size_t i, const glm::mat4& MVP_maze) const;
+    void markDrawData(size_t i);
+
     std::vector<Item> items; ///< Liste des objets de la scène.
+
+    std::vector<Material> materials;   ///< Palette (couleur, texture) distincte (indexée par materialId).
+    std::vector<std::pair<std::string, GLuint>> textures; ///< Textures par chemin (une référence resources() chacune).
+    std::vector<std::pair<std::string, std::vector<int>>> pendingOBJ; ///< Chargements asynchrones en cours : objets en attente par chemin.
+    std::vector<glm::mat4> models;     ///< Matrices de dessin contiguës : modèle x déquantification (indexées comme items).
+    std::vector<glm::mat4> mvps;       ///< MVP calculées par computeMVPs().
+    std::vector<glm::vec4> worldSpheres; ///< Sphères monde (xyz centre, w rayon), mises à jour avec models.
+    std::vector<glm::vec3> worldMin;   ///< AABB monde (min), indexées comme items.
+    std::vector<glm::vec3> worldMax;   ///< AABB monde (max), indexées comme items.
+    std::vector<DrawPacket> packets;   ///< Draws triés par clé (reconstruits si orderDirty).
+    std::vector<uint8_t> visibleNow;   ///< Visibilité de la frame (0 : rejeté, 1 : visible, 2 : compté).
+    std::vector<uint8_t> lodNow;       ///< LOD choisi pour la frame (indexé comme items).
+    float lodViewportH = 720.0f;       ///< Hauteur du framebuffer pour le choix de LOD.
+    float lodPixelError = 1.0f;        ///< Erreur projetée tolérée (pixels ; <= 0 : LOD 0).
+    GLuint texProgram = 0;             ///< Programme dont les uniformes de texture sont connus.
+    GLint uHasTex = -1;                ///< uHasTex de texProgram (-1 : textures ignorées).
+    bool anyDirty = false;             ///< Au moins une matrice modèle à recalculer.
+    bool orderDirty = false;           ///< L'ordre de tri doit être reconstruit.
+    bool quantizeOBJ = false;          ///< Sommets OBJ quantifiés (voir useQuantizedVertices()).
+    std::shared_ptr<bool> alive = std::make_shared<bool>(true); ///< Jeton des uploads asynchrones : remplacé par destroy(), libéré avec la scène.
+    DrawStats stats;                   ///< Compteurs du dernier drawAll() / drawArena().
+
+    GeometryArena* arena = nullptr;    ///< Arène partagée (optionnelle).
+    std::vector<ArenaDrawData> drawData; ///< Copie CPU des données par draw (indexées comme items).
+    size_t drawDataLo = SIZE_MAX;      ///< Premier draw modifié depuis le dernier upload.
+    size_t drawDataHi = 0;             ///< Dernier draw modifié (exclu).
+    std::vector<DrawElementsIndirectCommand> cmds; ///< Commandes indirectes (réutilisées).
 };
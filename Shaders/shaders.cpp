@@ -32,23 +32,25 @@
  )";
  
  /**
-  * @brief Vertex shader des lignes : projection via `uMVP`.
+  * @brief Vertex shader des lignes : projection via les blocs Camera/Object.
   * @uniforms
-  *  - mat4 uMVP
+  *  - Camera { mat4 uP; mat4 uV; vec4 uViewport; }   (binding 0)
+  *  - Object { mat4 uModel; vec4 uColor; vec4 uParams; } (binding 1)
   * @inputs
   *  - location=0 : vec3 aPos
   */
  const char* LINE_VS = R"(#version 330 core
  layout (location=0) in vec3 aPos;
- uniform mat4 uMVP;
- void main(){ gl_Position = uMVP*vec4(aPos,1.0); }
+ layout(std140) uniform Camera { mat4 uP; mat4 uV; vec4 uViewport; };
+ layout(std140) uniform Object { mat4 uModel; vec4 uColor; vec4 uParams; };
+ void main(){ gl_Position = uP*uV*uModel*vec4(aPos,1.0); }
  )";
  
  /**
   * @brief Geometry shader : transforme un segment en quad épais (en pixels).
   * @uniforms
-  *  - float uThicknessPx : épaisseur voulue en pixels
-  *  - vec2  uViewport    : taille viewport (width,height)
+  *  - Camera.uViewport.xy : taille viewport (width,height)
+  *  - Object.uParams.x    : épaisseur voulue en pixels
   * @notes
   *  - Convertit la direction du segment en NDC, calcule une normale
   *    écran, puis émet 4 sommets `triangle_strip`.
@@ -56,15 +58,15 @@
   */
  const char* LINE_GS = R"(#version 330 core
  layout(lines) in; layout(triangle_strip, max_vertices=4) out;
- uniform float uThicknessPx;
- uniform vec2  uViewport;
+ layout(std140) uniform Camera { mat4 uP; mat4 uV; vec4 uViewport; };
+ layout(std140) uniform Object { mat4 uModel; vec4 uColor; vec4 uParams; };
  void main(){
    vec4 p0=gl_in[0].gl_Position, p1=gl_in[1].gl_Position;
    vec2 ndc0=p0.xy/p0.w, ndc1=p1.xy/p1.w;
    vec2 dir=ndc1-ndc0; float len=length(dir);
    vec2 n=(len>1e-6)? normalize(vec2(-dir.y,dir.x)) : vec2(0.0,1.0);
-   vec2 px2ndc = 2.0/uViewport;
-   vec2 off = n*uThicknessPx*px2ndc;
+   vec2 px2ndc = 2.0/uViewport.xy;
+   vec2 off = n*uParams.x*px2ndc;
    float z0=p0.z/p0.w, z1=p1.z/p1.w;
    vec4 v0=vec4(ndc0-off, z0,1), v1=vec4(ndc0+off, z0,1);
    vec4 v2=vec4(ndc1-off, z1,1), v3=vec4(ndc1+off, z1,1);
@@ -77,13 +79,59 @@
  )";
  
  /**
-  * @brief Fragment shader des lignes : couleur uniforme `uColor`.
+  * @brief Fragment shader des lignes : couleur du bloc Object.
   * @uniforms
-  *  - vec3 uColor
+  *  - Object.uColor
   */
  const char* LINE_FS = R"(#version 330 core
- out vec4 FragColor; uniform vec3 uColor;
- void main(){ FragColor = vec4(uColor,1.0); }
+ out vec4 FragColor;
+ layout(std140) uniform Object { mat4 uModel; vec4 uColor; vec4 uParams; };
+ void main(){ FragColor = vec4(uColor.rgb,1.0); }
+ )";
+ 
+ /**
+  * @brief Vertex shader des lignes épaisses instanciées (remplace LINE_GS).
+  * @uniforms
+  *  - Camera { mat4 uP; mat4 uV; vec4 uViewport; }  (binding 0)
+  *  - Object.uModel : repère des extrémités          (binding 1)
+  * @inputs
+  *  - location=0 : vec2 aCorner (x : 0 = P0, 1 = P1 ; y : côté -1 / +1), par sommet
+  *  - location=1..4 : vec3 aP0, vec3 aP1, vec4 aColor, float aWidth, par instance
+  * @notes
+  *  - Normale calculée en pixels (épaisseur indépendante de l'orientation et du rapport
+  *    largeur / hauteur), puis ramenée en NDC.
+  *  - Préserve la profondeur (z/w) de chaque extrémité.
+  */
+ const char* THICKLINE_VS = R"(#version 330 core
+ layout (location=0) in vec2 aCorner;
+ layout (location=1) in vec3 aP0;
+ layout (location=2) in vec3 aP1;
+ layout (location=3) in vec4 aColor;
+ layout (location=4) in float aWidth;
+ layout(std140) uniform Camera { mat4 uP; mat4 uV; vec4 uViewport; };
+ layout(std140) uniform Object { mat4 uModel; vec4 uColor; vec4 uParams; };
+ out vec4 vColor;
+ void main(){
+   mat4 MVP = uP*uV*uModel;
+   vec4 c0 = MVP*vec4(aP0,1.0), c1 = MVP*vec4(aP1,1.0);
+   vec2 ndc0 = c0.xy/c0.w, ndc1 = c1.xy/c1.w;
+   vec2 dirPx = (ndc1-ndc0)*uViewport.xy;
+   float len = length(dirPx);
+   vec2 n = (len>1e-6) ? vec2(-dirPx.y,dirPx.x)/len : vec2(0.0,1.0);
+   vec2 off = n*(aCorner.y*aWidth)*2.0*uViewport.zw;
+   bool end = aCorner.x > 0.5;
+   vec4 c = end ? c1 : c0;
+   gl_Position = vec4((end ? ndc1 : ndc0) + off, c.z/c.w, 1.0);
+   vColor = aColor;
+ }
+ )";
+ 
+ /**
+  * @brief Fragment shader des lignes instanciées : couleur de l'instance.
+  */
+ const char* THICKLINE_FS = R"(#version 330 core
+ in vec4 vColor; out vec4 FragColor;
+ void main(){ FragColor = vec4(vColor.rgb,1.0); }
  )";
  
  /**
@@ -108,4 +156,92 @@
  out vec4 FragColor; uniform vec4 uFaceColor;
  void main(){ FragColor = uFaceColor; }
  )";
- 
\ No newline at end of file
+ 
+ /**
+  * @brief Vertex shader de l'arène de géométrie (multi-draw indirect).
+  * @uniforms
+  *  - Camera { mat4 uP; mat4 uV; vec4 uViewport; }       (binding 0)
+  *  - Object { mat4 uModel; ... } : modelMaze (repère du labyrinthe) (binding 1)
+  *  - samplerBuffer uDrawData : 5 texels RGBA32F par draw (matrice modèle, couleur)
+  * @inputs
+  *  - location=0 : vec3 aPos
+  *  - location=1 : uint aDrawId (instancié : baseInstance, ou glVertexAttribI1ui en repli)
+  */
+ const char* ARENA_VS = R"(#version 330 core
+ layout (location=0) in vec3 aPos;
+ layout (location=1) in uint aDrawId;
+ layout(std140) uniform Camera { mat4 uP; mat4 uV; vec4 uViewport; };
+ layout(std140) uniform Object { mat4 uModel; vec4 uColor; vec4 uParams; };
+ uniform samplerBuffer uDrawData;
+ flat out vec4 vColor;
+ void main(){
+   int b = int(aDrawId) * 5;
+   mat4 M = mat4(texelFetch(uDrawData, b),     texelFetch(uDrawData, b + 1),
+                 texelFetch(uDrawData, b + 2), texelFetch(uDrawData, b + 3));
+   vColor = texelFetch(uDrawData, b + 4);
+   gl_Position = uP * uV * uModel * M * vec4(aPos, 1.0);
+ }
+ )";
+ 
+ /**
+  * @brief Fragment shader de l'arène : couleur par draw transmise par le vertex shader.
+  */
+ const char* ARENA_FS = R"(#version 330 core
+ flat in vec4 vColor; out vec4 FragColor;
+ void main(){ FragColor = vColor; }
+ )";
+
+ /**
+  * @brief Vertex shader des modèles OBJ (sommets flottants ou quantifiés).
+  * @uniforms
+  *  - mat4 uMVP (déquantification des positions incluse)
+  * @inputs
+  *  - location=0 : vec3 aPos
+  *  - location=1 : vec3 aNormal (sommets flottants)
+  *  - location=2 : vec2 aUV
+  *  - location=3 : vec2 aOct    (sommets quantifiés : normale octaédrique)
+  * @details Un seul des attributs 1 / 3 est activé par VAO ; l'autre vaut la constante
+  *          générique (0, 0, 0, 1). aNormal nul => la normale est décodée depuis aOct.
+  */
+ const char* MESH_VS = R"(#version 330 core
+ layout (location=0) in vec3 aPos;
+ layout (location=1) in vec3 aNormal;
+ layout (location=2) in vec2 aUV;
+ layout (location=3) in vec2 aOct;
+ uniform mat4 uMVP;
+ out vec3 vNormal;
+ out vec2 vUV;
+ vec3 octDecode(vec2 e){
+     vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+     if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+     return n;
+ }
+ void main(){
+     vNormal = dot(aNormal, aNormal) > 0.0 ? aNormal : octDecode(aOct);
+     vUV = aUV;
+     gl_Position = uMVP * vec4(aPos, 1.0);
+ }
+ )";
+ 
+ /**
+  * @brief Fragment shader des modèles OBJ : couleur du matériau x texture diffuse, éclairage simple.
+  * @uniforms
+  *  - vec4 uFaceColor : couleur du matériau (Kd x couleur de l'objet)
+  *  - sampler2D uTex  : texture diffuse (unité 0)
+  *  - int uHasTex     : 1 si une texture est liée
+  */
+ const char* MESH_FS = R"(#version 330 core
+ in vec3 vNormal;
+ in vec2 vUV;
+ out vec4 FragColor;
+ uniform vec4 uFaceColor;
+ uniform sampler2D uTex;
+ uniform int uHasTex;
+ void main(){
+     vec4 c = uFaceColor;
+     if (uHasTex != 0) c *= texture(uTex, vUV);
+     // lumière fixe dans le repère de l'objet (demi-Lambert : jamais complètement noir)
+     float l = 0.5 + 0.5 * max(dot(normalize(vNormal), normalize(vec3(0.3, 0.5, 0.8))), 0.0);
+     FragColor = vec4(c.rgb * l, c.a);
+ }
+ )";
@@ -8,7 +8,13 @@
  * Tous les shaders ciblent OpenGL 3.3 Core (`#version 330 core`).
  * - BG_*   : rendu du fond vidéo (quad plein écran, texture 2D).
  * - LINE_* : rendu de lignes à épaisseur constante en pixels (via Geometry Shader).
+ * - THICKLINE_* : mêmes lignes, quad instancié étendu dans le vertex shader (voir line_batch.hpp).
  * - FACE_* : rendu de faces pleines (couleur uniforme, sans éclairage).
+ * - ARENA_* : faces pleines de l'arène de géométrie (matrice + couleur par draw en texture buffer).
+ * - MESH_* : modèles OBJ texturés (position / normale / uv, couleur de matériau + texture diffuse).
+ *
+ * LINE_*, THICKLINE_* et ARENA_* lisent les blocs std140 `Camera` (binding 0) et `Object` (binding 1),
+ * voir uniform_buffers.hpp ; FACE_* et MESH_* gardent des uniformes classiques (chemin VAO par maillage).
  *
  * @note Les chaînes sont null-terminées et peuvent être passées directement à glShaderSource().
  */
@@ -18,21 +24,42 @@ extern const char* BG_VS;
 /// Fragment shader du fond vidéo : échantillonne uTex aux UV.
 extern const char* BG_FS;
 
-/// Vertex shader de lignes : applique uMVP à aPos.
+/// Vertex shader de lignes : applique uP*uV*uModel à aPos.
 extern const char* LINE_VS;
 /**
  * @brief Geometry shader de lignes épaisses (constantes en pixels).
  * @details
  * Entrée : `layout(lines)` ; sortie : `triangle_strip` (4 sommets).
- * - `uThicknessPx` : épaisseur en pixels
- * - `uViewport`    : (width,height) pour convertir pixels -> NDC
+ * - `uParams.x`    : épaisseur en pixels (bloc Object)
+ * - `uViewport.xy` : (width,height) pour convertir pixels -> NDC (bloc Camera)
  * Construit un quad autour du segment projeté en NDC.
  */
 extern const char* LINE_GS;
-/// Fragment shader de lignes : sortie couleur uniforme `uColor`.
+/// Fragment shader de lignes : sortie couleur `uColor` du bloc Object.
 extern const char* LINE_FS;
 
+/**
+ * @brief Vertex shader de lignes épaisses instanciées (sans geometry shader).
+ * @details
+ * Un quad de 4 sommets (aCorner) par instance = un segment (aP0, aP1, aColor, aWidth),
+ * extrémités dans le repère de Object.uModel. Le segment est projeté, puis le coin est
+ * décalé perpendiculairement en pixels (aWidth, comme uParams.x pour LINE_GS).
+ */
+extern const char* THICKLINE_VS;
+/// Fragment shader de lignes instanciées : couleur par instance.
+extern const char* THICKLINE_FS;
+
 /// Vertex shader des faces : applique uMVP à aPos.
 extern const char* FACE_VS;
 /// Fragment shader des faces : sortie couleur uniforme `uFaceColor`.
 extern const char* FACE_FS;
+
+/// Vertex shader de l'arène : uP*uV*uModel * modèle(draw) * aPos, données par draw lues dans uDrawData.
+extern const char* ARENA_VS;
+/// Fragment shader de l'arène : couleur par draw.
+extern const char* ARENA_FS;
+
+/// Vertex shader des modèles OBJ : applique uMVP à aPos, transmet normale (flottante ou octaédrique) et uv.
+extern const char* MESH_VS;
+/// Fragment shader des modèles OBJ : uFaceColor x texture(uTex) si uHasTex, demi-Lambert.
+extern const char* MESH_FS;
@@ -52,17 +52,21 @@
     return out;
 }
 
-GLuint loadTextureFromFile(const std::string& path, bool flipY)
+bool decodeTextureFile(const std::string& path, bool flipY, cv::Mat& rgb)
 {
     cv::Mat bgr = cv::imread(path, cv::IMREAD_COLOR);
     if (bgr.empty()) {
         std::cerr << "loadTextureFromFile: impossible de lire " << path << "\n";
-        return 0;
+        return false;
     }
-
-    cv::Mat rgb;
     cv::cvtColor(bgr, rgb, cv::COLOR_BGR2RGB);
     rgb = flipIfNeeded(rgb, flipY);
+    return true;
+}
+
+GLuint uploadTextureRGB(const cv::Mat& rgb)
+{
+    if (rgb.empty()) return 0;
 
     GLuint tex = 0;
     glGenTextures(1, &tex);
@@ -86,4 +90,10 @@ GLuint loadTextureFromFile(const std::string& path, bool flipY)
     glBindTexture(GL_TEXTURE_2D, 0);
     return tex;
 }
- 
\ No newline at end of file
+
+GLuint loadTextureFromFile(const std::string& path, bool flipY)
+{
+    cv::Mat rgb;
+    if (!decodeTextureFile(path, flipY, rgb)) return 0;
+    return uploadTextureRGB(rgb);
+}
@@ -33,3 +33,19 @@ GLuint createOrUpdateTexture(GLuint tex, const cv::Mat& imgBGR);
 
 // ✅ nouveau : charge un JPG/PNG depuis disque et crée une texture GL
 GLuint loadTextureFromFile(const std::string& path, bool flipY = true);
+
+/**
+ * @brief Lit et décode un JPG/PNG en RGB 8 bits, sans appel OpenGL (utilisable hors du thread GL).
+ * @param path Chemin de l'image.
+ * @param flipY Retourne l'image verticalement (origine OpenGL en bas).
+ * @param rgb Image RGB résultante.
+ * @return false si l'image n'a pas pu être lue (message sur stderr).
+ */
+bool decodeTextureFile(const std::string& path, bool flipY, cv::Mat& rgb);
+
+/**
+ * @brief Crée une texture GL à partir d'une image RGB décodée par decodeTextureFile().
+ * @return Handle de la texture (0 si l'image est vide).
+ * @warning Nécessite un contexte OpenGL actif.
+ */
+GLuint uploadTextureRGB(const cv::Mat& rgb);
@@ -0,0 +1,322 @@
+/**
+ * @file texture_cache.cpp
+ * @brief Implémentation du cache de textures (mipmaps, BC1) et de son upload.
+ */
+
+#include "texture_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+#include <vector>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include "AssetPack/asset_pack.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t ALIGN = 64;
+
+uint64_t alignUp(uint64_t v) { return (v + ALIGN - 1) & ~(ALIGN - 1); }
+
+uint64_t levelBytes(TexCacheFormat f, uint32_t w, uint32_t h) {
+    if (f == TexCacheFormat::BC1) return (uint64_t)((w + 3) / 4) * ((h + 3) / 4) * 8;
+    return (uint64_t)w * h * 4;
+}
+
+uint16_t to565(const int c[3]) {
+    return (uint16_t)(((c[0] * 31 + 127) / 255) << 11 | ((c[1] * 63 + 127) / 255) << 5 | ((c[2] * 31 + 127) / 255));
+}
+
+void from565(uint16_t v, int c[3]) {
+    const int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * @brief Encode un bloc 4x4 RGBA en BC1 (mode 4 couleurs).
+ * @details Extrémités : boîte englobante rétrécie de 1/16, diagonale choisie d'après le
+ *          signe des covariances (r, g) et (b, g) ; chaque texel prend la couleur la plus
+ *          proche de la palette.
+ */
+void encodeBC1Block(const uint8_t px[16][4], uint8_t out[8]) {
+    int lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 }, mean[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i)
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], (int)px[i][k]);
+            hi[k] = std::max(hi[k], (int)px[i][k]);
+            mean[k] += px[i][k];
+        }
+    for (int k = 0; k < 3; ++k) mean[k] /= 16;
+
+    int covRG = 0, covBG = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int dg = px[i][1] - mean[1];
+        covRG += (px[i][0] - mean[0]) * dg;
+        covBG += (px[i][2] - mean[2]) * dg;
+    }
+    if (covRG < 0) std::swap(lo[0], hi[0]);
+    if (covBG < 0) std::swap(lo[2], hi[2]);
+
+    int c0[3], c1[3];
+    for (int k = 0; k < 3; ++k) {
+        const int inset = (hi[k] - lo[k]) / 16;
+        c0[k] = std::clamp(hi[k] - inset, 0, 255);
+        c1[k] = std::clamp(lo[k] + inset, 0, 255);
+    }
+    uint16_t e0 = to565(c0), e1 = to565(c1);
+    if (e0 < e1) std::swap(e0, e1); // e0 > e1 : mode 4 couleurs
+
+    int pal[4][3];
+    from565(e0, pal[0]);
+    from565(e1, pal[1]);
+    for (int k = 0; k < 3; ++k) {
+        pal[2][k] = (2 * pal[0][k] + pal[1][k]) / 3;
+        pal[3][k] = (pal[0][k] + 2 * pal[1][k]) / 3;
+    }
+
+    uint32_t bits = 0;
+    if (e0 != e1) {
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestD = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                const int dr = px[i][0] - pal[p][0], dg = px[i][1] - pal[p][1], db = px[i][2] - pal[p][2];
+                const int d = dr * dr + dg * dg + db * db;
+                if (d < bestD) { bestD = d; best = p; }
+            }
+            bits |= (uint32_t)best << (2 * i);
+        }
+    }
+    out[0] = (uint8_t)(e0 & 0xFF); out[1] = (uint8_t)(e0 >> 8);
+    out[2] = (uint8_t)(e1 & 0xFF); out[3] = (uint8_t)(e1 >> 8);
+    for (int k = 0; k < 4; ++k) out[4 + k] = (uint8_t)(bits >> (8 * k));
+}
+
+/// @brief Compresse une image RGBA8 (lignes de `step` octets) ; les blocs de bord répètent le dernier texel.
+void compressBC1(const uint8_t* rgba, std::size_t step, uint32_t w, uint32_t h, uint8_t* out) {
+    uint8_t block[16][4];
+    for (uint32_t by = 0; by < h; by += 4)
+        for (uint32_t bx = 0; bx < w; bx += 4) {
+            for (uint32_t y = 0; y < 4; ++y)
+                for (uint32_t x = 0; x < 4; ++x) {
+                    const uint32_t sx = std::min(bx + x, w - 1), sy = std::min(by + y, h - 1);
+                    std::memcpy(block[y * 4 + x], rgba + sy * step + sx * 4, 4);
+                }
+            encodeBC1Block(block, out);
+            out += 8;
+        }
+}
+
+} // namespace
+
+std::size_t TextureCacheView::dataBytes() const {
+    std::size_t n = 0;
+    for (uint32_t l = 0; l < hdr->levelCount; ++l) n += (std::size_t)hdr->levels[l].size;
+    return n;
+}
+
+bool TextureCacheView::open(const std::string& cachePath, const MeshCacheKey& key, TexCacheFormat format, bool flipY) {
+    close();
+    if (!file.open(cachePath, false) || !attach(file.data(), file.size(), &key, format, flipY)) { close(); return false; }
+    return true;
+}
+
+bool TextureCacheView::open(const char* data, std::size_t size, TexCacheFormat format, bool flipY) {
+    close();
+    return attach(data, size, nullptr, format, flipY);
+}
+
+bool TextureCacheView::attach(const char* data, std::size_t size, const MeshCacheKey* key,
+                              TexCacheFormat format, bool flipY) {
+    if (!data || size < sizeof(TexCacheHeader)) return false;
+
+    const TexCacheHeader* h = (const TexCacheHeader*)data;
+    bool ok = h->magic == TEX_CACHE_MAGIC && h->version == TEX_CACHE_VERSION && (!key || h->source == *key)
+           && h->format == (uint32_t)format && h->flipY == (flipY ? 1u : 0u)
+           && h->levelCount >= 1 && h->levelCount <= TEX_CACHE_MAX_LEVELS
+           && h->levels[0].width == h->width && h->levels[0].height == h->height;
+    for (uint32_t l = 0; ok && l < h->levelCount; ++l) {
+        const TexCacheLevel& lv = h->levels[l];
+        ok = lv.size == levelBytes(format, lv.width, lv.height)
+          && lv.offset >= sizeof(TexCacheHeader) && lv.offset + lv.size <= size;
+    }
+    if (!ok) return false;
+    base = data;
+    hdr = h;
+    return true;
+}
+
+std::string textureCachePath(const std::string& imagePath, TexCacheFormat format) {
+    return imagePath + (format == TexCacheFormat::BC1 ? ".bc1.texcache" : ".rgba8.texcache");
+}
+
+TexCacheFormat preferredTexCacheFormat(bool compress) {
+    return compress && GLEW_EXT_texture_compression_s3tc ? TexCacheFormat::BC1 : TexCacheFormat::RGBA8;
+}
+
+bool buildTextureCache(const std::string& imagePath, const std::string& cachePath,
+                       const MeshCacheKey& key, TexCacheFormat format, bool flipY) {
+    cv::Mat level;
+    {
+        const cv::Mat bgr = cv::imread(imagePath, cv::IMREAD_COLOR);
+        if (bgr.empty()) {
+            std::cerr << "[TEX] impossible de lire " << imagePath << "\n";
+            return false;
+        }
+        cv::cvtColor(bgr, level, cv::COLOR_BGR2RGBA);
+    }
+    if (flipY) cv::flip(level, level, 0); // en place : pas de copie supplémentaire
+
+    TexCacheHeader h{};
+    h.magic = TEX_CACHE_MAGIC;
+    h.version = TEX_CACHE_VERSION;
+    h.source = key;
+    h.width = (uint32_t)level.cols;
+    h.height = (uint32_t)level.rows;
+    h.format = (uint32_t)format;
+    h.flipY = flipY ? 1u : 0u;
+
+    // Chaîne complète jusqu'à 1x1, moyenne 2x2 à partir du niveau précédent
+    std::vector<std::vector<uint8_t>> data;
+    uint64_t offset = alignUp(sizeof(TexCacheHeader));
+    for (uint32_t l = 0; l < TEX_CACHE_MAX_LEVELS; ++l) {
+        const uint32_t w = (uint32_t)level.cols, hgt = (uint32_t)level.rows;
+        TexCacheLevel& lv = h.levels[l];
+        lv.width = w;
+        lv.height = hgt;
+        lv.size = levelBytes(format, w, hgt);
+        lv.offset = offset;
+        offset = alignUp(offset + lv.size);
+
+        data.emplace_back((std::size_t)lv.size);
+        if (format == TexCacheFormat::BC1) {
+            compressBC1(level.data, level.step, w, hgt, data.back().data());
+        } else {
+            for (uint32_t y = 0; y < hgt; ++y)
+                std::memcpy(data.back().data() + (std::size_t)y * w * 4, level.data + y * level.step, (std::size_t)w * 4);
+        }
+        h.levelCount = l + 1;
+        if (w == 1 && hgt == 1) break;
+
+        cv::Mat next;
+        cv::resize(level, next, cv::Size((int)std::max(1u, w / 2), (int)std::max(1u, hgt / 2)), 0, 0, cv::INTER_AREA);
+        level = next;
+    }
+
+    const std::string tmp = cachePath + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+
+    static const char zeros[ALIGN] = {};
+    uint64_t written = 0;
+    auto put = [&](const void* p, uint64_t n) {
+        if (n == 0) return true;
+        written += n;
+        return std::fwrite(p, 1, (std::size_t)n, f) == n;
+    };
+    auto padTo = [&](uint64_t off) { return put(zeros, off - written); };
+
+    bool ok = put(&h, sizeof(h));
+    for (uint32_t l = 0; ok && l < h.levelCount; ++l)
+        ok = padTo(h.levels[l].offset) && put(data[l].data(), h.levels[l].size);
+    ok = (std::fclose(f) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) fs::rename(tmp, cachePath, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool openTextureCache(const std::string& imagePath, TexCacheFormat format, bool flipY,
+                      TextureCacheView& view, bool* built) {
+    if (built) *built = false;
+    const std::string cachePath = textureCachePath(imagePath, format);
+    AssetSpan packed;
+    if (assetFS().find(cachePath, packed)) {
+        if (view.open(packed.data, packed.size, format, flipY)) return true;
+        std::cerr << "[TEX] entree de l'archive invalide : " << cachePath << "\n";
+    }
+
+    MeshCacheKey key;
+    if (!MeshCacheKey::fromFile(imagePath, key)) {
+        std::cerr << "[TEX] impossible de lire " << imagePath << "\n";
+        return false;
+    }
+    if (view.open(cachePath, key, format, flipY)) return true;
+
+    if (!buildTextureCache(imagePath, cachePath, key, format, flipY)) return false;
+    if (built) *built = true;
+    return view.open(cachePath, key, format, flipY);
+}
+
+GLuint uploadTextureCache(const TextureCacheView& view) {
+    const bool bc1 = view.format() == TexCacheFormat::BC1;
+    const GLenum internalFormat = bc1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_RGBA8;
+    const GLsizei levels = (GLsizei)view.levelCount();
+
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Stockage immuable alloué en une fois, puis chaque niveau directement depuis la projection
+    const bool storage = GLEW_VERSION_4_2 || GLEW_ARB_texture_storage;
+    if (storage) glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, (GLsizei)view.width(), (GLsizei)view.height());
+    for (GLint l = 0; l < levels; ++l) {
+        const TexCacheLevel& lv = view.level((uint32_t)l);
+        const void* px = view.levelData((uint32_t)l);
+        if (storage) {
+            if (bc1) glCompressedTexSubImage2D(GL_TEXTURE_2D, l, 0, 0, (GLsizei)lv.width, (GLsizei)lv.height,
+                                               internalFormat, (GLsizei)lv.size, px);
+            else glTexSubImage2D(GL_TEXTURE_2D, l, 0, 0, (GLsizei)lv.width, (GLsizei)lv.height,
+                                 GL_RGBA, GL_UNSIGNED_BYTE, px);
+        } else {
+            if (bc1) glCompressedTexImage2D(GL_TEXTURE_2D, l, internalFormat, (GLsizei)lv.width, (GLsizei)lv.height,
+                                            0, (GLsizei)lv.size, px);
+            else glTexImage2D(GL_TEXTURE_2D, l, (GLint)internalFormat, (GLsizei)lv.width, (GLsizei)lv.height,
+                              0, GL_RGBA, GL_UNSIGNED_BYTE, px);
+        }
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return tex;
+}
+
+GLuint loadTextureCached(const std::string& path, bool flipY, bool compress, TextureLoadInfo* info) {
+    const auto t0 = std::chrono::steady_clock::now();
+    TextureCacheView view;
+    bool built = false;
+    if (!openTextureCache(path, preferredTexCacheFormat(compress), flipY, view, &built)) return 0;
+    const GLuint tex = uploadTextureCache(view);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cerr << "[TEX] " << path << " : " << (built ? "cache construit" : "cache") << " (" << ms << " ms), "
+              << view.width() << "x" << view.height() << ", " << view.levelCount() << " niveaux "
+              << (view.format() == TexCacheFormat::BC1 ? "BC1" : "RGBA8") << ", "
+              << view.dataBytes() / 1024 << " Ko GPU\n";
+    if (info) {
+        info->width = view.width();
+        info->height = view.height();
+        info->levels = view.levelCount();
+        info->format = view.format();
+        info->gpuBytes = view.dataBytes();
+        info->built = built;
+        info->ms = ms;
+    }
+    return tex;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "FileIO/mapped_file.hpp"
+#include "MeshCache/mesh_cache.hpp"
+
+/**
+ * @file texture_cache.hpp
+ * @brief Cache des textures prêtes pour le GPU : chaîne de mipmaps précalculée, blocs BC1
+ *        optionnels, fichier "<image>.<format>.texcache" à côté de la source.
+ *
+ * @details
+ * Format (little-endian, version TEX_CACHE_VERSION) :
+ * @code
+ * [0   .. 448)        TexCacheHeader (dont la table des niveaux)
+ * [level[l].offset ..) pixels du niveau l : RGBA8 ligne à ligne, ou blocs BC1 4x4 (aligné sur 64)
+ * @endcode
+ * Au premier chargement, l'image est décodée (cv::imread), convertie en RGBA, retournée si
+ * demandé, réduite niveau par niveau (moyenne 2x2, cv::INTER_AREA) jusqu'à 1x1, puis
+ * compressée en BC1 si le driver le permet. Aux suivants, le fichier est projeté en mémoire
+ * et chaque niveau est passé tel quel à glTexSubImage2D / glCompressedTexSubImage2D après
+ * un glTexStorage2D : ni décodage, ni conversion, ni copie.
+ *
+ * BC1 (DXT1, GL_EXT_texture_compression_s3tc, disponible sous Mesa) : 8 octets par bloc 4x4,
+ * soit 8 fois moins que RGBA8. Le canal alpha est ignoré (les textures diffuses du projet
+ * sont opaques). Sans l'extension, le cache est en RGBA8.
+ *
+ * La clé source est celle du cache de maillages (taille, mtime, empreinte). Si une archive
+ * est montée (assetFS(), asset_pack.hpp) et contient le cache, il y est lu sans toucher à
+ * l'image source.
+ */
+
+constexpr uint32_t TEX_CACHE_MAGIC = 0x58545241u; ///< "ARTX"
+constexpr uint32_t TEX_CACHE_VERSION = 1;
+constexpr uint32_t TEX_CACHE_MAX_LEVELS = 16;     ///< Jusqu'à 32768 x 32768.
+
+/// @brief Format des niveaux stockés.
+enum class TexCacheFormat : uint32_t {
+    RGBA8 = 0, ///< 4 octets par texel.
+    BC1 = 1    ///< 8 octets par bloc 4x4 (RGB).
+};
+
+/**
+ * @struct TexCacheLevel
+ * @brief Un niveau de mipmap dans le fichier.
+ */
+struct TexCacheLevel {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset; ///< Octets depuis le début du fichier.
+    uint64_t size;   ///< Octets du niveau.
+};
+
+/**
+ * @struct TexCacheHeader
+ * @brief En-tête du fichier cache (448 octets).
+ */
+struct TexCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    MeshCacheKey source;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelCount;
+    uint32_t format;     ///< TexCacheFormat.
+    uint32_t flipY;      ///< 1 : lignes retournées (origine OpenGL en bas).
+    uint32_t reserved[3];
+    TexCacheLevel levels[TEX_CACHE_MAX_LEVELS];
+};
+static_assert(sizeof(TexCacheHeader) == 448, "TexCacheHeader doit faire 448 octets");
+
+/**
+ * @class TextureCacheView
+ * @brief Cache de texture ouvert : niveaux dans la projection mémoire.
+ * @details Aucun appel GL : peut être ouvert (et construit) sur un thread de travail.
+ */
+class TextureCacheView {
+public:
+    /**
+     * @brief Projette et valide un fichier cache.
+     * @return false si absent, corrompu, périmé ou d'un autre format / sens.
+     */
+    bool open(const std::string& cachePath, const MeshCacheKey& key, TexCacheFormat format, bool flipY);
+
+    /**
+     * @brief Valide un cache déjà en mémoire (entrée d'une archive, voir asset_pack.hpp).
+     * @details La clé source n'est pas vérifiée ; le tampon doit survivre à la vue.
+     */
+    bool open(const char* data, std::size_t size, TexCacheFormat format, bool flipY);
+    void close() { file.close(); base = nullptr; hdr = nullptr; }
+
+    bool valid() const { return hdr != nullptr; }
+    uint32_t width() const { return hdr->width; }
+    uint32_t height() const { return hdr->height; }
+    uint32_t levelCount() const { return hdr->levelCount; }
+    TexCacheFormat format() const { return (TexCacheFormat)hdr->format; }
+    const TexCacheLevel& level(uint32_t l) const { return hdr->levels[l]; }
+    const char* levelData(uint32_t l) const { return base + hdr->levels[l].offset; }
+
+    /// @brief Octets de tous les niveaux (= mémoire GPU de la texture).
+    std::size_t dataBytes() const;
+
+private:
+    bool attach(const char* data, std::size_t size, const MeshCacheKey* key, TexCacheFormat format, bool flipY);
+
+    MappedFile file;
+    const char* base = nullptr; ///< Projection du fichier, ou tampon de l'appelant.
+    const TexCacheHeader* hdr = nullptr;
+};
+
+/// @brief Chemin du cache d'une image pour un format ("<image>.rgba8.texcache" / ".bc1.texcache").
+std::string textureCachePath(const std::string& imagePath, TexCacheFormat format);
+
+/**
+ * @brief Format à utiliser sur ce driver : BC1 si demandé et supporté, RGBA8 sinon.
+ * @warning Après glewInit() (lit les drapeaux d'extension ; pas d'appel GL).
+ */
+TexCacheFormat preferredTexCacheFormat(bool compress);
+
+/**
+ * @brief Décode une image, calcule ses mipmaps et écrit le cache (temporaire puis renommage).
+ * @return false si l'image est illisible ou si l'écriture échoue.
+ */
+bool buildTextureCache(const std::string& imagePath, const std::string& cachePath,
+                       const MeshCacheKey& key, TexCacheFormat format, bool flipY);
+
+/**
+ * @brief Ouvre le cache d'une image, en le (re)construisant s'il est absent ou périmé.
+ * @param built (opt) true si le cache vient d'être construit.
+ * @return false si l'image est illisible (et aucun cache valide).
+ * @details Sans appel GL : utilisable depuis un thread de travail (voir AssetLoader).
+ */
+bool openTextureCache(const std::string& imagePath, TexCacheFormat format, bool flipY,
+                      TextureCacheView& view, bool* built = nullptr);
+
+/**
+ * @brief Crée la texture GL d'un cache ouvert : glTexStorage2D puis un upload par niveau
+ *        depuis la projection mémoire.
+ * @return Handle de la texture (filtrage trilinéaire, GL_CLAMP_TO_EDGE).
+ * @warning Nécessite un contexte OpenGL actif.
+ */
+GLuint uploadTextureCache(const TextureCacheView& view);
+
+/**
+ * @struct TextureLoadInfo
+ * @brief Mesures d'un loadTextureCached().
+ */
+struct TextureLoadInfo {
+    uint32_t width = 0, height = 0, levels = 0;
+    TexCacheFormat format = TexCacheFormat::RGBA8;
+    std::size_t gpuBytes = 0; ///< Tous niveaux compris.
+    bool built = false;       ///< Cache construit pendant l'appel (démarrage à froid).
+    double ms = 0.0;          ///< Durée totale (ouverture / construction + upload).
+};
+
+/**
+ * @brief Charge une texture via son cache (construit au premier appel).
+ * @param path Image source (JPG / PNG).
+ * @param flipY Retourne l'image verticalement (origine OpenGL en bas).
+ * @param compress BC1 si le driver le supporte.
+ * @param info (opt) Dimensions, format, mémoire GPU et durée.
+ * @return Handle de la texture (0 si l'image est illisible).
+ */
+GLuint loadTextureCached(const std::string& path, bool flipY = true, bool compress = true,
+                         TextureLoadInfo* info = nullptr);
@@ -0,0 +1,78 @@
+// Tools/build_assetpack.cpp
+// Construit l'archive d'assets (asset_pack.hpp) : caches binaires des modèles OBJ, leurs .mtl,
+// caches mipmappés des textures (RGBA8 et / ou BC1) et calibration, dans un seul fichier
+// aligné et indexé, projeté tel quel par l'application (assetFS().mount()).
+//
+// Usage (depuis la racine du projet, comme arcube : les noms stockés sont les chemins
+// relatifs que l'application demande) :
+//   ./build_assetpack [--out assets.pack] [--obj f.obj ...] [--tex image ...] [--file f ...]
+//                     [--format all|bc1|rgba8]
+//   Par défaut : le modèle Meshy, assets/background.jpg et camera.yaml, les deux formats de
+//   texture (le choix se fait à l'exécution selon le driver).
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "AssetPack/asset_pack.hpp"
+#include "SceneObjects.hpp"
+#include "TextureCache/texture_cache.hpp"
+
+int main(int argc, char** argv)
+{
+    std::string out = "assets.pack";
+    std::string format = "all";
+    std::vector<std::string> objs, images, files;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string a = argv[i], v = argv[i + 1];
+        if (a == "--out") out = v;
+        else if (a == "--format") format = v;
+        else if (a == "--obj") objs.push_back(v);
+        else if (a == "--tex") images.push_back(v);
+        else if (a == "--file") files.push_back(v);
+        else { std::fprintf(stderr, "option inconnue : %s\n", a.c_str()); return 1; }
+    }
+    if (objs.empty() && images.empty() && files.empty()) {
+        objs = { "./assets/obj/SM/Meshy_AI_SM_0115202256_texture.obj" };
+        images = { "./assets/background.jpg" };
+        files = { "camera.yaml" };
+    }
+
+    std::vector<TexCacheFormat> formats;
+    if (format == "all" || format == "rgba8") formats.push_back(TexCacheFormat::RGBA8);
+    if (format == "all" || format == "bc1") formats.push_back(TexCacheFormat::BC1);
+    if (formats.empty()) { std::fprintf(stderr, "format inconnu : %s\n", format.c_str()); return 1; }
+
+    int errors = 0;
+    for (const std::string& obj : objs)
+        if (!collectOBJFiles(obj, files, images)) {
+            std::fprintf(stderr, "  ! modele ignore : %s\n", obj.c_str());
+            ++errors;
+        }
+
+    for (const std::string& img : images)
+        for (TexCacheFormat f : formats) {
+            TextureCacheView view;
+            if (!openTextureCache(img, f, true, view)) {
+                std::fprintf(stderr, "  ! texture ignoree : %s\n", img.c_str());
+                ++errors;
+                break;
+            }
+            files.push_back(textureCachePath(img, f));
+        }
+
+    std::vector<AssetPackInput> inputs;
+    for (const std::string& f : files) inputs.push_back(AssetPackInput{ f, f });
+    if (!writeAssetPack(out, inputs)) {
+        std::fprintf(stderr, "ecriture impossible : %s\n", out.c_str());
+        return 1;
+    }
+
+    AssetPack pack;
+    if (!pack.open(out)) { std::fprintf(stderr, "archive illisible : %s\n", out.c_str()); return 1; }
+    std::printf("%s : %zu entree(s), %.1f Ko\n", out.c_str(), pack.entryCount(), pack.fileSize() / 1024.0);
+    for (std::size_t i = 0; i < pack.entryCount(); ++i)
+        std::printf("  %-60s %10.1f Ko\n", pack.entryName(i).c_str(), pack.entryData(i).size / 1024.0);
+    if (errors) std::printf("%d asset(s) ignore(s)\n", errors);
+    return errors ? 2 : 0;
+}
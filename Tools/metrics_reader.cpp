@@ -0,0 +1,44 @@
+// Tools/metrics_reader.cpp
+// Lit les métriques publiées par arcube (metrics.hpp, segment POSIX /arcube_metrics) sans
+// toucher au processus surveillé : une lecture, ou une toutes les N ms avec --watch.
+//
+// Usage : ./arcube_metrics [--shm /arcube_metrics] [--watch 1000]
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "Metrics/metrics.hpp"
+
+int main(int argc, char** argv)
+{
+    std::string shm = "/arcube_metrics";
+    int watchMs = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string a = argv[i], v = argv[i + 1];
+        if (a == "--shm") shm = v;
+        else if (a == "--watch") watchMs = std::stoi(v);
+        else { std::fprintf(stderr, "option inconnue : %s\n", a.c_str()); return 1; }
+    }
+
+    for (;;) {
+        MetricsSnapshot snap;
+        if (!readMetricsShm(shm, snap)) {
+            std::fprintf(stderr, "segment %s absent ou illisible (arcube lance ?)\n", shm.c_str());
+            return 1;
+        }
+        const uint64_t nowNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        std::printf("%s : pid %lld, publication %llu, il y a %.0f ms\n", shm.c_str(), (long long)snap.pid,
+                    (unsigned long long)snap.publishes,
+                    nowNs > snap.updateNs ? (double)(nowNs - snap.updateNs) * 1e-6 : 0.0);
+        for (const MetricsSnapshot::Item& it : snap.items) {
+            if (it.kind == MetricKind::Counter) std::printf("  %-32s %14.0f\n", it.name.c_str(), it.value);
+            else                                std::printf("  %-32s %14.3f\n", it.name.c_str(), it.value);
+        }
+        if (watchMs <= 0) return 0;
+        std::fflush(stdout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(watchMs));
+    }
+}
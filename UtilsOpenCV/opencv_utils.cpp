@@ -1,5 +1,6 @@
 #include "opencv_utils.hpp"
 
+#include <cmath>
 #include <vector>
 
 bool estimateCharucoPose(
@@ -82,3 +83,34 @@ bool estimateCharucoPose(
     tvec = (cv::Mat_<double>(3,1) << tv[0], tv[1], tv[2]);
     return true;
 }
+
+double charucoReprojectionError(
+    const cv::Mat& charucoCorners, const cv::Mat& charucoIds,
+    const cv::Ptr<cv::aruco::CharucoBoard>& board,
+    const cv::Mat& K, const cv::Mat& D,
+    const cv::Mat& rvec, const cv::Mat& tvec)
+{
+    const int n = (int)charucoIds.total();
+    if (n == 0 || (int)charucoCorners.total() != n) return -1.0;
+
+    std::vector<cv::Point3f> objectPts;
+    std::vector<cv::Point2f> imagePts;
+    objectPts.reserve(n);
+    imagePts.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const int id = charucoIds.ptr<int>()[i];
+        if (id < 0 || id >= (int)board->chessboardCorners.size()) continue;
+        objectPts.push_back(board->chessboardCorners[id]);
+        imagePts.push_back(charucoCorners.ptr<cv::Point2f>()[i]);
+    }
+    if (objectPts.empty()) return -1.0;
+
+    std::vector<cv::Point2f> projected;
+    cv::projectPoints(objectPts, rvec, tvec, K, D, projected);
+    double sum = 0.0;
+    for (size_t i = 0; i < projected.size(); ++i) {
+        const cv::Point2f d = projected[i] - imagePts[i];
+        sum += d.x * d.x + d.y * d.y;
+    }
+    return std::sqrt(sum / projected.size());
+}
@@ -24,3 +24,17 @@ bool estimateCharucoPose(
     cv::Mat& rvec, cv::Mat& tvec,
     cv::Mat* outDebug = nullptr
 );
+
+/**
+ * @brief Erreur de reprojection RMS (pixels) des coins Charuco pour une pose donnée.
+ *
+ * @param charucoCorners Coins détectés (Nx1 CV_32FC2, sortie de interpolateCornersCharuco)
+ * @param charucoIds     Identifiants correspondants (Nx1 CV_32S)
+ * @return RMS en pixels, -1 si aucun coin exploitable
+ */
+double charucoReprojectionError(
+    const cv::Mat& charucoCorners, const cv::Mat& charucoIds,
+    const cv::Ptr<cv::aruco::CharucoBoard>& board,
+    const cv::Mat& K, const cv::Mat& D,
+    const cv::Mat& rvec, const cv::Mat& tvec
+);
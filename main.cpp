@@ -12,45 +12,43 @@
 
 #include <iostream>
 #include <algorithm>
-
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <memory>
+
+#include "UtilsOpenCV/opencv_utils.hpp"
+#include "Capture/capture_source.hpp"
+#include "Capture/pose_source.hpp"
 #include "Shaders/shaders.hpp"
-#include "GLUtils/gl_utils.hpp"
+#include "GLUtils/gl_state.hpp"
+#include "GLUtils/uniform_buffers.hpp"
+#include "GLUtils/stream_buffer.hpp"
+#include "GLUtils/gpu_timers.hpp"
+#include "GLUtils/offscreen_target.hpp"
 #include "ARMatrices/ar_matrices.hpp"
 #include "Geometries/geometries.hpp"
 #include "Texture/texture.hpp"
 #include "SceneObjects.hpp"
+#include "GeometryArena/geometry_arena.hpp"
 #include "Smoothing/smoothing.hpp"
+#include "AssetLoader/asset_loader.hpp"
+#include "ResourceCache/resource_cache.hpp"
+#include "TextureCache/texture_cache.hpp"
+#include "AssetPack/asset_pack.hpp"
+#include "ProgramCache/program_cache.hpp"
+#include "LineBatch/line_batch.hpp"
+#include "Profiler/profiler.hpp"
+#include "Profiler/perf_counters.hpp"
+#include "Metrics/metrics.hpp"
 
 #include "Ball.hpp"
 
-struct Axes { Mesh x, y, z; };
-
-static Axes createAxes(float L) {
-    Axes A{};
-    auto makeLine = [](float x1, float y1, float z1,
-                       float x2, float y2, float z2) {
-        Mesh m;
-        m.count = 2;
-        const float V[6] = { x1, y1, z1,  x2, y2, z2 };
-        glGenVertexArrays(1, &m.vao);
-        glGenBuffers(1, &m.vbo);
-        glBindVertexArray(m.vao);
-        glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(V), V, GL_STATIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-        glBindVertexArray(0);
-        return m;
-    };
-
-    A.x = makeLine(0.f, 0.f, 0.f,  L,  0.f, 0.f);
-    A.y = makeLine(0.f, 0.f, 0.f,  0.f,  L,  0.f);
-    A.z = makeLine(0.f, 0.f, 0.f,  0.f, 0.f, -L);
-    return A;
-}
-
 static bool loadCalibration(const std::string& path, cv::Mat& K, cv::Mat& D, cv::Size& calibSz) {
-    cv::FileStorage fs(path, cv::FileStorage::READ);
+    // Depuis l'archive d'assets si elle le contient, sinon le fichier
+    AssetFile file;
+    if (!assetFS().open(path, file)) return false;
+    cv::FileStorage fs(std::string(file.data(), file.size()), cv::FileStorage::READ | cv::FileStorage::MEMORY);
     if (!fs.isOpened()) return false;
 
     fs["camera_matrix"] >> K;
@@ -72,29 +70,89 @@ static bool loadCalibration(const std::string& path, cv::Mat& K, cv::Mat& D, cv:
     return true;
 }
 
-int main() {
-    const std::string droidcamUrl = "http://192.168.1.158:4747/video";
+/// @brief Options de la ligne de commande (source d'images, calibration, exécution sans affichage).
+struct AppOptions {
+    CaptureOptions capture;
+    std::string calib = "camera.yaml";
+    std::string recordDir;   ///< Enregistre la session (images + horodatages) pour la rejouer.
+    bool headless = false;   ///< Fenêtre invisible, sans vsync ; s'arrête en fin d'enregistrement.
+    bool offscreen = false;  ///< headless + rendu dans un FBO, passes labyrinthe / balle / objets mesurées.
+    std::string poses;       ///< "scripted" ou CSV de poses : remplace la détection (rendu seul).
+    std::string savePoses;   ///< Enregistre les poses utilisées pour le rendu (CSV).
+    std::string snapshot;    ///< --offscreen : image de la dernière frame.
+    int maxFrames = -1;
+};
+
+static bool parseArgs(int argc, char** argv, AppOptions& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        std::string err;
+        if (parseCaptureArg(argc, argv, i, o.capture, err)) {
+            if (err.empty()) continue;
+            std::cerr << err << "\n";
+            return false;
+        }
+        if (a == "--headless") { o.headless = true; continue; }
+        if (a == "--offscreen") { o.offscreen = o.headless = true; continue; }
+        if (i + 1 < argc && a == "--poses")      { o.poses = argv[++i]; continue; }
+        if (i + 1 < argc && a == "--save-poses") { o.savePoses = argv[++i]; continue; }
+        if (i + 1 < argc && a == "--snapshot")   { o.snapshot = argv[++i]; continue; }
+        if (i + 1 < argc && a == "--calib")  { o.calib = argv[++i]; continue; }
+        if (i + 1 < argc && a == "--record") { o.recordDir = argv[++i]; continue; }
+        if (i + 1 < argc && a == "--frames") { o.maxFrames = std::atoi(argv[++i]); continue; }
+        std::cerr << (a == "--help" || a == "-h" ? "" : "option inconnue : " + a + "\n")
+                  << "usage : arcube [source] [options]\n" << captureUsage()
+                  << "  --calib FICHIER         calibration (defaut : camera.yaml)\n"
+                     "  --record DOSSIER        enregistre la session (images + timestamps.txt)\n"
+                     "  --frames N              s'arrete apres N frames\n"
+                     "  --headless              fenetre invisible, sans vsync (CI : xvfb-run)\n"
+                     "  --offscreen             headless, rendu dans un FBO, temps par passe a la sortie\n"
+                     "  --poses scripted|CSV    pose scriptee ou enregistree au lieu de la detection\n"
+                     "  --save-poses CSV        enregistre les poses rendues (relues par --poses)\n"
+                     "  --snapshot FICHIER      --offscreen : image de la derniere frame\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    ARCUBE_THREAD_NAME("main");
+    AppOptions opts;
+    if (!parseArgs(argc, argv, opts)) return 2;
 
     SceneObjects scene;
 
+    // ----------- 0) Archive d'assets -----------
+    // assets.pack (build_assetpack) : un seul mmap, chemins indépendants du répertoire courant ;
+    // sans archive, les fichiers séparés sont lus comme avant
+    const std::string packPath = findAssetPack();
+    if (!packPath.empty()) assetFS().mount(packPath);
+
     // ----------- 1) Capture -----------
-    cv::VideoCapture video(droidcamUrl);
-    if (!video.isOpened()) {
-        std::cerr << "Impossible d'ouvrir DroidCam: " << droidcamUrl << "\n";
+    // DroidCam par défaut ; --video / --images rejouent une session enregistrée
+    CaptureSource video;
+    if (!video.open(opts.capture)) {
+        std::cerr << "Impossible d'ouvrir la source : " << video.error() << "\n";
         return -1;
     }
+    std::cerr << "[capture] " << video.describe() << "\n";
 
     cv::Mat frame;
     if (!video.read(frame) || frame.empty()) {
         std::cerr << "Première frame vide.\n";
         return -1;
     }
+    SessionRecorder recorder;
+    if (!opts.recordDir.empty()) {
+        if (recorder.open(opts.recordDir)) recorder.write(frame, video.timestampMs());
+        else std::cerr << "[capture] enregistrement impossible dans " << opts.recordDir << "\n";
+    }
 
     // ----------- 2) Calibration -----------
     cv::Mat K, D;
     cv::Size calibSz;
-    if (!loadCalibration("camera.yaml", K, D, calibSz)) {
-        std::cerr << "camera.yaml introuvable ou invalide.\n";
+    if (!loadCalibration(opts.calib, K, D, calibSz)) {
+        std::cerr << opts.calib << " introuvable ou invalide.\n";
         return -1;
     }
 
@@ -130,43 +188,138 @@ int main() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (opts.headless) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     GLFWwindow* win = glfwCreateWindow(frame.cols, frame.rows, "AR Charuco + Maze + Ball", nullptr, nullptr);
     if (!win) { std::cerr << "glfwCreateWindow failed\n"; return -1; }
     glfwMakeContextCurrent(win);
-    glfwSwapInterval(1);
+    glfwSwapInterval(opts.headless ? 0 : 1); // sans affichage : cadence de la source (ou débit maximal)
 
     glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) { std::cerr << "glewInit failed\n"; return -1; }
     glGetError();
 
-    // ----------- Shaders -----------
-    GLuint progBG   = linkProgram({ compileShader(GL_VERTEX_SHADER, BG_VS),
-                                    compileShader(GL_FRAGMENT_SHADER, BG_FS) });
-
-    GLuint progLine = linkProgram({ compileShader(GL_VERTEX_SHADER,   LINE_VS),
-                                    compileShader(GL_GEOMETRY_SHADER, LINE_GS),
-                                    compileShader(GL_FRAGMENT_SHADER, LINE_FS) });
-
-    GLuint progFace = linkProgram({ compileShader(GL_VERTEX_SHADER, FACE_VS),
-                                    compileShader(GL_FRAGMENT_SHADER, FACE_FS) });
-
-    GLint uBG_tex        = glGetUniformLocation(progBG,   "uTex");
-    GLint uLine_MVP      = glGetUniformLocation(progLine, "uMVP");
-    GLint uLine_Color    = glGetUniformLocation(progLine, "uColor");
-    GLint uLine_ThickPx  = glGetUniformLocation(progLine, "uThicknessPx");
-    GLint uLine_Viewport = glGetUniformLocation(progLine, "uViewport");
+    // --offscreen : rendu dans un FBO à la taille de l'image caméra (la fenêtre ne sert qu'au contexte)
+    OffscreenTarget offscreen;
+    if (opts.offscreen && !offscreen.create(frame.cols, frame.rows)) return -1;
 
-    GLint uFace_MVP   = glGetUniformLocation(progFace, "uMVP");
-    GLint uFace_Color = glGetUniformLocation(progFace, "uFaceColor");
+    // ----------- Shaders -----------
+    // ✅ Binaires des programmes en cache (.programcache/) ; sinon compilations lancées
+    //    ensemble (threads du driver si KHR_parallel_shader_compile) et attendues une fois
+    ProgramCache programs;
+    const size_t iBG = programs.add("bg", { { GL_VERTEX_SHADER, BG_VS }, { GL_FRAGMENT_SHADER, BG_FS } });
+    // Lignes de debug : quad instancié étendu dans le vertex shader (plus de geometry shader)
+    const size_t iLine = programs.add("thickline", { { GL_VERTEX_SHADER, THICKLINE_VS },
+                                                     { GL_FRAGMENT_SHADER, THICKLINE_FS } });
+    const size_t iArena = programs.add("arena", { { GL_VERTEX_SHADER, ARENA_VS }, { GL_FRAGMENT_SHADER, ARENA_FS } });
+    // Modèles OBJ texturés / multi-matériaux (hors arène)
+    const size_t iMesh = programs.add("mesh", { { GL_VERTEX_SHADER, MESH_VS }, { GL_FRAGMENT_SHADER, MESH_FS } });
+    programs.finish();
+    std::cerr << "[startup] programmes : " << programs.size() << " en " << programs.elapsedMs() << " ms ("
+              << programs.cacheHits() << " depuis le cache binaire"
+              << (programs.parallelCompile() ? ", compilation parallele" : "") << ")\n";
+
+    GLuint progBG    = programs.program(iBG);
+    GLuint progLine  = programs.program(iLine);
+    GLuint progArena = programs.program(iArena);
+    GLuint progMesh  = programs.program(iMesh);
+    const GLint uMesh_MVP = glGetUniformLocation(progMesh, "uMVP");
+    const GLint uMesh_Color = glGetUniformLocation(progMesh, "uFaceColor");
+
+    // Uniforms constants : fixés une fois (plus d'appel glUniform* par frame)
+    glUseProgram(progBG);
+    glUniform1i(glGetUniformLocation(progBG, "uTex"), 0);
+    glUseProgram(progArena);
+    glUniform1i(glGetUniformLocation(progArena, "uDrawData"), GeometryArena::DRAW_DATA_UNIT);
+    glUseProgram(0);
+
+    // ✅ Caméra (P, V, viewport) partagée + blocs objet : un upload de chaque par frame
+    UniformBuffers ubo;
+    ubo.create(8);
+    UniformBuffers::bindBlocks(progLine);
+    UniformBuffers::bindBlocks(progArena);
+
+    // ✅ Données dynamiques (blocs uniformes, lignes) écrites dans un anneau triple à fences
+    frameStream().create(1 << 20);
+    std::cerr << "[stream] anneau " << frameStream().regionBytes() * StreamBuffer::FRAMES / 1024 << " Ko, "
+              << (frameStream().persistent() ? "projection persistante" : "repli glMapBufferRange") << "\n";
+
+    // ✅ Temps GPU par passe (horodatages relus RING frames plus tard, sans attente) ; G : overlay
+    GpuTimers gpuTimers;
+    gpuTimers.create();
+    const int passBG     = gpuTimers.addPass("background");
+    const int passArena  = opts.offscreen ? -1 : gpuTimers.addPass("arena");   // murs + balle (un seul draw indirect)
+    const int passModels = opts.offscreen ? -1 : gpuTimers.addPass("drawAll"); // modèles OBJ texturés
+    const int passAxes   = gpuTimers.addPass("axes");
+    // --offscreen : arène découpée pour mesurer labyrinthe, balle et objets séparément
+    const int passMaze    = opts.offscreen ? gpuTimers.addPass("maze") : -1;
+    const int passBall    = opts.offscreen ? gpuTimers.addPass("ball") : -1;
+    const int passObjects = opts.offscreen ? gpuTimers.addPass("objects") : -1;
+    if (!gpuTimers.supported()) std::cerr << "[gpu] requetes d'horodatage indisponibles\n";
+    TimingWindow cpuFrame, cpuSubmit;
+
+    // ✅ Métriques de production : atomiques relâchés dans la boucle, publiées dans /arcube_metrics
+    //    par un thread (lecteur : ./arcube_metrics --watch 1000)
+    MetricsRegistry& m = metrics();
+    const int mFrames     = m.counter("frames");
+    const int mDetected   = m.counter("frames_pose_ok");
+    const int mDropped    = m.counter("camera_frames_dropped");
+    const int mPhysics    = m.counter("physics_steps");
+    const int mFps        = m.gauge("fps");
+    const int mFrameP50   = m.gauge("frame_ms_p50");
+    const int mFrameP95   = m.gauge("frame_ms_p95");
+    const int mFrameP99   = m.gauge("frame_ms_p99");
+    const int mDetectRate = m.gauge("detect_rate");
+    const int mCorners    = m.gauge("charuco_corners_avg");
+    const int mReproj     = m.gauge("reproj_error_px");
+    const int mPoseAge    = m.gauge("pose_age_ms");
+    const int mPhysicsHz  = m.gauge("physics_steps_per_s");
+    MetricsPublisher metricsPub;
+    if (!metricsPub.start()) std::cerr << "[metrics] segment /arcube_metrics indisponible\n";
+    const double camFps = video.fps();
+    // Fenêtre des jauges (~0.5 s) : frames, poses, coins, pas de physique
+    double windowT0 = glfwGetTime(), lastPoseT = -1.0;
+    int winFrames = 0, winDetected = 0, winCorners = 0, winSteps = 0;
+
+    // ✅ Compteurs matériels par étape (ARCUBE_PERF=1) : IPC, défauts de cache, mauvaises prédictions
+    PerfStages perf;
+    const int psRead    = perf.add("video.read");
+    const int psGray    = perf.add("cvtColor");
+    const int psDetect  = perf.add("detectMarkers");
+    const int psCorners = perf.add("interpolateCornersCharuco");
+    const int psPose    = perf.add("estimatePoseCharucoBoard");
+    const int psSmooth  = perf.add("PoseSmoother::smooth");
+    const int psBall    = perf.add("Ball::update");
+    const int psRender  = perf.add("render (soumission GL)");
+    if (std::getenv("ARCUBE_PERF") && !perf.open())
+        std::cerr << "[perf] compteurs materiels indisponibles : " << perf.error() << "\n";
+    // Allocations par étape (build ARCUBE_ALLOC_TRACKER : operator new et cv::Mat comptés)
+    if (allocTrackingActive()) {
+        installCvAllocTracker();
+        perf.trackAllocations(true);
+    }
 
     Mesh bg = createBackgroundQuad();
 
+    // ✅ Assets chargés en arrière-plan : décodage sur threads, upload GL dans la boucle
+    //    (budget par frame) ; la première frame ne dépend plus de leur taille
+    AssetLoader assets;
+    const double assetUploadBudgetMs = 4.0;
+
     // ----------- Texture background -----------
-    GLuint texBG = loadTextureFromFile("./assets/background.jpg", true);
-    if (!texBG) {
-        std::cerr << "Fond JPG introuvable. Vérifie ./assets/background.jpg\n";
-        return -1;
+    // Cache mipmappé (BC1 si supporté) construit au premier lancement, projeté ensuite
+    GLuint texBG = 0; // fond uni tant que la texture n'est pas résidente
+    {
+        const std::string bgPath = "./assets/background.jpg";
+        auto view = std::make_shared<TextureCacheView>();
+        auto ok = std::make_shared<bool>(false);
+        const TexCacheFormat fmt = preferredTexCacheFormat(true);
+        assets.submit([=] { *ok = openTextureCache(bgPath, fmt, true, *view); },
+                      [=, &texBG] {
+                          texBG = resources().acquireTextureWith(ResourceCache::textureKey(bgPath),
+                                                                 [&] { return *ok ? uploadTextureCache(*view) : 0u; });
+                          if (!texBG) std::cerr << "Fond JPG introuvable. Vérifie ./assets/background.jpg\n";
+                      });
     }
 
     // ----------- A4 sheet dims (m) -----------
@@ -185,23 +338,42 @@ int main() {
     Maze maze(cellsX, cellsY, sheetW, sheetH, wallT);
     maze.generate();
 
+    // ✅ Toute la géométrie statique (murs, OBJ, balle) dans une seule arène :
+    //    une soumission multi-draw indirect par frame (repli glDrawElementsBaseVertex en GL 3.3)
+    const auto sceneT0 = std::chrono::steady_clock::now();
+    GeometryArena arena;
+    arena.create(1 << 16, 1 << 17, 64);
+    scene.useArena(&arena);
+    scene.useQuantizedVertices(true); // modèles texturés hors arène : 16 octets / sommet
+
     // ✅ Mesh murs basé SUR LE MEME Maze
-    Mesh mazeSolid = createMazeWallsSolidFromMaze(maze, wallH);
+    const int wallsItem = scene.addMeshData(buildMazeWallsSolidFromMaze(maze, wallH),
+        glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f),
+        glm::vec4(0.85f, 0.85f, 0.85f, 1.0f));
 
     // ✅ TON Ball
-    Ball ball(ballR);
+    Ball ball(ballR, false); // physique seule : la sphère affichée est dans l'arène (ballItem)
     ball.reset(maze);
 
-    scene.addOBJ("./assets/obj/SM/Meshy_AI_SM_0115202256_texture.obj",
+    const int ballItem = scene.addMeshData(buildSphere(ballR, 16, 16),
+        glm::vec3(ball.pos.x, ball.pos.y, ballR), glm::vec3(0.0f), glm::vec3(1.0f),
+        glm::vec4(0.2f, 0.9f, 0.2f, 1.0f));
+
+    scene.addOBJAsync(assets, "./assets/obj/SM/Meshy_AI_SM_0115202256_texture.obj",
         glm::vec3(-0.06f, sheetH*0.5f, 0.0f),
         glm::vec3(-90.f, 0.f, 0.f),      // ✅ redresse : rotation -90° X
         glm::vec3(0.10f, 0.10f, 0.10f), 
         glm::vec4(0.7f,0.7f,0.7f,1.0f));
-    
+
+    // Géométrie générée uniquement : l'OBJ et les textures arrivent pendant les premières frames
+    std::cerr << "[startup] scene prete en "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sceneT0).count()
+              << " ms\n";
 
 
-    // debug axes
-    Axes axes = createAxes(0.10f);
+    // debug axes : toutes les lignes de la frame dans un lot, un seul draw instancié
+    LineBatch debugLines;
+    debugLines.create();
 
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.05f,0.05f,0.06f,1.0f);
@@ -218,77 +390,199 @@ int main() {
     const float marginLeft   = 0.080f;
     const float marginBottom = 0.010f;
 
+    // --poses : pose imposée (trajectoire scriptée ou CSV) à la place de la détection
+    const bool posesDriven = !opts.poses.empty();
+    std::vector<PoseSample> recordedPoses;
+    if (posesDriven && opts.poses != "scripted" && !loadPoseCsv(opts.poses, recordedPoses)) {
+        std::cerr << "Poses illisibles : " << opts.poses << "\n";
+        return -1;
+    }
+    PoseLog poseLog;
+    if (!opts.savePoses.empty() && !poseLog.open(opts.savePoses))
+        std::cerr << "[poses] ecriture impossible : " << opts.savePoses << "\n";
+
     double lastT = glfwGetTime();
+    double lastFrameTs = video.timestampMs(); // horodatage source de l'image précédente
+    const auto sessionT0 = std::chrono::steady_clock::now();
+    int frameIdx = 0;
+    double submitMsAcc = 0.0; // temps CPU de soumission GL cumulé depuis le dernier titre
+    bool cacheKeyDown = false;
+    bool lodOn = true, lodKeyDown = false; // L : niveaux de détail des modèles OBJ
+    SceneObjects::DrawStats arenaStats, modelStats; // compteurs de la frame : arène, modèles (drawAll)
+    bool assetsReported = false;
+    bool traceKeyDown = false;             // T : écrit la trace (build ARCUBE_PROFILER)
+    bool overlayOn = false, overlayKeyDown = false;
+    const char* tracePath = "arcube_trace.json";
 
     while (!glfwWindowShouldClose(win)) {
+        ARCUBE_ZONE("frame");
         // dt
         double nowT = glfwGetTime();
+        if (frameIdx > 0) {
+            cpuFrame.add((nowT - lastT) * 1000.0);
+            // Images caméra manquées : intervalle de frame en périodes caméra, moins une
+            const long missed = std::lround((nowT - lastT) * camFps) - 1;
+            if (missed > 0 && video.isLive()) m.add(mDropped, (uint64_t)missed);
+        }
         float dt = (float)(nowT - lastT);
         lastT = nowT;
         dt = std::min(dt, 1.0f/20.0f);
         dt = std::max(dt, 1.0f/500.0f);
 
         // ----------- Read frame -----------
-        if (!video.read(frame) || frame.empty()) break;
+        {
+            ARCUBE_ZONE("video.read");
+            PerfScope ps(perf, psRead);
+            if ((opts.maxFrames >= 0 && frameIdx >= opts.maxFrames) || !video.read(frame)) break;
+        }
+        if (recorder.isOpen()) recorder.write(frame, video.timestampMs());
+        // Session enregistrée : la physique avance au pas d'origine (rejeu identique quel que soit le débit)
+        if (!video.isLive()) {
+            dt = (float)((video.timestampMs() - lastFrameTs) * 0.001);
+            dt = std::min(dt, 1.0f/20.0f);
+            dt = std::max(dt, 1.0f/500.0f);
+        }
+        lastFrameTs = video.timestampMs();
 
         // ----------- Detect Charuco -----------
         cv::Mat gray;
-        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        if (!posesDriven) {
+            ARCUBE_ZONE("cvtColor");
+            PerfScope ps(perf, psGray);
+            cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        }
 
         std::vector<int> markerIds;
         std::vector<std::vector<cv::Point2f>> markerCorners;
-        cv::aruco::detectMarkers(gray, dict, markerCorners, markerIds, params);
+        if (!posesDriven) {
+            ARCUBE_ZONE("detectMarkers");
+            PerfScope ps(perf, psDetect);
+            cv::aruco::detectMarkers(gray, dict, markerCorners, markerIds, params);
+        }
 
         bool poseOk = false;
 
         if (!markerIds.empty()) {
             cv::Mat charucoCorners, charucoIds;
-            cv::aruco::interpolateCornersCharuco(markerCorners, markerIds, gray, board,
-                                                 charucoCorners, charucoIds, K, D);
+            {
+                ARCUBE_ZONE("interpolateCornersCharuco");
+                PerfScope ps(perf, psCorners);
+                cv::aruco::interpolateCornersCharuco(markerCorners, markerIds, gray, board,
+                                                     charucoCorners, charucoIds, K, D);
+            }
 
             if (charucoIds.total() >= 6) {
+                ARCUBE_ZONE("estimatePoseCharucoBoard");
+                PerfScope ps(perf, psPose);
                 poseOk = cv::aruco::estimatePoseCharucoBoard(charucoCorners, charucoIds,
                                                              board, K, D, rvec, tvec);
             }
+            if (poseOk) {
+                winCorners += (int)charucoIds.total();
+                m.set(mReproj, charucoReprojectionError(charucoCorners, charucoIds, board, K, D, rvec, tvec));
+            }
         }
 
         if (poseOk) {
             if (rvec.type() != CV_64F) rvec.convertTo(rvec, CV_64F);
             if (tvec.type() != CV_64F) tvec.convertTo(tvec, CV_64F);
             
+            ARCUBE_ZONE("PoseSmoother::smooth");
+            PerfScope ps(perf, psSmooth);
             poseSmooth.smooth(rvec, tvec);
             hasPose = true;
+            lastPoseT = nowT;
+            ++winDetected;
+            m.add(mDetected);
+        }
+        if (posesDriven) {
+            // Rendu seul : pose scriptée (temps de la source) ou enregistrée (une par frame)
+            if (recordedPoses.empty()) {
+                scriptedPose(video.timestampMs() * 0.001, rvec, tvec);
+            } else {
+                if (frameIdx >= (int)recordedPoses.size()) break;
+                const PoseSample& p = recordedPoses[frameIdx];
+                rvec = (cv::Mat_<double>(3, 1) << p.r[0], p.r[1], p.r[2]);
+                tvec = (cv::Mat_<double>(3, 1) << p.t[0], p.t[1], p.t[2]);
+            }
+            hasPose = true;
         }
+        if (hasPose && (poseOk || posesDriven)) poseLog.write(video.timestampMs(), rvec, tvec);
+        m.set(mPoseAge, lastPoseT < 0.0 ? -1.0 : (nowT - lastPoseT) * 1000.0);
         if (poseOk && !ball.hasFlatRef) {
             ball.setFlatReference(rvec);
         }
         
 
+        // C : active / désactive le cache d'état (comparaison avant/après dans le titre)
+        const bool cacheKey = glfwGetKey(win, GLFW_KEY_C) == GLFW_PRESS;
+        if (cacheKey && !cacheKeyDown) glState().setEnabled(!glState().isEnabled());
+        cacheKeyDown = cacheKey;
+        const bool lodKey = glfwGetKey(win, GLFW_KEY_L) == GLFW_PRESS;
+        if (lodKey && !lodKeyDown) lodOn = !lodOn;
+        lodKeyDown = lodKey;
+        const bool traceKey = glfwGetKey(win, GLFW_KEY_T) == GLFW_PRESS;
+        if (traceKey && !traceKeyDown && ARCUBE_TRACE_WRITE(tracePath))
+            std::cerr << "[trace] " << tracePath << " ecrit\n";
+        traceKeyDown = traceKey;
+        const bool overlayKey = glfwGetKey(win, GLFW_KEY_G) == GLFW_PRESS;
+        if (overlayKey && !overlayKeyDown) overlayOn = !overlayOn;
+        overlayKeyDown = overlayKey;
+
+        // ----------- Uploads des assets décodés (budget borné) -----------
+        {
+            ARCUBE_ZONE("assets.pump");
+            assets.pump(assetUploadBudgetMs);
+        }
+        if (!assetsReported && assets.idle()) {
+            // Démarrage à froid (parse OBJ + écriture du cache) vs à chaud (cache binaire projeté)
+            std::cerr << "[startup] assets residents en "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sceneT0).count()
+                      << " ms (frame " << frameIdx << ")\n";
+            resources().report(std::cerr); // mémoire GPU par ressource partagée
+            assetsReported = true;
+        }
+
+        const auto submitT0 = std::chrono::steady_clock::now();
+        perf.begin(psRender);
+        GLStateCache& gl = glState();
+        gl.beginFrame();
+        frameStream().beginFrame();
+        gpuTimers.beginFrame();
+
         // ----------- Render background JPG -----------
         int fbw, fbh;
-        glfwGetFramebufferSize(win, &fbw, &fbh);
+        if (offscreen.isCreated()) {
+            offscreen.bind();
+            fbw = offscreen.width();
+            fbh = offscreen.height();
+        } else {
+            glfwGetFramebufferSize(win, &fbw, &fbh);
+        }
         glViewport(0, 0, fbw, fbh);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glDisable(GL_DEPTH_TEST);
         glDepthMask(GL_FALSE);
 
-        glUseProgram(progBG);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texBG);
-        glUniform1i(uBG_tex, 0);
-
-        glBindVertexArray(bg.vao);
-        glDrawArrays(GL_TRIANGLES, 0, bg.count);
-        glBindVertexArray(0);
+        if (texBG) {
+            ARCUBE_ZONE("render.background");
+            gpuTimers.begin(passBG);
+            gl.useProgram(progBG);
+            gl.bindTexture(0, GL_TEXTURE_2D, texBG);
+            gl.bindVertexArray(bg.vao);
+            glDrawArrays(GL_TRIANGLES, 0, bg.count);
+            gl.noteDraw();
+            gpuTimers.end(passBG);
+        }
 
-        glBindTexture(GL_TEXTURE_2D, 0);
         glDepthMask(GL_TRUE);
         glEnable(GL_DEPTH_TEST);
 
         // ----------- Draw 3D (maze + ball + debug axes) -----------
 // --- Draw 3D (maze + ball + debug axes) ---
 if (hasPose) {
+    ARCUBE_ZONE("render.scene");
     glm::mat4 P = projectionFromCV(K, (float)fbw, (float)fbh, 0.01f, 2000.0f);
     glm::mat4 M_board = modelFromRvecTvec_OpenCVtoGL(rvec, tvec);
 
@@ -304,61 +598,180 @@ if (hasPose) {
 
     glm::mat4 MVP_maze = P * M_board * modelMaze;
 
-    scene.drawAll(progFace, uFace_MVP, uFace_Color, MVP_maze);
-    
     if (glfwGetKey(win, GLFW_KEY_R) == GLFW_PRESS) {
         ball.setFlatReference(rvec);
         ball.vel = glm::vec2(0,0);
     }
 
     // ✅ update ball : NE CHANGE PAS
-    ball.update(dt, rvec, maze);
-
-    // --- Murs ---
-    glUseProgram(progFace);
-    glUniformMatrix4fv(uFace_MVP, 1, GL_FALSE, glm::value_ptr(MVP_maze));
-    glUniform4f(uFace_Color, 0.85f, 0.85f, 0.85f, 1.0f);
-    glBindVertexArray(mazeSolid.vao);
-    glDrawElements(GL_TRIANGLES, mazeSolid.count, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-
-    // --- Balle (dessinée avec MVP_maze donc elle tourne visuellement avec le laby) ---
-    glUseProgram(progFace);
-    glUniform4f(uFace_Color, 0.2f, 0.9f, 0.2f, 1.0f);
-    ball.draw(progFace, uFace_MVP, MVP_maze);
-
-    // --- Axes debug : NE TOUCHE PAS ---
-    glUseProgram(progLine);
-    glUniform2f(uLine_Viewport, (float)fbw, (float)fbh);
-    glUniform1f(uLine_ThickPx, lineThicknessPx);
-
-    glm::mat4 MVP_axes = P * M_board; // ✅ inchangé
-    glUniformMatrix4fv(uLine_MVP, 1, GL_FALSE, glm::value_ptr(MVP_axes));
-
-    glBindVertexArray(axes.x.vao); glUniform3f(uLine_Color, 1.f, 0.f, 0.f); glDrawArrays(GL_LINES, 0, axes.x.count);
-    glBindVertexArray(axes.y.vao); glUniform3f(uLine_Color, 0.f, 1.f, 0.f); glDrawArrays(GL_LINES, 0, axes.y.count);
-    glBindVertexArray(axes.z.vao); glUniform3f(uLine_Color, 0.f, 0.f, 1.f); glDrawArrays(GL_LINES, 0, axes.z.count);
-    glBindVertexArray(0);
+    {
+        ARCUBE_ZONE("Ball::update");
+        PerfScope ps(perf, psBall);
+        ball.update(dt, rvec, maze);
+        ++winSteps;
+        m.add(mPhysics);
+    }
+
+    // --- Blocs uniformes de la frame : caméra + labyrinthe + 3 axes (MVP_axes = P * M_board, inchangé) ---
+    ubo.setCamera(P, M_board, (float)fbw, (float)fbh);
+    ubo.beginObjects();
+    const int slotMaze  = ubo.pushObject(modelMaze, glm::vec4(1.0f));
+    const int slotLines = ubo.pushObject(glm::mat4(1.0f), glm::vec4(1.0f));
+    ubo.uploadObjects();
+
+    // --- Murs + objets OBJ + balle (dessinée avec MVP_maze donc elle tourne visuellement avec le laby) ---
+    scene.setTransform(ballItem, glm::vec3(ball.pos.x, ball.pos.y, ball.radius), glm::vec3(0.0f), glm::vec3(1.0f));
+    ubo.bindObject(slotMaze);
+    scene.setLodSelection((float)fbh, lodOn ? 1.0f : 0.0f); // erreur projetée <= 1 px
+    if (opts.offscreen) {
+        // Murs, balle, puis autres objets de l'arène (plages autour des deux) + modèles
+        const int lo = std::min(wallsItem, ballItem), hi = std::max(wallsItem, ballItem);
+        gpuTimers.begin(passMaze);
+        scene.drawArena(progArena, MVP_maze, wallsItem, wallsItem + 1);
+        gpuTimers.end(passMaze);
+        arenaStats = scene.lastStats();
+        gpuTimers.begin(passBall);
+        scene.drawArena(progArena, MVP_maze, ballItem, ballItem + 1);
+        gpuTimers.end(passBall);
+        arenaStats += scene.lastStats();
+        gpuTimers.begin(passObjects);
+        scene.drawArena(progArena, MVP_maze, 0, lo);
+        arenaStats += scene.lastStats();
+        scene.drawArena(progArena, MVP_maze, lo + 1, hi);
+        arenaStats += scene.lastStats();
+        scene.drawArena(progArena, MVP_maze, hi + 1);
+        arenaStats += scene.lastStats();
+        scene.drawAll(progMesh, uMesh_MVP, uMesh_Color, MVP_maze);
+        gpuTimers.end(passObjects);
+    } else {
+        gpuTimers.begin(passArena);
+        scene.drawArena(progArena, MVP_maze);
+        gpuTimers.end(passArena);
+        arenaStats = scene.lastStats();
+        gpuTimers.begin(passModels);
+        scene.drawAll(progMesh, uMesh_MVP, uMesh_Color, MVP_maze);
+        gpuTimers.end(passModels);
+    }
+    modelStats = scene.lastStats();
+
+    // --- Axes debug (repère board) : un upload + un draw pour toutes les lignes ---
+    ubo.bindObject(slotLines);
+    debugLines.begin();
+    debugLines.addAxes(0.10f, lineThicknessPx);
+    gpuTimers.begin(passAxes);
+    debugLines.draw(progLine);
+    gpuTimers.end(passAxes);
 }
+        if (overlayOn) drawGpuTimersOverlay(gpuTimers, fbw, fbh);
+        gpuTimers.endFrame();
+        frameStream().endFrame();
+        perf.end(psRender);
+        perf.endFrame();
+        const double submitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submitT0).count();
+        cpuSubmit.add(submitMs);
+        submitMsAcc += submitMs;
+
+        m.add(mFrames);
+        ++winFrames;
+        if (nowT - windowT0 >= 0.5) {
+            const double span = nowT - windowT0;
+            const TimingSummary fs = cpuFrame.summary();
+            m.set(mFps, winFrames / span);
+            m.set(mFrameP50, fs.p50);
+            m.set(mFrameP95, fs.p95);
+            m.set(mFrameP99, fs.p99);
+            m.set(mDetectRate, (double)winDetected / winFrames);
+            m.set(mCorners, winDetected > 0 ? (double)winCorners / winDetected : 0.0);
+            m.set(mPhysicsHz, winSteps / span);
+            windowT0 = nowT;
+            winFrames = winDetected = winCorners = winSteps = 0;
+        }
+
+        // Compteurs de la frame (affichés dans le titre ~2 fois/s) : objets, appels GL, temps CPU de soumission
+        if (frameIdx % 30 == 0) {
+            const GLFrameCounters& c = gl.frameCounters();
+            char title[400];
+            std::snprintf(title, sizeof(title),
+                          "AR Charuco + Maze + Ball | arene %d dessines, %d rejetes, %d draw(s) %s | modeles %d dessines, %d rejetes, %d draw(s) | %d tri (LOD %s) | GL %d appels, %d evites (cache %s) | submit %.3f ms | GPU %.3f ms",
+                          arenaStats.drawn, arenaStats.culled, arenaStats.drawCalls,
+                          arena.usesMultiDrawIndirect() ? "MDI" : "GL3.3",
+                          modelStats.drawn, modelStats.culled, modelStats.drawCalls,
+                          arenaStats.triangles + modelStats.triangles, lodOn ? "on" : "off",
+                          c.total(), c.skipped, gl.isEnabled() ? "on" : "off",
+                          submitMsAcc / (frameIdx == 0 ? 1 : 30), gpuTimers.frameStats().summary().avg);
+            glfwSetWindowTitle(win, title);
+            submitMsAcc = 0.0;
+        }
 
-        glfwSwapBuffers(win);
-        glfwPollEvents();
+        {
+            ARCUBE_ZONE("glfwSwapBuffers");
+            if (offscreen.isCreated()) glFlush(); // hors écran : rien à présenter
+            else glfwSwapBuffers(win);
+        }
+        {
+            ARCUBE_ZONE("glfwPollEvents");
+            glfwPollEvents();
+        }
+        if (frameIdx == 0)
+            std::cerr << "[startup] premiere frame en "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sceneT0).count()
+                      << " ms\n";
+        ++frameIdx;
+    }
+
+    const double sessionS = std::chrono::duration<double>(std::chrono::steady_clock::now() - sessionT0).count();
+    std::cerr << "[session] " << frameIdx << " frames en " << sessionS << " s ("
+              << (sessionS > 0.0 ? frameIdx / sessionS : 0.0) << " i/s), pose sur "
+              << (uint64_t)m.value(mDetected) << " frames\n";
+    if (recorder.isOpen())
+        std::cerr << "[capture] " << recorder.frames() << " images enregistrees dans " << opts.recordDir << "\n";
+    recorder.close();
+    if (poseLog.isOpen()) std::cerr << "[poses] " << poseLog.count() << " poses ecrites dans " << opts.savePoses << "\n";
+    poseLog.close();
+
+    if (offscreen.isCreated()) {
+        // Fenêtre glissante des dernières frames : régime établi, démarrage exclu si la session est assez longue
+        std::cerr << "[offscreen] " << offscreen.width() << "x" << offscreen.height() << ", temps par passe :\n";
+        reportTimings(std::cerr, gpuTimers, { { "frame", &cpuFrame }, { "submit", &cpuSubmit } });
+        std::vector<unsigned char> rgba;
+        if (!opts.snapshot.empty() && offscreen.readRGBA(rgba)) {
+            cv::Mat img(offscreen.height(), offscreen.width(), CV_8UC4, rgba.data()), bgr;
+            cv::cvtColor(img, bgr, cv::COLOR_RGBA2BGR);
+            cv::flip(bgr, bgr, 0); // lignes GL : bas en premier
+            if (cv::imwrite(opts.snapshot, bgr)) std::cerr << "[offscreen] " << opts.snapshot << " ecrit\n";
+        }
+        offscreen.destroy();
     }
 
     // Cleanup
     glDeleteProgram(progBG);
     glDeleteProgram(progLine);
-    glDeleteProgram(progFace);
+    glDeleteProgram(progArena);
+    glDeleteProgram(progMesh);
+
+    resources().releaseTexture(texBG);
 
-    if (texBG) glDeleteTextures(1, &texBG);
+    scene.destroy();
+    arena.destroy();
+    ubo.destroy();
 
     destroyMesh(bg);
-    destroyMesh(mazeSolid);
-    destroyMesh(ball.mesh);
 
-    if (axes.x.vao) { glDeleteVertexArrays(1, &axes.x.vao); glDeleteBuffers(1, &axes.x.vbo); }
-    if (axes.y.vao) { glDeleteVertexArrays(1, &axes.y.vao); glDeleteBuffers(1, &axes.y.vbo); }
-    if (axes.z.vao) { glDeleteVertexArrays(1, &axes.z.vao); glDeleteBuffers(1, &axes.z.vbo); }
+    debugLines.destroy();
+    const StreamStats& ss = frameStream().stats();
+    std::cerr << "[stream] " << ss.bytes / (1024.0 * 1024.0) << " Mo sur " << ss.frames << " frames, "
+              << ss.stalls << " attente(s) (" << ss.stallMs << " ms), " << ss.grows << " agrandissement(s)\n";
+    frameStream().destroy();
+
+    // Temps GPU par passe et temps CPU de la session (fenêtre glissante des dernières frames)
+    if (writeTimingsCsv("arcube_timings.csv", gpuTimers, { { "frame", &cpuFrame }, { "submit", &cpuSubmit } }))
+        std::cerr << "[gpu] arcube_timings.csv ecrit (" << gpuTimers.skippedFrames() << " frame(s) non mesuree(s))\n";
+    gpuTimers.destroy();
+    if (perf.active()) perf.report(std::cerr);
+
+    if (ARCUBE_TRACE_WRITE(tracePath))
+        std::cerr << "[trace] " << tracePath << " ecrit (" << prof::eventCount() << " evenements, "
+                  << prof::droppedCount() << " perdus)\n";
 
     glfwDestroyWindow(win);
     glfwTerminate();